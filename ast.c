@@ -314,6 +314,18 @@ stmt_t *stmt_from_for(stmt_t *init, stmt_t *test,
   return stmt;
 }
 
+stmt_t *stmt_from_for_range(char *id, expr_t *start, expr_t *end,
+                            int inclusive, Vector *body)
+{
+  stmt_t *stmt = stmt_new(FOR_RANGE_KIND);
+  stmt->for_range_stmt.id = id;
+  stmt->for_range_stmt.inclusive = inclusive;
+  stmt->for_range_stmt.start = start;
+  stmt->for_range_stmt.end = end;
+  stmt->for_range_stmt.body = body;
+  return stmt;
+}
+
 /*
 stmt_t *stmt_from_foreach(struct var *var, expr_t *expr,
                              Vector *body, int bdecl)
@@ -141,7 +141,7 @@ typedef enum stmt_kind {
   ASSIGNS_KIND, RETURN_KIND, EXPR_KIND, BLOCK_KIND,
   CLASS_KIND, TRAIT_KIND,
   IF_KIND, WHILE_KIND, SWITCH_KIND, FOR_TRIPLE_KIND,
-  FOR_EACH_KIND, BREAK_KIND, CONTINUE_KIND, GO_KIND,
+  FOR_EACH_KIND, FOR_RANGE_KIND, BREAK_KIND, CONTINUE_KIND, GO_KIND,
   TYPEALIAS_KIND, LIST_KIND, STMT_KIND_MAX
 } stmt_kind_t;
 
@@ -230,6 +230,13 @@ struct stmt {
       expr_t *expr;
       Vector *body;
     } for_each_stmt;
+    struct {
+      char *id;
+      int inclusive;  /* a...b, otherwise a..<b */
+      expr_t *start;
+      expr_t *end;
+      Vector *body;
+    } for_range_stmt;
     expr_t *go_stmt;
     Vector list;
   };
@@ -252,6 +259,8 @@ stmt_t *stmt_from_if(expr_t *test, Vector *body, stmt_t *orelse);
 stmt_t *stmt_from_while(expr_t *test, Vector *body, int btest);
 stmt_t *stmt_from_switch(expr_t *expr, Vector *case_seq);
 stmt_t *stmt_from_for(stmt_t *init, stmt_t *test, stmt_t *incr, Vector *body);
+stmt_t *stmt_from_for_range(char *id, expr_t *start, expr_t *end,
+                            int inclusive, Vector *body);
 stmt_t *stmt_from_go(expr_t *expr);
 stmt_t *stmt_from_typealias(char *id, TypeDesc *desc);
 void vec_stmt_free(Vector *stmts);
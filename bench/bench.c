@@ -0,0 +1,172 @@
+/*
+  VM benchmark suite.
+
+  Every benchmark is a koala package in bench/<name>/, whose main(args) is
+  run as the workload. The driver compiles each package with koalac, runs
+  main through Koala_Run() RUN_TIMES times, and appends one CSV row per
+  benchmark to the output file:
+    tag,benchmark,runs,min_ms,median_ms,allocs
+  'tag' identifies the build(the git commit with 'make bench'), 'allocs'
+  is the number of objects allocated by one run.
+
+  usage: bench [-koalac <path>] [-o <csv>] [-tag <tag>] [-n <runs>] [names]
+
+  Coroutine ping-pong and map churn are not in the suite yet, the compiler
+  has no 'go' statement nor map literals, and the vm has no OP_NEWMAP.
+ */
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "koala.h"
+#include "moduleobject.h"
+#include "gc.h"
+
+#define RUN_TIMES 5
+
+static char *benchmarks[] = {
+  "fib",      /* recursive calls */
+  "objects",  /* field-heavy object graphs */
+  "traits",   /* method dispatch through traits */
+  "arrays",   /* array allocation and subscripts */
+  "strings",  /* string building */
+  NULL
+};
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+  double d1 = *(double *)a;
+  double d2 = *(double *)b;
+  return d1 < d2 ? -1 : (d1 > d2 ? 1 : 0);
+}
+
+/* bench/<name> is compiled into ./bench/<name>.klc */
+static int compile(char *koalac, char *path)
+{
+  char klc[256];
+  snprintf(klc, sizeof(klc), "./%s.klc", path);
+  unlink(klc);
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    execlp(koalac, koalac,
+           "-pkg", path,
+           "-out", "./",
+           "-klc", "./",
+           NULL);
+    fprintf(stderr, "bench: cannot run '%s'\n", koalac);
+    exit(-1);
+  }
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  if (!WIFEXITED(status) || WEXITSTATUS(status))
+    return -1;
+  return access(klc, R_OK);
+}
+
+static int run(char *name, char *koalac, int runs, FILE *csv, char *tag)
+{
+  char path[128];
+  snprintf(path, sizeof(path), "bench/%s", name);
+
+  if (compile(koalac, path)) {
+    fprintf(stderr, "bench: compile '%s' failed\n", path);
+    return -1;
+  }
+
+  Object *mo = Koala_Load_Module(path);
+  if (!mo || !Module_Get_Function(mo, "main")) {
+    fprintf(stderr, "bench: load '%s' failed\n", path);
+    return -1;
+  }
+
+  Vector args;
+  Vector_Init(&args);
+  double times[runs];
+  int allocs = 0;
+  for (int i = 0; i < runs; i++) {
+    int count = GC_Alloc_Count();
+    double start = now();
+    Koala_Run(path, "main", &args);
+    times[i] = now() - start;
+    allocs = GC_Alloc_Count() - count;
+  }
+  Vector_Fini(&args, NULL, NULL);
+
+  qsort(times, runs, sizeof(double), cmp_double);
+  double min = times[0] * 1000;
+  double median = times[runs / 2] * 1000;
+  if (runs % 2 == 0)
+    median = (times[runs / 2 - 1] + times[runs / 2]) * 500;
+
+  fprintf(csv, "%s,%s,%d,%.3f,%.3f,%d\n", tag, name, runs, min, median,
+          allocs);
+  fflush(csv);
+  fprintf(stderr, "%-10s min %10.3f ms  median %10.3f ms  allocs %d\n",
+          name, min, median, allocs);
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  char *koalac = "koalac";
+  char *output = "bench/results.csv";
+  char *tag = "";
+  int runs = RUN_TIMES;
+  char **names = NULL;
+  int nnames = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-koalac") && i + 1 < argc) {
+      koalac = argv[++i];
+    } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+      output = argv[++i];
+    } else if (!strcmp(argv[i], "-tag") && i + 1 < argc) {
+      tag = argv[++i];
+    } else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+      runs = atoi(argv[++i]);
+    } else if (argv[i][0] == '-') {
+      fprintf(stderr, "usage: %s [-koalac <path>] [-o <csv>] [-tag <tag>] "
+              "[-n <runs>] [names]\n", argv[0]);
+      return -1;
+    } else {
+      names = argv + i;
+      nnames = argc - i;
+      break;
+    }
+  }
+  if (runs <= 0) runs = 1;
+
+  FILE *csv = fopen(output, "a");
+  if (!csv) {
+    fprintf(stderr, "bench: cannot open '%s'\n", output);
+    return -1;
+  }
+  /* the header is written once, rows of later runs are appended */
+  fseek(csv, 0, SEEK_END);
+  if (ftell(csv) == 0)
+    fprintf(csv, "tag,benchmark,runs,min_ms,median_ms,allocs\n");
+
+  Koala_Initialize();
+  Koala_Env_Append("koala.path", "./");
+
+  int failed = 0;
+  if (nnames > 0) {
+    for (int i = 0; i < nnames; i++)
+      failed += run(names[i], koalac, runs, csv, tag) ? 1 : 0;
+  } else {
+    for (char **name = benchmarks; *name; name++)
+      failed += run(*name, koalac, runs, csv, tag) ? 1 : 0;
+  }
+
+  Koala_Finalize();
+  fclose(csv);
+  return failed ? -1 : 0;
+}
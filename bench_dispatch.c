@@ -0,0 +1,135 @@
+/*
+  Micro-benchmark of the interpreter's instruction dispatch.
+
+  It builds a module with one function in memory:
+    func loop() int {
+      var i = 0;
+      var s = 0;
+      while (i < N) { s = s + i; i = i + 1; }
+      return s;
+    }
+  runs it several times and reports the best loop iterations per second.
+  The instructions run per iteration depend on how the interpreter
+  rewrites the loop (quickening, superinstructions, fused compare-jumps),
+  so iterations are what compare across dispatch modes and commits.
+  'make bench-dispatch' builds and runs it for both dispatch modes.
+ */
+#include <time.h>
+#include <unistd.h>
+#include "koala.h"
+#include "klc.h"
+
+#define LOOP_COUNT  10000000
+#define RUN_TIMES   5
+
+static void write_loop_image(char *path, int count)
+{
+  KImage *image = KImage_New("bench_dispatch");
+  AtomTable *atbl = image->table;
+  int k0 = ConstItem_Set_Int(atbl, 0);
+  int k1 = ConstItem_Set_Int(atbl, 1);
+  int kn = ConstItem_Set_Int(atbl, count);
+
+  Buffer buf;
+  Buffer_Init(&buf, 64);
+
+  /* var i = 0; var s = 0; */
+  Buffer_Write_Byte(&buf, OP_LOADK);
+  Buffer_Write_4Bytes(&buf, k0);
+  Buffer_Write_Byte(&buf, OP_STORE);
+  Buffer_Write_2Bytes(&buf, 1);
+  Buffer_Write_Byte(&buf, OP_LOADK);
+  Buffer_Write_4Bytes(&buf, k0);
+  Buffer_Write_Byte(&buf, OP_STORE);
+  Buffer_Write_2Bytes(&buf, 2);
+
+  /* jump to the loop test, the body is 22 bytes */
+  Buffer_Write_Byte(&buf, OP_JUMP);
+  Buffer_Write_4Bytes(&buf, 22);
+  int body = Buffer_Size(&buf);
+
+  /* s = s + i */
+  Buffer_Write_Byte(&buf, OP_LOAD);
+  Buffer_Write_2Bytes(&buf, 1);
+  Buffer_Write_Byte(&buf, OP_LOAD);
+  Buffer_Write_2Bytes(&buf, 2);
+  Buffer_Write_Byte(&buf, OP_ADD);
+  Buffer_Write_Byte(&buf, OP_STORE);
+  Buffer_Write_2Bytes(&buf, 2);
+
+  /* i = i + 1 */
+  Buffer_Write_Byte(&buf, OP_LOADK);
+  Buffer_Write_4Bytes(&buf, k1);
+  Buffer_Write_Byte(&buf, OP_LOAD);
+  Buffer_Write_2Bytes(&buf, 1);
+  Buffer_Write_Byte(&buf, OP_ADD);
+  Buffer_Write_Byte(&buf, OP_STORE);
+  Buffer_Write_2Bytes(&buf, 1);
+  assert(Buffer_Size(&buf) - body == 22);
+
+  /* i < N */
+  Buffer_Write_Byte(&buf, OP_LOADK);
+  Buffer_Write_4Bytes(&buf, kn);
+  Buffer_Write_Byte(&buf, OP_LOAD);
+  Buffer_Write_2Bytes(&buf, 1);
+  Buffer_Write_Byte(&buf, OP_LT);
+  Buffer_Write_Byte(&buf, OP_JUMP_TRUE);
+  Buffer_Write_4Bytes(&buf, body - (Buffer_Size(&buf) + 4));
+
+  /* return s */
+  Buffer_Write_Byte(&buf, OP_LOAD);
+  Buffer_Write_2Bytes(&buf, 2);
+  Buffer_Write_Byte(&buf, OP_RET);
+
+  Vector *ret = CString_To_TypeList("i");
+  TypeDesc *proto = Type_New_Proto(NULL, ret);
+  int index = KImage_Add_Func(image, "loop", proto, 3,
+                              Buffer_RawData(&buf), Buffer_Size(&buf));
+  KImage_Add_LocVar(image, "i", &Int_Type, 1, FUNCLOCVAR, index);
+  KImage_Add_LocVar(image, "s", &Int_Type, 2, FUNCLOCVAR, index);
+  KImage_Finish(image);
+  KImage_Write_File(image, path);
+  KImage_Free(image);
+  Buffer_Fini(&buf);
+}
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+  int count = argc > 1 ? atoi(argv[1]) : LOOP_COUNT;
+  write_loop_image("./bench_dispatch.klc", count);
+
+  Koala_Initialize();
+  Koala_Env_Append("koala.path", "./");
+  Object *mo = Koala_Load_Module("bench_dispatch");
+  assert(mo);
+  Object *code = Module_Get_Function(mo, "loop");
+  assert(code);
+
+  double best = 0;
+  for (int i = 0; i < RUN_TIMES; i++) {
+    double start = now();
+    Object *res = Koala_Run_Code(code, mo, NULL);
+    double elapsed = now() - start;
+    TValue val = Tuple_Get(res, 0);
+    if (VALUE_INT(&val) != (int64)count * (count - 1) / 2) {
+      fprintf(stderr, "bench_dispatch: wrong result %lld\n", VALUE_INT(&val));
+      return -1;
+    }
+    if (best == 0 || elapsed < best) best = elapsed;
+  }
+
+  printf("%-9s dispatch: %d loops in %.3fs, %.1f ns/loop, %.1f M loops/s\n",
+         KOALA_COMPUTED_GOTO ? "threaded" : "switch",
+         count, best, best / count * 1e9, count / best / 1e6);
+
+  Koala_Finalize();
+  unlink("./bench_dispatch.klc");
+  return 0;
+}
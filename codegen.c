@@ -89,6 +89,7 @@ void Inst_Gen(AtomTable *atbl, Buffer *buf, Inst *i)
       break;
     }
     case OP_CALL:
+    case OP_TAILCALL:
     case OP_NEW: {
       index = ConstItem_Set_String(atbl, i->arg.str);
       Buffer_Write_4Bytes(buf, index);
@@ -109,7 +110,16 @@ void Inst_Gen(AtomTable *atbl, Buffer *buf, Inst *i)
     case OP_LE:
     case OP_EQ:
     case OP_NEQ:
-    case OP_NEG: {
+    case OP_NEG:
+    case OP_BAND:
+    case OP_BOR:
+    case OP_BXOR:
+    case OP_BNOT:
+    case OP_LSHIFT:
+    case OP_RSHIFT:
+    case OP_LAND:
+    case OP_LOR:
+    case OP_LNOT: {
       break;
     }
     case OP_JUMP:
@@ -126,6 +136,67 @@ void Inst_Gen(AtomTable *atbl, Buffer *buf, Inst *i)
     case OP_STORE_SUBSCR: {
       break;
     }
+    case OP2_LOADK: {
+      Argument *val = &i->arg;
+      if (val->kind == ARG_INT) {
+        index = ConstItem_Set_Int(atbl, val->ival);
+      } else if (val->kind == ARG_FLOAT) {
+        index = ConstItem_Set_Float(atbl, val->fval);
+      } else if (val->kind == ARG_BOOL) {
+        index = ConstItem_Set_Bool(atbl, val->bval);
+      } else if (val->kind == ARG_STR) {
+        index = ConstItem_Set_String(atbl, val->str);
+      } else {
+        assert(0);
+      }
+      Buffer_Write_4Bytes(buf, index);
+      Buffer_Write_2Bytes(buf, i->argc);
+      break;
+    }
+    case OP2_GETFIELD:
+    case OP2_SETFIELD: {
+      index = ConstItem_Set_String(atbl, i->arg.str);
+      Buffer_Write_4Bytes(buf, index);
+      Buffer_Write_2Bytes(buf, i->argc);
+      break;
+    }
+    case OP2_ADD:
+    case OP2_SUB:
+    case OP2_MUL:
+    case OP2_DIV: {
+      Buffer_Write_2Bytes(buf, i->arg.ival);
+      Buffer_Write_2Bytes(buf, i->argc);
+      break;
+    }
+    case OP3_ADD:
+    case OP3_SUB:
+    case OP3_MUL:
+    case OP3_DIV: {
+      Buffer_Write_2Bytes(buf, i->arg.ival);
+      Buffer_Write_2Bytes(buf, i->argc);
+      Buffer_Write_2Bytes(buf, i->result);
+      break;
+    }
+    case OP_GT_JUMP_TRUE:
+    case OP_GT_JUMP_FALSE:
+    case OP_GE_JUMP_TRUE:
+    case OP_GE_JUMP_FALSE:
+    case OP_LT_JUMP_TRUE:
+    case OP_LT_JUMP_FALSE:
+    case OP_LE_JUMP_TRUE:
+    case OP_LE_JUMP_FALSE:
+    case OP_EQ_JUMP_TRUE:
+    case OP_EQ_JUMP_FALSE:
+    case OP_NEQ_JUMP_TRUE:
+    case OP_NEQ_JUMP_FALSE: {
+      Buffer_Write_4Bytes(buf, i->arg.ival);
+      break;
+    }
+    case OP_FOR_RANGE: {
+      Buffer_Write_4Bytes(buf, i->arg.ival);
+      Buffer_Write_2Bytes(buf, i->argc);
+      break;
+    }
     default: {
       assert(0);
       break;
@@ -133,6 +204,147 @@ void Inst_Gen(AtomTable *atbl, Buffer *buf, Inst *i)
   }
 }
 
+/*
+  Peephole optimizer
+  It runs on the instructions of a function before they are serialized,
+  and fuses the hottest sequences into superinstructions:
+    load0; getfield(setfield) a  -> getfield2(setfield2) a, 0
+    op2 a, b; store c            -> op3 a, b, c
+    gt(lt, etc); jump_true(false) -> gt_jump_true(false)
+  Jumps are resolved to their target instructions before fusing, and their
+  offsets are recomputed after. The instructions which are jump targets
+  are never fused into their previous ones.
+ */
+struct jump {
+  Inst *src;
+  Inst *dst;  /* NULL: the end of function */
+};
+
+static inline int isjump(uint8 op)
+{
+  return op == OP_JUMP || op == OP_JUMP_TRUE || op == OP_JUMP_FALSE ||
+    (op >= OP_GT_JUMP_TRUE && op <= OP_NEQ_JUMP_FALSE) ||
+    op == OP_FOR_RANGE;
+}
+
+static uint8 compare_jump(uint8 cmp, uint8 jmp)
+{
+  static struct {
+    uint8 cmp;
+    uint8 jmptrue;
+    uint8 jmpfalse;
+  } ops[] = {
+    {OP_GT,  OP_GT_JUMP_TRUE,  OP_GT_JUMP_FALSE},
+    {OP_GE,  OP_GE_JUMP_TRUE,  OP_GE_JUMP_FALSE},
+    {OP_LT,  OP_LT_JUMP_TRUE,  OP_LT_JUMP_FALSE},
+    {OP_LE,  OP_LE_JUMP_TRUE,  OP_LE_JUMP_FALSE},
+    {OP_EQ,  OP_EQ_JUMP_TRUE,  OP_EQ_JUMP_FALSE},
+    {OP_NEQ, OP_NEQ_JUMP_TRUE, OP_NEQ_JUMP_FALSE},
+  };
+
+  if (jmp != OP_JUMP_TRUE && jmp != OP_JUMP_FALSE)
+    return 0;
+
+  for (int k = 0; k < nr_elts(ops); k++) {
+    if (ops[k].cmp == cmp)
+      return (jmp == OP_JUMP_TRUE) ? ops[k].jmptrue : ops[k].jmpfalse;
+  }
+  return 0;
+}
+
+static int fuse_insts(Inst *i, Inst *next, struct jump *jmps, int njmps)
+{
+  uint8 op;
+  if (i->op == OP_LOAD0 &&
+    (next->op == OP_GETFIELD || next->op == OP_SETFIELD)) {
+    i->op = (next->op == OP_GETFIELD) ? OP2_GETFIELD : OP2_SETFIELD;
+    i->arg = next->arg;
+    i->argc = 0;
+  } else if (i->op >= OP2_ADD && i->op <= OP2_DIV && next->op == OP_STORE) {
+    i->op = OP3_ADD + (i->op - OP2_ADD);
+    i->result = next->arg.ival;
+  } else if ((op = compare_jump(i->op, next->op))) {
+    i->op = op;
+    i->arg = next->arg;
+    for (int k = 0; k < njmps; k++) {
+      if (jmps[k].src == next)
+        jmps[k].src = i;
+    }
+  } else {
+    return 0;
+  }
+  i->bytes = 1 + opcode_argsize(i->op);
+  return 1;
+}
+
+static int peephole(CodeBlock *b)
+{
+  Inst *i;
+  int size = 0;
+  int njmps = 0;
+  list_for_each_entry(i, &b->insts, link) {
+    i->offset = size;
+    size += i->bytes;
+    if (isjump(i->op)) njmps++;
+  }
+
+  Inst **insts = calloc(size + 1, sizeof(Inst *));
+  uint8 *marks = calloc(size + 1, sizeof(uint8));
+  struct jump *jmps = calloc(njmps + 1, sizeof(struct jump));
+  list_for_each_entry(i, &b->insts, link) {
+    insts[i->offset] = i;
+  }
+
+  int target;
+  int k = 0;
+  list_for_each_entry(i, &b->insts, link) {
+    if (!isjump(i->op)) continue;
+    target = i->offset + i->bytes + i->arg.ival;
+    kassert(target >= 0 && target <= size && (target == size || insts[target]),
+      "invalid jump target %d at %d", target, i->offset);
+    marks[target] = 1;
+    jmps[k].src = i;
+    jmps[k].dst = insts[target];
+    k++;
+  }
+
+  int count = 0;
+  Inst *next;
+  i = list_first_entry(&b->insts, Inst, link);
+  while (&i->link != &b->insts) {
+    next = list_next_entry(i, link);
+    if (&next->link == &b->insts)
+      break;
+    if (!marks[next->offset] && fuse_insts(i, next, jmps, njmps)) {
+      debug("fuse into '%s'", opcode_string(i->op));
+      list_del(&next->link);
+      Inst_Free(next);
+      count++;
+    } else {
+      i = next;
+    }
+  }
+
+  size = 0;
+  list_for_each_entry(i, &b->insts, link) {
+    i->offset = size;
+    size += i->bytes;
+  }
+  b->bytes = size;
+
+  for (k = 0; k < njmps; k++) {
+    i = jmps[k].src;
+    target = jmps[k].dst ? jmps[k].dst->offset : size;
+    i->arg.kind = ARG_INT;
+    i->arg.ival = target - (i->offset + i->bytes);
+  }
+
+  free(jmps);
+  free(marks);
+  free(insts);
+  return count;
+}
+
 static void add_locvar(KImage *image, int index, Symbol *sym, int flags,
   int incls)
 {
@@ -198,6 +410,10 @@ static void __gen_code_fn(Symbol *sym, void *arg)
       int locvars = sym->locvars;
       AtomTable *atbl = tmp->image->table;
 
+      int count = peephole(b);
+      debug("peephole '%s': %d fusions", sym->name, count);
+      UNUSED_PARAMETER(count);
+
       Buffer buf;
       Buffer_Init(&buf, 32);
       Inst *i;
@@ -291,54 +507,156 @@ void codegen_klc(PackageInfo *pkg)
   printf("----------codegen end--------\n");
 }
 
-void codegen_binary(ParserState *ps, int op)
+/*
+  Register-style instructions(OP2_XXX)
+  The operands, which are just loaded into stack from locvars or from
+  constant pool by the tail instructions of the block, are folded into
+  one OP2_XXX instruction. The stack effect is the same.
+ */
+static Inst *tail_inst(CodeBlock *b, int n)
+{
+  struct list_head *pos = &b->insts;
+  while (n-- > 0) {
+    pos = pos->prev;
+    if (pos == &b->insts) return NULL;
+  }
+  return list_entry(pos, Inst, link);
+}
+
+static void remove_tail_inst(CodeBlock *b)
 {
+  Inst *i = tail_inst(b, 1);
+  assert(i);
+  list_del(&i->link);
+  b->bytes -= i->bytes;
+  Inst_Free(i);
+}
+
+/* load a; load b; op -> op2 b, a */
+static int codegen_binary2(CodeBlock *b, int op)
+{
+  int opcode;
   switch (op) {
-    case BINARY_ADD: {
-      debug("add 'OP_ADD'");
-      Inst_Append(ps->u->block, OP_ADD, NULL);
+    case BINARY_ADD:
+      opcode = OP2_ADD;
       break;
-    }
-    case BINARY_SUB: {
-      debug("add 'OP_SUB'");
-      Inst_Append(ps->u->block, OP_SUB, NULL);
+    case BINARY_SUB:
+      opcode = OP2_SUB;
       break;
-    }
-  case BINARY_MULT: {
-    debug("add 'OP_MUL'");
-    Inst_Append(ps->u->block, OP_MUL, NULL);
-    break;
+    case BINARY_MULT:
+      opcode = OP2_MUL;
+      break;
+    case BINARY_DIV:
+      opcode = OP2_DIV;
+      break;
+    default:
+      return 0;
   }
-  case BINARY_DIV: {
-    debug("add 'OP_DIV'");
-    Inst_Append(ps->u->block, OP_DIV, NULL);
-    break;
+
+  Inst *left = tail_inst(b, 1);
+  Inst *right = tail_inst(b, 2);
+  if (!left || !right || left->op != OP_LOAD || right->op != OP_LOAD)
+    return 0;
+
+  Argument val = {.kind = ARG_INT, .ival = left->arg.ival};
+  int index = right->arg.ival;
+  remove_tail_inst(b);
+  remove_tail_inst(b);
+  debug("add '%s'", opcode_string(opcode));
+  Inst *i = Inst_Append(b, opcode, &val);
+  i->argc = index;
+  return 1;
+}
+
+/* loadk a; store b -> loadk2 a, b */
+void codegen_store(ParserState *ps, int index)
+{
+  CodeBlock *b = ps->u->block;
+  Inst *i = tail_inst(b, 1);
+  if (i && i->op == OP_LOADK) {
+    Argument val = i->arg;
+    remove_tail_inst(b);
+    i = Inst_Append(b, OP2_LOADK, &val);
+    i->argc = index;
+  } else {
+    Argument val = {.kind = ARG_INT, .ival = index};
+    Inst_Append(b, OP_STORE, &val);
   }
-  case BINARY_MOD: {
-    debug("add 'OP_MOD'");
-    Inst_Append(ps->u->block, OP_MOD, NULL);
-    break;
+}
+
+/* the last instruction of the current block, NULL if it is empty */
+Inst *codegen_tail(ParserState *ps)
+{
+  return tail_inst(ps->u->block, 1);
+}
+
+/*
+  'return f(...)' is a tail call, there is nothing to do after the call.
+  'call' is the OP_CALL made by the return's only expression, or NULL.
+ */
+void codegen_return(ParserState *ps, Inst *call)
+{
+  if (call) {
+    assert(call->op == OP_CALL && call == tail_inst(ps->u->block, 1));
+    debug("tail call '%s'", call->arg.str);
+    call->op = OP_TAILCALL;
+    return;
   }
-    case BINARY_GT: {
-      debug("add 'OP_GT'");
-      Inst_Append(ps->u->block, OP_GT, NULL);
-      break;
-    }
-    case BINARY_LT: {
-      debug("add 'OP_LT'");
-      Inst_Append(ps->u->block, OP_LT, NULL);
-      break;
-    }
-    case BINARY_EQ: {
-      debug("add 'OP_EQ'");
-      Inst_Append(ps->u->block, OP_EQ, NULL);
-      break;
-    }
+  Inst_Append(ps->u->block, OP_RET, NULL);
+}
+
+/* load a; getfield(setfield) b -> getfield2(setfield2) b, a */
+
+void codegen_field(ParserState *ps, int ctx, Argument *val)
+{
+  CodeBlock *b = ps->u->block;
+  Inst *i = tail_inst(b, 1);
+  int opcode;
+  if (i && i->op == OP_LOAD) {
+    int index = i->arg.ival;
+    remove_tail_inst(b);
+    opcode = (ctx == EXPR_LOAD) ? OP2_GETFIELD : OP2_SETFIELD;
+    i = Inst_Append(b, opcode, val);
+    i->argc = index;
+  } else {
+    opcode = (ctx == EXPR_LOAD) ? OP_GETFIELD : OP_SETFIELD;
+    Inst_Append(b, opcode, val);
+  }
+}
+
+void codegen_binary(ParserState *ps, int op)
+{
+  if (codegen_binary2(ps->u->block, op))
+    return;
+
+  int opcode;
+  switch (op) {
+    case BINARY_ADD:     opcode = OP_ADD;    break;
+    case BINARY_SUB:     opcode = OP_SUB;    break;
+    case BINARY_MULT:    opcode = OP_MUL;    break;
+    case BINARY_DIV:     opcode = OP_DIV;    break;
+    case BINARY_MOD:     opcode = OP_MOD;    break;
+    case BINARY_GT:      opcode = OP_GT;     break;
+    case BINARY_GE:      opcode = OP_GE;     break;
+    case BINARY_LT:      opcode = OP_LT;     break;
+    case BINARY_LE:      opcode = OP_LE;     break;
+    case BINARY_EQ:      opcode = OP_EQ;     break;
+    case BINARY_NEQ:     opcode = OP_NEQ;    break;
+    case BINARY_BIT_AND: opcode = OP_BAND;   break;
+    case BINARY_BIT_OR:  opcode = OP_BOR;    break;
+    case BINARY_BIT_XOR: opcode = OP_BXOR;   break;
+    case BINARY_LSHIFT:  opcode = OP_LSHIFT; break;
+    case BINARY_RSHIFT:  opcode = OP_RSHIFT; break;
+    case BINARY_LAND:    opcode = OP_LAND;   break;
+    case BINARY_LOR:     opcode = OP_LOR;    break;
     default: {
       assert(0);
-      break;
+      return;
     }
   }
+
+  debug("add '%s'", opcode_string(opcode));
+  Inst_Append(ps->u->block, opcode, NULL);
 }
 
 void codegen_unary(ParserState *ps, int op)
@@ -17,6 +17,10 @@ void Inst_Gen(AtomTable *atbl, Buffer *buf, Inst *i);
 
 void codegen_binary(ParserState *ps, int op);
 void codegen_unary(ParserState *ps, int op);
+void codegen_store(ParserState *ps, int index);
+void codegen_field(ParserState *ps, int ctx, Argument *val);
+Inst *codegen_tail(ParserState *ps);
+void codegen_return(ParserState *ps, Inst *call);
 void codegen_klc(PackageInfo *pkg);
 
 #ifdef __cplusplus
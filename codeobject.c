@@ -2,6 +2,9 @@
 #include "codeobject.h"
 #include "tupleobject.h"
 #include "moduleobject.h"
+#include "opcode.h"
+#include "jit.h"
+#include "stackmap.h"
 #include "log.h"
 
 static CodeObject *code_new(int flags, TypeDesc *proto)
@@ -20,22 +23,308 @@ Object *CFunc_New(cfunc cf, TypeDesc *proto)
 	return (Object *)code;
 }
 
+Object *NFunc_New(nfunc nf, TypeDesc *proto)
+{
+	CodeObject *code = code_new(CODE_NLANG, proto);
+	code->nf = nf;
+	return (Object *)code;
+}
+
+/* "module.func" or "module.Class.method", for profiles and stats */
+int Code_Name(Object *ob, char *buf, int size)
+{
+	CodeObject *code = OBJ_TO_CODE(ob);
+	char *name = code->name ? code->name : "?";
+	Object *owner = code->owner;
+
+	if (!owner)
+		return snprintf(buf, size, "%s", name);
+
+	if (OB_CHECK_KLASS(owner, Module_Klass))
+		return snprintf(buf, size, "%s.%s", ((ModuleObject *)owner)->name, name);
+
+	Klass *klazz = (Klass *)owner;
+	if (klazz->module)
+		return snprintf(buf, size, "%s.%s.%s",
+										((ModuleObject *)klazz->module)->name, klazz->name, name);
+	return snprintf(buf, size, "%s.%s", klazz->name, name);
+}
+
 void CodeObject_Free(Object *ob)
 {
 	CodeObject *code = OB_TYPE_OF(ob, CodeObject, Code_Klass);
 	if (CODE_ISKFUNC(code)) {
 		//FIXME
 		//Proto_Free(code->kf.proto);
+		for (int i = 0; i < code->kf.ninsts; i++)
+			free(code->kf.insts[i].cache);
+		free(code->kf.insts);
+		free(code->kf.tmpl);
+		Jit_Free(code);
+		StackMap_Free(ob);
 	}
 	free(ob);
 }
 
+static inline int32 decode_4bytes(uint8 *codes)
+{
+	return (int32)((uint32)codes[0] | ((uint32)codes[1] << 8) |
+		((uint32)codes[2] << 16) | ((uint32)codes[3] << 24));
+}
+
+static inline uint16 decode_2bytes(uint8 *codes)
+{
+	return (uint16)(codes[0] | (codes[1] << 8));
+}
+
+static inline int isjump(uint8 op)
+{
+	return op == OP_JUMP || op == OP_JUMP_TRUE || op == OP_JUMP_FALSE ||
+		(op >= OP_GT_JUMP_TRUE && op <= OP_NEQ_JUMP_FALSE) ||
+		op == OP_FOR_RANGE;
+}
+
+int Instr_IsJump(Instr *i)
+{
+	return isjump(i->op);
+}
+
+/* OP2_ADD etc. have two 2-bytes operands, both are indexes of locvars */
+static inline int istwolocvars(uint8 op)
+{
+	return op >= OP2_ADD && op <= OP2_DIV;
+}
+
+/*
+  OP3_ADD etc. have three 2-bytes operands, indexes of locvars.
+  The two operands are packed into 'arg' and the result is in 'argc'.
+ */
+static inline int isthreelocvars(uint8 op)
+{
+	return op >= OP3_ADD && op <= OP3_DIV;
+}
+
+/*
+  Translate the raw codes into fixed-width instructions.
+  The first pass maps each instruction's byte offset to its index, so the
+  second pass can turn relative byte offsets of jumps into absolute indexes.
+ */
+static Instr *decode_codes(uint8 *codes, int size, int *count)
+{
+	int *index = malloc((size + 1) * sizeof(int));
+	int num = 0;
+	int pc = 0;
+	int argsize;
+
+	for (int i = 0; i <= size; i++)
+		index[i] = -1;
+
+	while (pc < size) {
+		argsize = opcode_argsize(codes[pc]);
+		if (argsize < 0 || pc + 1 + argsize > size) {
+			error("invalid instruction %d at %d", codes[pc], pc);
+			free(index);
+			return NULL;
+		}
+		index[pc] = num++;
+		pc += 1 + argsize;
+	}
+
+	Instr *insts = calloc(num, sizeof(Instr));
+	Instr *i = insts;
+	pc = 0;
+	while (pc < size) {
+		i->op = codes[pc++];
+		argsize = opcode_argsize(i->op);
+		if (argsize == 2) {
+			i->arg = decode_2bytes(codes + pc);
+		} else if (istwolocvars(i->op)) {
+			i->arg = decode_2bytes(codes + pc);
+			i->argc = decode_2bytes(codes + pc + 2);
+		} else if (isthreelocvars(i->op)) {
+			i->arg = (int32)((uint32)decode_2bytes(codes + pc) |
+				((uint32)decode_2bytes(codes + pc + 2) << 16));
+			i->argc = decode_2bytes(codes + pc + 4);
+		} else if (argsize == 4) {
+			i->arg = decode_4bytes(codes + pc);
+		} else if (argsize == 6) {
+			i->arg = decode_4bytes(codes + pc);
+			i->argc = decode_2bytes(codes + pc + 4);
+		}
+		pc += argsize;
+
+		if (isjump(i->op)) {
+			int target = pc + i->arg;
+			if (target < 0 || target >= size || index[target] < 0) {
+				error("invalid jump target %d at %d", target, pc - 5);
+				free(insts);
+				free(index);
+				return NULL;
+			}
+			i->arg = index[target];
+		}
+		i++;
+	}
+
+	free(index);
+	*count = num;
+	return insts;
+}
+
+/*
+  Stack effect of an instruction, number of values it pops and pushes.
+  Returns -1 for calls. The frame is left on a call and the stack is
+  checked again when the frame is resumed, so the depth counts from zero.
+ */
+int Instr_Stack_Effect(Instr *i, int *pops, int *pushes)
+{
+	*pops = 0;
+	*pushes = 0;
+	switch (i->op) {
+	case OP_CALL:
+	case OP_CALL0:
+	case OP_TAILCALL:
+		return -1;
+	case OP_LOADK:
+	case OP_LOADM:
+	case OP_LOAD:
+	case OP_LOAD0:
+	case OP2_GETFIELD:
+	case OP2_ADD:
+	case OP2_SUB:
+	case OP2_MUL:
+	case OP2_DIV:
+		*pushes = 1;
+		break;
+	case OP_STORE:
+	case OP_JUMP_TRUE:
+	case OP_JUMP_FALSE:
+	case OP2_SETFIELD:
+		*pops = 1;
+		break;
+	case OP_GETM:
+	case OP_GETFIELD:
+	case OP_NEW:
+	case OP_NEG:
+	case OP_BNOT:
+	case OP_LNOT:
+		*pops = 1;
+		*pushes = 1;
+		break;
+	case OP_SETFIELD:
+		*pops = 2;
+		break;
+	case OP_STORE_SUBSCR:
+		*pops = 3;
+		break;
+	case OP_NEWARRAY:
+		*pops = i->arg;
+		*pushes = 1;
+		break;
+	case OP_LOAD_SUBSCR:
+		*pops = 2;
+		*pushes = 1;
+		break;
+	default:
+		if ((i->op >= OP_NUM_START && i->op <= OP_NUM_END) ||
+			(i->op >= OP_ADD_II && i->op <= OP_NEQ_FF)) {
+			*pops = 2;
+			*pushes = 1;
+		} else if (i->op >= OP_GT_JUMP_TRUE && i->op <= OP_NEQ_JUMP_FALSE) {
+			*pops = 2;
+		}
+		break;
+	}
+	return 0;
+}
+
+#define MAX_STACK_DEPTH 65535
+
+/*
+  Compute the max depth of operand stack, which a frame needs between its
+  entry(or resume) and the next call.
+  The depth of an instruction is the max of the depths of the paths
+  reaching it, which is propagated along straight-line codes and jumps.
+ */
+static int compute_maxstack(Instr *insts, int count)
+{
+	if (count <= 0) return 0;
+
+	int *depth = malloc(count * sizeof(int));
+	int *work = malloc(count * sizeof(int));
+	uint8 *queued = calloc(count, sizeof(uint8));
+	int nwork = 0;
+	int maxstack = 0;
+	int k, d, pops, pushes;
+	Instr *i;
+
+	for (k = 0; k < count; k++)
+		depth[k] = -1;
+	depth[0] = 0;
+	work[nwork++] = 0;
+	queued[0] = 1;
+
+	while (nwork > 0 && maxstack >= 0) {
+		k = work[--nwork];
+		queued[k] = 0;
+		d = depth[k];
+		while (k < count) {
+			i = insts + k;
+			if (Instr_Stack_Effect(i, &pops, &pushes) < 0) {
+				d = 0;
+			} else {
+				d = max(d - pops, 0) + pushes;
+				maxstack = max(maxstack, d);
+			}
+
+			if (d > MAX_STACK_DEPTH) {
+				error("operand stack overflows at %d", k);
+				maxstack = -1;
+				break;
+			}
+
+			if (i->op == OP_RET || i->op == OP_HALT || i->op == OP_TAILCALL)
+				break;
+
+			if (isjump(i->op) && depth[i->arg] < d) {
+				depth[i->arg] = d;
+				if (!queued[i->arg]) {
+					queued[i->arg] = 1;
+					work[nwork++] = i->arg;
+				}
+			}
+
+			if (i->op == OP_JUMP)
+				break;
+
+			if (++k >= count || depth[k] >= d)
+				break;
+			depth[k] = d;
+		}
+	}
+
+	free(queued);
+	free(work);
+	free(depth);
+	return maxstack;
+}
+
 Object *KFunc_New(int locvars, uint8 *codes, int size, TypeDesc *proto)
 {
 	CodeObject *code = code_new(CODE_KLANG, proto);
 	code->kf.locvars = locvars;
 	code->kf.codes = codes;
 	code->kf.size = size;
+	code->kf.insts = decode_codes(codes, size, &code->kf.ninsts);
+	if (!code->kf.insts) {
+		error("decode function's codes failed");
+		exit(-1);
+	}
+	code->kf.maxstack = compute_maxstack(code->kf.insts, code->kf.ninsts);
+	if (code->kf.maxstack < 0) {
+		error("compute function's stack depth failed");
+		exit(-1);
+	}
 	return (Object *)code;
 }
 
@@ -12,19 +12,45 @@ extern "C" {
 
 #define CODE_KLANG  0
 #define CODE_CLANG  1
+#define CODE_NLANG  2
+
+/*
+  Fixed-width instruction, decoded from the raw codes when the function is
+  loaded. Operands are already assembled and jump offsets are resolved to
+  the absolute index of the target instruction.
+ */
+typedef struct instr {
+	uint8 op;
+	uint8 count;      /* observations before quickening */
+	uint16 argc;      /* second operand, number of arguments */
+	int32 arg;        /* first operand, index, count or jump target */
+	void *cache;      /* inline cache, allocated at first execution */
+} Instr;
 
 typedef struct codeobject {
 	OBJECT_HEAD
 	int flags;
 	TypeDesc *proto;
+	char *name;         /* function or method name, set when it is added */
+	Object *owner;      /* module or class, in which it is defined */
 	union {
 		cfunc cf;
+		nfunc nf;
 		struct {
 			Object *consts;   /* for const access, not free it */
 			Vector locvec;    /* local variables */
 			int locvars;
 			int size;
 			uint8 *codes;
+			int ninsts;       /* number of decoded instructions */
+			Instr *insts;     /* decoded instructions */
+			int maxstack;     /* max operand stack depth between calls */
+			TValue *tmpl;     /* initial locvars, built at first call */
+			Object *tmplmod;  /* module in which 'tmpl' types are found */
+			int verified;     /* passed the load-time verifier */
+			int hotness;      /* calls and backward jumps, -1 if not jitable */
+			void *jit;        /* native codes, compiled by jit */
+			uint32 *livemap;  /* live locvars, see stackmap.h */
 		} kf;
 	};
 } CodeObject;
@@ -34,9 +60,11 @@ extern Klass Code_Klass;
 #define OBJ_TO_CODE(ob) OB_TYPE_OF(ob, CodeObject, Code_Klass)
 Object *KFunc_New(int locvars, uint8 *codes, int size, TypeDesc *proto);
 Object *CFunc_New(cfunc cf, TypeDesc *proto);
+Object *NFunc_New(nfunc nf, TypeDesc *proto);
 void CodeObject_Free(Object *ob);
 #define CODE_ISKFUNC(code)  (((CodeObject *)(code))->flags == CODE_KLANG)
-#define CODE_ISCFUNC(code)  (((CodeObject *)(code))->flags == CODE_CLANG)
+#define CODE_ISCFUNC(code)  (((CodeObject *)(code))->flags != CODE_KLANG)
+#define CODE_ISNFUNC(code)  (((CodeObject *)(code))->flags == CODE_NLANG)
 // FIXME
 static inline int Func_Argc(Object *ob)
 {
@@ -53,7 +81,11 @@ static inline int Func_Argc(Object *ob)
 		return sz;
 	}
 }
+int Code_Name(Object *ob, char *buf, int size);
 int KFunc_Add_LocVar(Object *ob, char *name, TypeDesc *desc, int pos);
+int Instr_IsJump(Instr *i);
+int Instr_Stack_Effect(Instr *i, int *pops, int *pushes);
+#define KFunc_Verified(ob)  (((CodeObject *)(ob))->kf.verified)
 
 #ifdef __cplusplus
 }
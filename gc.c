@@ -1,18 +1,38 @@
 
+#include <limits.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
 #include "gc.h"
 #include "stringobject.h"
 #include "log.h"
 #include "koalastate.h"
+#include "routine.h"
+#include "stackmap.h"
+#include "slab.h"
 
 GCState gcs;
+/* the clock is read once per GC_CHECK_TIME bytes of work */
+#define GC_CHECK_TIME 4096
+/* collections of the stress mode */
+static int stresses;
 
 void *GC_Alloc(int size)
 {
-  Object *ob = calloc(1, size);
+  long bytes = sizeof(GCHeader) + size;
+  GCHeader *hdr = Slab_Alloc(bytes);
+  hdr->size = bytes;
+  Object *ob = (Object *)(hdr + 1);
   ob->ob_marked = gcs.currentwhite;
-  ob->ob_next = gcs.gcobjs;
-  gcs.gcobjs = ob;
+  ob->ob_next = gcs.youngobjs;
+  gcs.youngobjs = ob;
   ++gcs.count;
+  gcs.used += bytes;
+  gcs.young += bytes;
+  gcs.debt += bytes;
+  if (gcs.stress) gcs.debt = max(gcs.debt, GC_STEP_SIZE);
 
   return ob;
 }
@@ -21,46 +41,682 @@ void GC_Free(Object *ob)
 {
   debug("free object:%s", OB_KLASS(ob)->name);
   OB_KLASS(ob)->ob_free(ob);
-  free(ob);
+  GCHeader *hdr = GC_HEADER(ob);
+  gcs.used -= hdr->size;
+  Slab_Free(hdr, hdr->size);
 }
 
-void GC_Run(void)
+int GC_Alloc_Count(void)
 {
-  Vector stack = VECTOR_INIT;
-  Koala_Collect_Modules(&stack);
+  return gcs.count;
+}
 
-  gcs.state = GC_MARK;
+long GC_Used_Bytes(void)
+{
+  return gcs.used;
+}
+
+void GC_Set_Pause(int us)
+{
+  gcs.pause = us > 0 ? us : 0;
+}
+
+void GC_Set_Stress(int stress)
+{
+  gcs.stress = stress;
+}
+
+void GC_Set_Markers(int n)
+{
+  if (n <= 0) n = sysconf(_SC_NPROCESSORS_ONLN);
+  gcs.markers = max(min(n, GC_MAX_MARKERS), 1);
+}
+
+/* heap budget of the next cycle by the live bytes */
+static void set_budget(long live)
+{
+  gcs.total = max(live * GC_GROWTH, GC_MIN_HEAP);
+  if (gcs.limit) gcs.total = min(gcs.total, gcs.limit);
+  gcs.threshold0 = gcs.total * GC_LEVEL_0;
+  gcs.threshold1 = gcs.total * GC_LEVEL_1;
+}
+
+void GC_Set_Limit(long bytes)
+{
+  gcs.limit = bytes > 0 ? bytes : 0;
+  set_budget(gcs.used);
+}
+
+/*-------------------------------------------------------------------------*/
+
+/* slots of a mark stack, a power of 2 */
+#define MARK_STACK_SIZE 4096
+#define MARK_STACK_MASK (MARK_STACK_SIZE - 1)
 
+/*
+  A marker of parallel marking. Its mark stack is a work-stealing deque:
+  the owner pushes and pops at 'bottom', others steal at 'top'. Objects
+  pushed to a full stack go to the overflow, which only the owner takes.
+ */
+typedef struct marker {
+  long top __attribute__((aligned(64)));
+  long bottom __attribute__((aligned(64)));
+  Object *stack[MARK_STACK_SIZE];
+  Vector overflow;
+  /* size of overflow, read by the others */
+  int noverflow;
+  /* marked objects not from GC_Alloc(), see 'blackobjs' of GCState */
+  Vector blackobjs;
+  /* bytes scanned */
+  long done;
+  int id;
+  /* the last parallel marking the helper has seen */
+  int seen;
+  pthread_t thread;
+} Marker;
+
+/* the marker of this thread, NULL out of parallel marking */
+static __thread Marker *current;
+
+static void marker_push(Marker *m, Object *ob)
+{
+  long b = __atomic_load_n(&m->bottom, __ATOMIC_RELAXED);
+  long t = __atomic_load_n(&m->top, __ATOMIC_ACQUIRE);
+  if (b - t >= MARK_STACK_SIZE) {
+    Vector_Append(&m->overflow, ob);
+    __atomic_store_n(&m->noverflow, m->overflow.size, __ATOMIC_RELEASE);
+    return;
+  }
+  __atomic_store_n(&m->stack[b & MARK_STACK_MASK], ob, __ATOMIC_RELAXED);
+  __atomic_store_n(&m->bottom, b + 1, __ATOMIC_RELEASE);
+}
+
+static Object *marker_pop(Marker *m)
+{
+  long b = __atomic_load_n(&m->bottom, __ATOMIC_RELAXED) - 1;
+  __atomic_store_n(&m->bottom, b, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  long t = __atomic_load_n(&m->top, __ATOMIC_RELAXED);
+  Object *ob = NULL;
+  if (t <= b) {
+    ob = __atomic_load_n(&m->stack[b & MARK_STACK_MASK], __ATOMIC_RELAXED);
+    if (t == b) {
+      /* the last one, a thief may take it first */
+      if (!__atomic_compare_exchange_n(&m->top, &t, t + 1, 0,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        ob = NULL;
+      __atomic_store_n(&m->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+  } else {
+    __atomic_store_n(&m->bottom, b + 1, __ATOMIC_RELAXED);
+  }
+  return ob;
+}
+
+static Object *marker_steal(Marker *m)
+{
+  long t = __atomic_load_n(&m->top, __ATOMIC_ACQUIRE);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  long b = __atomic_load_n(&m->bottom, __ATOMIC_ACQUIRE);
+  if (t >= b) return NULL;
+  Object *ob = __atomic_load_n(&m->stack[t & MARK_STACK_MASK],
+                               __ATOMIC_RELAXED);
+  if (!__atomic_compare_exchange_n(&m->top, &t, t + 1, 0,
+                                   __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+    return NULL;
+  return ob;
+}
+
+/* the marker which grays an object scans it */
+static inline int gray(Object *ob, int marked)
+{
+  if (!current) {
+    ob->ob_marked = GC_GRAY;
+    return 1;
+  }
+  return __atomic_compare_exchange_n(&ob->ob_marked, &marked, GC_GRAY, 0,
+                                     __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+static inline void push_gray(Object *ob)
+{
+  if (current)
+    marker_push(current, ob);
+  else
+    Vector_Append(&gcs.grayobjs, ob);
+}
+
+void GC_Mark(Object *ob)
+{
+  ob = OB_Head(ob);
+  int marked = __atomic_load_n(&ob->ob_marked, __ATOMIC_RELAXED);
+  if (gcs.minor) {
+    /* only white young objects, not ones of others */
+    if (marked != gcs.currentwhite || GC_HEADER(ob)->old) return;
+    if (gray(ob, marked)) push_gray(ob);
+    return;
+  }
+  if (marked == GC_GRAY || marked == GC_BLACK || marked == GC_FIXED) return;
+  if (!gray(ob, marked)) return;
+  /* not from GC_Alloc(), its mark is cleared at the end of marking */
+  if (marked != gcs.currentwhite)
+    Vector_Append(current ? &current->blackobjs : &gcs.blackobjs, ob);
+  push_gray(ob);
+}
+
+void GC_Remember(Object *holder, Object *young)
+{
+  /* young objects are scanned by minor collections */
+  if (holder->ob_marked && !GC_HEADER(holder)->old) return;
+  GCHeader *hdr = GC_HEADER(young);
+  if (hdr->remembered) return;
+  hdr->remembered = 1;
+  Vector_Append(&gcs.remembered, young);
+}
+
+static void forget_all(void)
+{
   Object *ob;
-  Vector_ForEach(ob, &stack) {
-    ob->ob_marked = GC_BLACK;
-    if (OB_KLASS(ob)->ob_mark)
-      OB_KLASS(ob)->ob_mark(ob);
+  Vector_ForEach(ob, &gcs.remembered)
+    GC_HEADER(ob)->remembered = 0;
+  gcs.remembered.size = 0;
+}
+
+/* young objects are old from now on */
+static void promote(Object *ob)
+{
+  GCHeader *hdr = GC_HEADER(ob);
+  hdr->old = 1;
+  hdr->remembered = 0;
+  ob->ob_next = gcs.gcobjs;
+  gcs.gcobjs = ob;
+}
+
+/* a root scanned before is scanned again */
+static void mark_root(Object *ob)
+{
+  ob = OB_Head(ob);
+  if (ob->ob_marked == GC_BLACK) {
+    ob->ob_marked = GC_GRAY;
+    Vector_Append(&gcs.grayobjs, ob);
+  } else {
+    GC_Mark(ob);
+  }
+}
+
+static void mark_frame(Frame *f)
+{
+  uint32 *map = StackMap_Get(f->code, f->pc);
+  TValue *v;
+  for (int i = 0; i < f->size; i++) {
+    v = f->locvars + i;
+    if (!map || STACKMAP_LIVE(map, i))
+      GC_Mark_Value(v);
+    else if (VALUE_ISOBJECT(v))
+      clearobjvalue(v);
+  }
+}
+
+static void mark_routine(Routine *rt)
+{
+  for (int i = 0; i <= rt->top; i++)
+    GC_Mark_Value(rt->stack + i);
+
+  Frame *f = rt->frame;
+  while (f) {
+    mark_frame(f);
+    f = f->prev;
   }
+}
+
+static void mark_roots(void)
+{
+  Vector modules = VECTOR_INIT;
+  Koala_Collect_Modules(&modules);
+  Object *ob;
+  Vector_ForEach(ob, &modules)
+    mark_root(ob);
+  Vector_Fini(&modules, NULL, NULL);
+
+  struct list_head *pos;
+  list_for_each(pos, &gs.routines)
+    mark_routine(container_of(pos, Routine, link));
+}
+
+/*
+  Scan a gray object, returns its bytes. The bytes are estimated by its
+  klass, the objects not from GC_Alloc() have no header.
+ */
+static inline long scan(Object *ob)
+{
+  if (ob->ob_marked == GC_GRAY)
+    __atomic_store_n(&ob->ob_marked, GC_BLACK, __ATOMIC_RELAXED);
+  if (OB_KLASS(ob)->ob_mark)
+    OB_KLASS(ob)->ob_mark(ob);
+  return OB_KLASS(ob)->basesize + ob->ob_size * sizeof(TValue);
+}
+
+/* scan gray objects for 'work' bytes at most, returns the bytes scanned */
+static long propagate(long work)
+{
+  Vector *gray = &gcs.grayobjs;
+  long done = 0;
+  while (gray->size > 0 && done < work)
+    done += scan(gray->items[--gray->size]);
+  return done;
+}
+
+/*-------------------------------------------------------------------------*/
+
+/* markers, the first one is of the mutator's thread */
+static Marker *markers[GC_MAX_MARKERS];
+/* markers with a thread started */
+static int nthreads = 1;
+/* markers of the current marking and the ones out of work */
+static int nactive;
+static int nidle;
+/* parallel markings started, and the helpers done in the current one */
+static int epoch;
+static int nfinished;
+static pthread_mutex_t mark_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t mark_start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t mark_done = PTHREAD_COND_INITIALIZER;
+
+static Marker *marker_new(int id)
+{
+  Marker *m = calloc(1, sizeof(Marker));
+  if (!m) {
+    error("gc: alloc marker %d failed", id);
+    exit(-1);
+  }
+  m->id = id;
+  Vector_Init(&m->overflow);
+  Vector_Init(&m->blackobjs);
+  return m;
+}
+
+/* the next gray object of its own, refilled from the overflow */
+static Object *marker_next(Marker *m)
+{
+  Object *ob = marker_pop(m);
+  /* the others may steal all refilled ones before it pops */
+  while (!ob && m->overflow.size) {
+    /* put into the stack, where the others can steal them */
+    int n = min(m->overflow.size, MARK_STACK_SIZE / 2);
+    while (n-- > 0)
+      marker_push(m, m->overflow.items[--m->overflow.size]);
+    __atomic_store_n(&m->noverflow, m->overflow.size, __ATOMIC_RELEASE);
+    ob = marker_pop(m);
+  }
+  return ob;
+}
 
+static Object *steal_any(Marker *m)
+{
+  Object *ob;
+  for (int i = 1; i < nactive; i++) {
+    ob = marker_steal(markers[(m->id + i) % nactive]);
+    if (ob) return ob;
+  }
+  return NULL;
+}
+
+static int has_work(void)
+{
+  Marker *m;
+  for (int i = 0; i < nactive; i++) {
+    m = markers[i];
+    if (__atomic_load_n(&m->top, __ATOMIC_ACQUIRE) <
+        __atomic_load_n(&m->bottom, __ATOMIC_ACQUIRE) ||
+        __atomic_load_n(&m->noverflow, __ATOMIC_ACQUIRE))
+      return 1;
+  }
+  return 0;
+}
+
+/*
+  Scan objects of its own, or stolen from others, until all markers are
+  out of work. A marker is counted idle only with an empty stack and
+  overflow, so all gray objects are scanned when all of them are idle.
+ */
+static void drain(Marker *m)
+{
+  Object *ob;
+  for (;;) {
+    while ((ob = marker_next(m)) || (ob = steal_any(m)))
+      m->done += scan(ob);
+    __atomic_add_fetch(&nidle, 1, __ATOMIC_SEQ_CST);
+    for (;;) {
+      if (__atomic_load_n(&nidle, __ATOMIC_SEQ_CST) == nactive) return;
+      if (has_work()) {
+        __atomic_sub_fetch(&nidle, 1, __ATOMIC_SEQ_CST);
+        break;
+      }
+      sched_yield();
+    }
+  }
+}
+
+static void *marker_main(void *arg)
+{
+  Marker *m = arg;
+  /* signals are for the mutator, like the ones of the profiler */
+  sigset_t set;
+  sigfillset(&set);
+  pthread_sigmask(SIG_BLOCK, &set, NULL);
+  current = m;
+
+  for (;;) {
+    pthread_mutex_lock(&mark_lock);
+    while (epoch == m->seen)
+      pthread_cond_wait(&mark_start, &mark_lock);
+    m->seen = epoch;
+    int join = m->id < nactive;
+    pthread_mutex_unlock(&mark_lock);
+
+    if (join) drain(m);
+
+    pthread_mutex_lock(&mark_lock);
+    if (join && ++nfinished == nactive - 1)
+      pthread_cond_signal(&mark_done);
+    pthread_mutex_unlock(&mark_lock);
+  }
+  return NULL;
+}
+
+static int start_markers(int n)
+{
+  if (!markers[0]) markers[0] = marker_new(0);
+  Marker *m;
+  while (nthreads < n) {
+    m = marker_new(nthreads);
+    /*
+      the earlier markings are done, and the thread may run after the next
+      one is started, so it is not left to the thread
+     */
+    pthread_mutex_lock(&mark_lock);
+    m->seen = epoch;
+    pthread_mutex_unlock(&mark_lock);
+    if (pthread_create(&m->thread, NULL, marker_main, m)) {
+      warn("gc: marker %d is not started", nthreads);
+      Vector_Fini(&m->overflow, NULL, NULL);
+      free(m);
+      break;
+    }
+    pthread_detach(m->thread);
+    markers[nthreads++] = m;
+  }
+  return min(n, nthreads);
+}
+
+/*
+  Drain the gray objects by the markers in parallel, the mutator's thread
+  is one of them. Returns the bytes scanned.
+ */
+static long parallel_mark(void)
+{
+  int n = start_markers(gcs.markers);
+  Marker *m = markers[0];
+  Object *ob;
+  Vector_ForEach(ob, &gcs.grayobjs)
+    marker_push(m, ob);
+  gcs.grayobjs.size = 0;
+
+  pthread_mutex_lock(&mark_lock);
+  nactive = n;
+  nidle = 0;
+  nfinished = 0;
+  ++epoch;
+  pthread_cond_broadcast(&mark_start);
+  pthread_mutex_unlock(&mark_lock);
+
+  current = m;
+  drain(m);
+  current = NULL;
+
+  pthread_mutex_lock(&mark_lock);
+  while (nfinished < n - 1)
+    pthread_cond_wait(&mark_done, &mark_lock);
+  pthread_mutex_unlock(&mark_lock);
+
+  long done = 0;
+  for (int i = 0; i < n; i++) {
+    m = markers[i];
+    assert(!m->overflow.size && !m->noverflow);
+    done += m->done;
+    m->done = 0;
+    Vector_Concat(&gcs.blackobjs, &m->blackobjs);
+    m->blackobjs.size = 0;
+  }
+  debug("gc: %d markers scanned %ld bytes", n, done);
+  return done;
+}
+
+/*
+  Drain the gray objects, in parallel when the marking is big enough to
+  pay for waking the markers.
+ */
+static long mark_all(void)
+{
+  long done = 0;
+  while (gcs.grayobjs.size > 0) {
+    if (gcs.markers > 1 && done >= GC_PARALLEL_WORK &&
+        gcs.grayobjs.size > 1)
+      return done + parallel_mark();
+    done += propagate(GC_CHECK_TIME);
+  }
+  return done;
+}
+
+/*
+  Roots are rescanned and marking is done without a break, after which no
+  white object is reachable. Objects allocated from now on are of the new
+  white, and the old white ones are garbage.
+ */
+static void atomic(void)
+{
+  mark_roots();
+  mark_all();
+
+  Object *ob;
+  Vector_ForEach(ob, &gcs.blackobjs)
+    ob->ob_marked = 0;
+  gcs.blackobjs.size = 0;
+
+  gcs.currentwhite = GC_OTHER_WHITE(gcs.currentwhite);
+
+  /* young objects are swept with old ones */
+  Object *next;
+  for (ob = gcs.youngobjs; ob; ob = next) {
+    next = ob->ob_next;
+    promote(ob);
+  }
+  gcs.youngobjs = NULL;
+  gcs.young = 0;
+
+  gcs.sweep = &gcs.gcobjs;
   gcs.state = GC_SWEEP;
-  Object *head = NULL;
+}
+
+/*
+  Minor collection, in one step between major cycles.
+  Young objects are marked from the routines and the remembered set, and
+  the roots' modules and other old objects are not scanned, their young
+  children are in the remembered set.
+ */
+static void minor(void)
+{
+  debug("gc: minor %d starts, %ld young bytes", gcs.minors, gcs.young);
+  gcs.minor = 1;
+  struct list_head *pos;
+  list_for_each(pos, &gs.routines)
+    mark_routine(container_of(pos, Routine, link));
+  Object *ob;
+  Vector_ForEach(ob, &gcs.remembered)
+    GC_Mark(ob);
+  mark_all();
+  gcs.minor = 0;
+
   Object *next;
-  ob = gcs.gcobjs;
-  while (ob) {
+  for (ob = gcs.youngobjs; ob; ob = next) {
     next = ob->ob_next;
     if (ob->ob_marked == gcs.currentwhite) {
       GC_Free(ob);
     } else {
-      ob->ob_next = head;
-      head = ob;
+      if (ob->ob_marked == GC_BLACK)
+        ob->ob_marked = gcs.currentwhite;
+      promote(ob);
+    }
+  }
+  gcs.youngobjs = NULL;
+  gcs.young = 0;
+  gcs.remembered.size = 0;
+  debug("gc: minor %d ends, %ld bytes alive", gcs.minors, gcs.used);
+  ++gcs.minors;
+}
+
+/* sweep objects for 'work' bytes at most, returns the bytes swept */
+static long sweep(long work)
+{
+  int deadwhite = GC_OTHER_WHITE(gcs.currentwhite);
+  Object *ob;
+  long done = 0;
+  while (*gcs.sweep && done < work) {
+    ob = *gcs.sweep;
+    done += GC_HEADER(ob)->size;
+    if (ob->ob_marked == deadwhite) {
+      *gcs.sweep = ob->ob_next;
+      GC_Free(ob);
+    } else {
+      if (ob->ob_marked != GC_FIXED)
+        ob->ob_marked = gcs.currentwhite;
+      gcs.sweep = &ob->ob_next;
     }
-    ob = next;
   }
-  gcs.gcobjs = head;
+  return done;
+}
+
+static void start_cycle(void)
+{
+  debug("gc: cycle %d starts, %ld/%ld bytes", gcs.cycles, gcs.used,
+        gcs.total);
+  gcs.state = GC_MARK;
+  /* the young objects are taken at the atomic step */
+  forget_all();
+  mark_roots();
+}
+
+static void finish_cycle(void)
+{
   gcs.state = GC_STOP;
+  gcs.sweep = NULL;
+  set_budget(gcs.used);
+  debug("gc: cycle %d ends, %ld bytes alive, %d pages", gcs.cycles, gcs.used,
+        Slab_Pages());
+  ++gcs.cycles;
+}
+
+static inline long now_us(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000L + ts.tv_nsec / 1000;
+}
+
+/* run the cycle by 'work' bytes at most, until it is stopped */
+static long gc_work(long work, long deadline)
+{
+  long done = 0;
+  long n;
+  while (gcs.state != GC_STOP && done < work) {
+    n = min(work - done, GC_CHECK_TIME);
+    if (gcs.state == GC_MARK) {
+      /* a full marking is not broken into pieces */
+      n = work == LONG_MAX && !deadline ? mark_all() : propagate(n);
+      if (!gcs.grayobjs.size) atomic();
+    } else {
+      n = sweep(n);
+      if (!*gcs.sweep) finish_cycle();
+    }
+    done += n;
+    if (deadline && now_us() >= deadline) break;
+  }
+  return done;
+}
+
+void GC_Run(void)
+{
+  /* garbage made after marking started is only found by a new cycle */
+  if (gcs.state != GC_STOP)
+    gc_work(LONG_MAX, 0);
+  start_cycle();
+  gc_work(LONG_MAX, 0);
+  gcs.debt = 0;
+}
+
+void GC_Step(void)
+{
+  if (gcs.stress) {
+    /* minor ones mostly, which check the remembered set */
+    if (gcs.state == GC_STOP && ++stresses % GC_STRESS_FULL)
+      minor();
+    else
+      GC_Run();
+    /* the collection pays for all allocated before it */
+    gcs.debt = 0;
+    return;
+  }
+
+  if (gcs.limit && gcs.used >= gcs.limit) {
+    GC_Run();
+    if (gcs.used >= gcs.limit) {
+      error("gc: heap limit %ld bytes reached, %ld bytes are alive",
+            gcs.limit, gcs.used);
+      exit(-1);
+    }
+    return;
+  }
+
+  if (gcs.state == GC_STOP) {
+    if (gcs.used < gcs.threshold0) {
+      if (gcs.young >= min(GC_NURSERY_SIZE, gcs.total / 4)) minor();
+      gcs.debt = 0;
+      return;
+    }
+    start_cycle();
+  }
+
+  long work = gcs.debt * GC_STEP_MUL;
+  long deadline = gcs.pause ? now_us() + gcs.pause : 0;
+  if (gcs.used >= gcs.threshold1) {
+    work *= GC_HURRY;
+    deadline = 0;
+  }
+  long done = gc_work(work, deadline);
+  /* the unpaid work is left to the next safepoint */
+  gcs.debt = gcs.state == GC_STOP ? 0 : max(gcs.debt - done / GC_STEP_MUL, 0);
 }
 
 void GC_Init(void)
 {
   gcs.state = GC_STOP;
+  gcs.currentwhite = GC_WHITE0;
   gcs.count = 0;
+  gcs.used = 0;
+  gcs.debt = 0;
+  gcs.pause = GC_PAUSE_US;
+  gcs.stress = 0;
+  GC_Set_Markers(0);
+  gcs.limit = 0;
+  set_budget(0);
+  gcs.sweep = NULL;
+  gcs.cycles = 0;
   gcs.gcobjs = NULL;
+  gcs.youngobjs = NULL;
+  gcs.young = 0;
+  gcs.minor = 0;
+  gcs.minors = 0;
+  Vector_Init(&gcs.remembered);
   Vector_Init(&gcs.grayobjs);
   Vector_Init(&gcs.blackobjs);
 }
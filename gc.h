@@ -9,6 +9,67 @@
 extern "C" {
 #endif
 
+/*
+  Incremental tri-color mark and sweep.
+  Objects from GC_Alloc() are linked in 'gcobjs'. A cycle runs in bounded
+  steps at the safepoints of the vm, interleaved with the mutator:
+    GC_MARK:  gray objects are popped and scanned, their children grayed;
+    atomic:   roots are rescanned and the gray ones drained in one step,
+              and the white is flipped;
+    GC_SWEEP: 'gcobjs' is walked from the cursor, objects of the old white
+              are freed and the others are whitened for the next cycle.
+  Roots are modules and the stacks and frames of routines. They are not
+  guarded by barriers, but rescanned at the atomic step instead.
+  Roots are precise: the operand stack is scanned up to its top, and the
+  locvars of a frame by the stack map at its pc(see stackmap.h). A dead
+  locvar is not scanned but cleared, as it may be scanned entirely later.
+  Tuples, lists, tables, modules and klasses are not from GC_Alloc(), they
+  are scanned through but not swept, and their marks are cleared at the
+  end of marking. Tuples, lists with their items and tables with their
+  entries are from the slab(see slab.h), and are given back by Slab_Free()
+  in their ob_free when their owners free them, e.g. Tuple_Free() of the
+  values of a module.
+
+  Generations. New objects are young, linked in 'youngobjs'. When the
+  young ones reach GC_NURSERY_SIZE bytes(a quarter of 'total' at most)
+  between cycles, a minor collection marks them from the stacks and
+  frames of routines and the remembered set, frees the unmarked ones and
+  promotes the others into 'gcobjs'. Old objects and the ones not from GC_Alloc() are not scanned.
+  The write barrier remembers a young object stored into an old one or
+  into a tuple, list, table or module, so it survives the next minor
+  collection. Locvars are not guarded, they are roots.
+  A major cycle takes all young objects at its atomic step, and the ones
+  allocated after it are young for the next minor collection. Objects
+  are never moved, C codes hold them by pointers.
+
+  Pacing is by bytes. 'used' counts the bytes of objects from GC_Alloc(),
+  and 'total' is the heap budget of the next cycle, twice the bytes alive
+  after the last one, within the heap limit if it is set:
+    used < total x GC_LEVEL_0:  no collection;
+    used >= total x GC_LEVEL_0: a cycle is started, each step does
+                                GC_STEP_MUL bytes of work per byte
+                                allocated, within the pause budget;
+    used >= total x GC_LEVEL_1: the collector is behind, steps do
+                                GC_HURRY times the work and ignore the
+                                pause budget;
+    used >= limit:              back-pressure, the mutator waits at the
+                                safepoint for a full collection, and the
+                                vm exits if the heap is still full.
+  A step stops when its work is done or its pause budget is spent, and the
+  rest is carried over to the next safepoint. The heap may overshoot the
+  limit by what is allocated between two steps.
+
+  Parallel marking. A marking done without a break, at the atomic step,
+  by a full collection or by a minor one, is drained by 'markers' threads
+  once it has scanned GC_PARALLEL_WORK bytes alone, the mutator's thread
+  being one of them and the others waiting for the next one. A marker
+  scans objects from its own mark stack and steals from the others' when
+  it is empty, see Marker in gc.c. An object is grayed by a CAS of its
+  mark, so it is scanned by one marker. The bounded steps of an
+  incremental cycle are marked by the mutator's thread alone.
+
+  The collector assumes that one routine runs at a time.
+ */
 #define GC_LEVEL_0 0.6
 #define GC_LEVEL_1 0.8
 
@@ -16,29 +77,138 @@ extern "C" {
 #define GC_WHITE1 2
 #define GC_GRAY   3
 #define GC_BLACK  4
+#define GC_FIXED  5  /* never freed */
+#define GC_OTHER_WHITE(w) (GC_WHITE0 + GC_WHITE1 - (w))
 
 #define GC_STOP  1
 #define GC_MARK  2
 #define GC_SWEEP 3
 
+#define GC_MIN_HEAP   (1L << 20)  /* minimum 'total' */
+#define GC_GROWTH     2           /* 'total' is the live bytes x 2 */
+#define GC_STEP_SIZE  8192        /* bytes allocated between two steps */
+#define GC_STEP_MUL   2           /* bytes of work per byte allocated */
+#define GC_HURRY      4
+#define GC_PAUSE_US   500         /* default pause budget of a step */
+#define GC_NURSERY_SIZE (256L << 10)  /* young bytes of a minor collection */
+#define GC_STRESS_FULL 16         /* a full one per minor ones of stress */
+#define GC_MAX_MARKERS 64
+#define GC_PARALLEL_WORK (256L << 10)  /* bytes marked before going parallel */
+
+/* prefix of objects from GC_Alloc(), keeps them 16-byte aligned */
+typedef struct gcheader {
+  long size;
+  int old;
+  int remembered;
+} GCHeader;
+
+#define GC_HEADER(ob) ((GCHeader *)(ob) - 1)
+
 typedef struct gcstate {
   int state;
   int currentwhite;
   int count;
   Object *gcobjs;
+  Object *youngobjs;
+  /* young objects stored into old ones, see GC_Write_Barrier() */
+  Vector remembered;
   Vector grayobjs;
+  /* marked objects which are not from GC_Alloc() */
   Vector blackobjs;
-  int total;
-  int used;
-  int threshold0;
-  int threshold1;
+  /* bytes, see pacing above */
+  long total;
+  long used;
+  long threshold0;
+  long threshold1;
+  /* 0 is no limit */
+  long limit;
+  /* bytes of young objects */
+  long young;
+  /* bytes allocated and not paid for by steps */
+  long debt;
+  /* pause budget of a step in microseconds, 0 is unbounded */
+  int pause;
+  /* a collection at every safepoint after an allocation, a full one per
+     GC_STRESS_FULL ones and minor ones otherwise */
+  int stress;
+  /* marking of a minor collection */
+  int minor;
+  /* threads of parallel marking, online cpus by default */
+  int markers;
+  /* link to the next object to be swept */
+  Object **sweep;
+  int cycles;
+  int minors;
 } GCState;
 
+extern GCState gcs;
+
 /* Exported APIs */
 void *GC_Alloc(int size);
 void GC_Free(Object *ob);
 void GC_Init(void);
+/* a full collection, finishing the current cycle first */
 void GC_Run(void);
+void GC_Step(void);
+void GC_Set_Pause(int us);
+void GC_Set_Stress(int stress);
+void GC_Set_Limit(long bytes);
+/* 0 is one per online cpu, 1 is marking alone */
+void GC_Set_Markers(int n);
+long GC_Used_Bytes(void);
+/* number of objects allocated so far, never decreased */
+int GC_Alloc_Count(void);
+
+/* Used by ob_mark of klasses to gray their children */
+void GC_Mark(Object *ob);
+void GC_Remember(Object *holder, Object *young);
+#define GC_Mark_Value(v) do { \
+  if (VALUE_ISOBJECT(v)) GC_Mark(VALUE_OBJECT(v)); \
+} while (0)
+
+/*
+  Safepoints are where no object is held only in C variables: between
+  frames in Routine_Run(), at backward jumps of frame_loop() and after
+  allocations of jitted codes. The pc of an interpreted frame is saved
+  before a step, its stack map is looked up by it.
+ */
+#define GC_PENDING() (gcs.debt >= GC_STEP_SIZE)
+#define GC_SAFEPOINT() do { \
+  if (GC_PENDING()) GC_Step(); \
+} while (0)
+
+/*
+  Write barrier of storing 'val' into a field or an item of 'ob'.
+  While marking, a white object stored into a black one is grayed, so a
+  scanned object never points to an unscanned one. Otherwise a young
+  object stored into an old one is remembered.
+  Objects not from GC_Alloc() are never marked out of marking.
+ */
+static inline void GC_Write_Barrier(Object *ob, TValue *val)
+{
+  if (!VALUE_ISOBJECT(val)) return;
+  Object *vob = OB_Head(VALUE_OBJECT(val));
+  if (gcs.state == GC_MARK) {
+    if (OB_Head(ob)->ob_marked == GC_BLACK)
+      GC_Mark(vob);
+  } else if (vob->ob_marked && !GC_HEADER(vob)->old) {
+    GC_Remember(OB_Head(ob), vob);
+  }
+}
+
+/* an object from GC_Alloc() referenced by non-gc ones, like consts */
+static inline void GC_Fix(Object *ob)
+{
+  if (ob->ob_marked) ob->ob_marked = GC_FIXED;
+}
+
+/* an object found in a weak cache(strings) is alive again */
+static inline void GC_Revive(Object *ob)
+{
+  if (gcs.state == GC_SWEEP &&
+      ob->ob_marked == GC_OTHER_WHITE(gcs.currentwhite))
+    ob->ob_marked = gcs.currentwhite;
+}
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,844 @@
+
+#include "jit.h"
+#include "tupleobject.h"
+#include "opcode.h"
+#include "gc.h"
+#include "log.h"
+
+int Jit_Threshold;
+
+void Jit_Enable(int threshold)
+{
+  Jit_Threshold = threshold;
+  debug("jit is %s, threshold %d", threshold ? "on" : "off", threshold);
+}
+
+#if KOALA_JIT
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* OP2_XXX and OP3_XXX push their operands, if they are not int or float */
+#define JIT_STACK_EXTRA 2
+
+typedef struct jitcode {
+  void *mem;        /* mmap'd executable memory */
+  size_t size;
+  void **entries;   /* native address of each instruction */
+} JitCode;
+
+/*
+  Register usage of native codes:
+  rbx: Frame *, r12: Routine *, r13: frame->locvars,
+  r14: entries, the native address of each instruction,
+  r15: address of the top value of the operand stack, rt->stack + rt->top.
+  rt->top is written back before calling any helper, and r15 is reloaded
+  after it, so the helpers see the same stack as in frame_loop().
+ */
+#define RAX 0
+#define RCX 1
+#define RDX 2
+#define RBX 3
+#define RSI 6
+#define RDI 7
+#define R12 12
+#define R13 13
+#define R14 14
+#define R15 15
+
+/* condition codes of jcc and setcc */
+#define CC_P  0xA
+#define CC_NP 0xB
+#define CC_E  0x4
+#define CC_NE 0x5
+#define CC_A  0x7
+#define CC_AE 0x3
+#define CC_L  0xC
+#define CC_GE 0xD
+#define CC_LE 0xE
+#define CC_G  0xF
+
+#define VALUE_SIZE  ((int)sizeof(TValue))
+#define LOCVAR(n)   ((n) * VALUE_SIZE)
+
+/* the instruction index of the epilogue */
+#define EPILOGUE(jb) ((jb)->ninsts)
+
+struct fixup {
+  int pos;          /* position of rel32 */
+  int target;       /* index of target instruction */
+};
+
+typedef struct jitbuf {
+  uint8 *codes;
+  int size;
+  int capacity;
+  int ninsts;
+  int *offsets;     /* native offset of each instruction, and epilogue */
+  struct fixup *fixups;
+  int nfixups;
+  int cfixups;
+} JitBuf;
+
+static void emit1(JitBuf *jb, uint8 b)
+{
+  if (jb->size >= jb->capacity) {
+    jb->capacity = jb->capacity ? jb->capacity << 1 : 4096;
+    jb->codes = realloc(jb->codes, jb->capacity);
+    assert(jb->codes);
+  }
+  jb->codes[jb->size++] = b;
+}
+
+static void emit4(JitBuf *jb, uint32 v)
+{
+  for (int i = 0; i < 4; i++)
+    emit1(jb, (v >> (i * 8)) & 0xff);
+}
+
+static void emit8(JitBuf *jb, uint64 v)
+{
+  emit4(jb, (uint32)v);
+  emit4(jb, (uint32)(v >> 32));
+}
+
+static void emit_bytes(JitBuf *jb, int n, ...)
+{
+  va_list args;
+  va_start(args, n);
+  while (n-- > 0)
+    emit1(jb, (uint8)va_arg(args, int));
+  va_end(args);
+}
+
+static void emit_rex(JitBuf *jb, int w, int reg, int rm)
+{
+  uint8 rex = 0x40 | (w << 3) | ((reg >> 3) << 2) | (rm >> 3);
+  if (rex != 0x40) emit1(jb, rex);
+}
+
+static void emit_opcode(JitBuf *jb, int op)
+{
+  if (op > 0xff) emit1(jb, op >> 8);
+  emit1(jb, op & 0xff);
+}
+
+/* op reg, [base + disp32], 'prefix' is the mandatory prefix of sse */
+static void emit_mem(JitBuf *jb, uint8 prefix, int w, int op, int reg,
+                     int base, int32 disp)
+{
+  if (prefix) emit1(jb, prefix);
+  emit_rex(jb, w, reg, base);
+  emit_opcode(jb, op);
+  emit1(jb, 0x80 | ((reg & 7) << 3) | (base & 7));
+  if ((base & 7) == 4) emit1(jb, 0x24);
+  emit4(jb, disp);
+}
+
+/* op rm, reg */
+static void emit_reg(JitBuf *jb, int w, int op, int reg, int rm)
+{
+  emit_rex(jb, w, reg, rm);
+  emit_opcode(jb, op);
+  emit1(jb, 0xc0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+#define load64(jb, reg, base, disp)  emit_mem(jb, 0, 1, 0x8b, reg, base, disp)
+#define store64(jb, base, disp, reg) emit_mem(jb, 0, 1, 0x89, reg, base, disp)
+#define store32(jb, base, disp, reg) emit_mem(jb, 0, 0, 0x89, reg, base, disp)
+#define load32(jb, reg, base, disp)  emit_mem(jb, 0, 0, 0x8b, reg, base, disp)
+#define cmp64(jb, reg, base, disp)   emit_mem(jb, 0, 1, 0x3b, reg, base, disp)
+#define mov64(jb, dst, src)          emit_reg(jb, 1, 0x89, src, dst)
+
+static void movimm64(JitBuf *jb, int reg, uint64 imm)
+{
+  emit_rex(jb, 1, 0, reg);
+  emit1(jb, 0xb8 + (reg & 7));
+  emit8(jb, imm);
+}
+
+/* add/sub reg, imm8 */
+static void addimm(JitBuf *jb, int reg, int imm)
+{
+  emit_reg(jb, 1, 0x83, imm >= 0 ? 0 : 5, reg);
+  emit1(jb, imm >= 0 ? imm : -imm);
+}
+
+/* copy a value by xmm0 */
+static void copy_value(JitBuf *jb, int dbase, int32 ddisp,
+                       int sbase, int32 sdisp)
+{
+  emit_mem(jb, 0xf3, 0, 0x0f6f, 0, sbase, sdisp);
+  emit_mem(jb, 0xf3, 0, 0x0f7f, 0, dbase, ddisp);
+}
+
+static int jump_forward(JitBuf *jb, int cc)
+{
+  if (cc < 0) {
+    emit1(jb, 0xe9);
+  } else {
+    emit_bytes(jb, 2, 0x0f, 0x80 | cc);
+  }
+  emit4(jb, 0);
+  return jb->size - 4;
+}
+
+static void jump_here(JitBuf *jb, int pos)
+{
+  uint32 rel = jb->size - (pos + 4);
+  memcpy(jb->codes + pos, &rel, 4);
+}
+
+/* jump to an instruction, resolved after all are emitted */
+static void jump_to(JitBuf *jb, int cc, int target)
+{
+  int pos = jump_forward(jb, cc);
+  if (jb->nfixups >= jb->cfixups) {
+    jb->cfixups = jb->cfixups ? jb->cfixups << 1 : 64;
+    jb->fixups = realloc(jb->fixups, jb->cfixups * sizeof(struct fixup));
+    assert(jb->fixups);
+  }
+  jb->fixups[jb->nfixups].pos = pos;
+  jb->fixups[jb->nfixups].target = target;
+  jb->nfixups++;
+}
+
+static void push_slot(JitBuf *jb)
+{
+  addimm(jb, R15, VALUE_SIZE);
+}
+
+static void pop_slots(JitBuf *jb, int n)
+{
+  addimm(jb, R15, -n * VALUE_SIZE);
+}
+
+/* rt->top = (r15 - rt->stack) / sizeof(TValue) */
+static void spill_top(JitBuf *jb)
+{
+  mov64(jb, RAX, R15);
+  emit_mem(jb, 0, 1, 0x2b, RAX, R12, offsetof(Routine, stack));
+  emit_bytes(jb, 4, 0x48, 0xc1, 0xf8, 4);
+  store32(jb, R12, offsetof(Routine, top), RAX);
+}
+
+/* r15 = rt->stack + rt->top */
+static void reload_top(JitBuf *jb)
+{
+  emit_mem(jb, 0, 1, 0x63, RAX, R12, offsetof(Routine, top));
+  emit_bytes(jb, 4, 0x48, 0xc1, 0xe0, 4);
+  emit_mem(jb, 0, 1, 0x03, RAX, R12, offsetof(Routine, stack));
+  mov64(jb, R15, RAX);
+}
+
+static void call_helper(JitBuf *jb, void *func)
+{
+  movimm64(jb, RAX, (uint64)func);
+  emit_bytes(jb, 2, 0xff, 0xd0);
+}
+
+/* helper(rt, ...) which may change the stack */
+static void call_stack_helper(JitBuf *jb, void *func)
+{
+  spill_top(jb);
+  mov64(jb, RDI, R12);
+  call_helper(jb, func);
+  reload_top(jb);
+}
+
+/*
+  Jitted loops do not reach the safepoints of frame_loop(), so allocations
+  are. The stack is spilled and locvars are in the frame at helper calls.
+ */
+static void jit_new(Routine *rt, Object *consts, Instr *i)
+{
+  do_new(rt, consts, i);
+  GC_SAFEPOINT();
+}
+
+static void jit_new_array(Routine *rt, int count)
+{
+  do_new_array(rt, count);
+  GC_SAFEPOINT();
+}
+
+static void jit_load_subscr(Routine *rt)
+{
+  TValue val = do_load_subscr(rt);
+  rt_stack_push(rt, &val);
+}
+
+/*-------------------------------------------------------------------------*/
+
+static void emit_prologue(JitBuf *jb, JitCode *jc)
+{
+  emit1(jb, 0x53);
+  emit_bytes(jb, 8, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57);
+  mov64(jb, RBX, RDI);
+  load64(jb, R12, RBX, offsetof(Frame, rt));
+  emit_mem(jb, 0, 1, 0x8d, R13, RBX, offsetof(Frame, locvars));
+  movimm64(jb, R14, (uint64)jc->entries);
+  reload_top(jb);
+  /* resume at frame->pc */
+  emit_mem(jb, 0, 1, 0x63, RAX, RBX, offsetof(Frame, pc));
+  emit_bytes(jb, 4, 0x41, 0xff, 0x24, 0xc6);
+}
+
+static void emit_epilogue(JitBuf *jb)
+{
+  jb->offsets[EPILOGUE(jb)] = jb->size;
+  emit_bytes(jb, 8, 0x41, 0x5f, 0x41, 0x5e, 0x41, 0x5d, 0x41, 0x5c);
+  emit1(jb, 0x5b);
+  emit1(jb, 0xc3);
+}
+
+/* the generic operation of quickened, locvars and compare-jump ones */
+static int base_op(int op)
+{
+  switch (op) {
+    case OP_ADD_II: case OP_ADD_FF: case OP2_ADD: case OP3_ADD:
+      return OP_ADD;
+    case OP_SUB_II: case OP_SUB_FF: case OP2_SUB: case OP3_SUB:
+      return OP_SUB;
+    case OP_MUL_II: case OP_MUL_FF: case OP2_MUL: case OP3_MUL:
+      return OP_MUL;
+    case OP2_DIV: case OP3_DIV:
+      return OP_DIV;
+    case OP_GT_II: case OP_GT_FF:
+    case OP_GT_JUMP_TRUE: case OP_GT_JUMP_FALSE:
+      return OP_GT;
+    case OP_GE_II: case OP_GE_FF:
+    case OP_GE_JUMP_TRUE: case OP_GE_JUMP_FALSE:
+      return OP_GE;
+    case OP_LT_II: case OP_LT_FF:
+    case OP_LT_JUMP_TRUE: case OP_LT_JUMP_FALSE:
+      return OP_LT;
+    case OP_LE_II: case OP_LE_FF:
+    case OP_LE_JUMP_TRUE: case OP_LE_JUMP_FALSE:
+      return OP_LE;
+    case OP_EQ_II: case OP_EQ_FF:
+    case OP_EQ_JUMP_TRUE: case OP_EQ_JUMP_FALSE:
+      return OP_EQ;
+    case OP_NEQ_II: case OP_NEQ_FF:
+    case OP_NEQ_JUMP_TRUE: case OP_NEQ_JUMP_FALSE:
+      return OP_NEQ;
+    default:
+      return op;
+  }
+}
+
+/* jump if both values are not of 'klazz' */
+static void guard_klass(JitBuf *jb, Klass *klazz, int b1, int32 d1,
+                        int b2, int32 d2, int *fails)
+{
+  movimm64(jb, RAX, (uint64)klazz);
+  cmp64(jb, RAX, b1, d1);
+  fails[0] = jump_forward(jb, CC_NE);
+  cmp64(jb, RAX, b2, d2);
+  fails[1] = jump_forward(jb, CC_NE);
+}
+
+/*
+  Arithmetic of v1 and v2, the int or float result is in rax.
+  Int operations are the same as numberobject.c: add, sub and mul wrap
+  around as uint64, and div is signed, see Int_Div().
+ */
+static void emit_int_arith(JitBuf *jb, int op, int b1, int32 d1,
+                           int b2, int32 d2)
+{
+  load64(jb, RAX, b1, d1 + 8);
+  switch (op) {
+    case OP_ADD:
+      emit_mem(jb, 0, 1, 0x03, RAX, b2, d2 + 8);
+      break;
+    case OP_SUB:
+      emit_mem(jb, 0, 1, 0x2b, RAX, b2, d2 + 8);
+      break;
+    case OP_MUL:
+      emit_mem(jb, 0, 1, 0x0faf, RAX, b2, d2 + 8);
+      break;
+    case OP_DIV:
+      /* cqo; idiv */
+      emit_bytes(jb, 2, 0x48, 0x99);
+      emit_mem(jb, 0, 1, 0xf7, 7, b2, d2 + 8);
+      break;
+    default:
+      assert(0);
+      break;
+  }
+}
+
+static void emit_float_arith(JitBuf *jb, int op, int b1, int32 d1,
+                             int b2, int32 d2)
+{
+  int sse;
+  switch (op) {
+    case OP_ADD: sse = 0x0f58; break;
+    case OP_SUB: sse = 0x0f5c; break;
+    case OP_MUL: sse = 0x0f59; break;
+    case OP_DIV: sse = 0x0f5e; break;
+    default: assert(0); return;
+  }
+  emit_mem(jb, 0xf2, 0, 0x0f10, 0, b1, d1 + 8);
+  emit_mem(jb, 0xf2, 0, sse, 0, b2, d2 + 8);
+  /* movq rax, xmm0 */
+  emit_bytes(jb, 5, 0x66, 0x48, 0x0f, 0x7e, 0xc0);
+}
+
+/*
+  The result of OP2_XXX is pushed(dst = -1), of OP3_XXX is stored into
+  locvars(dst >= 0), and of OP_XXX replaces v2 in stack(dst = -2).
+ */
+#define DST_STACK -2
+#define DST_PUSH  -1
+
+static void write_result(JitBuf *jb, Klass *klazz, int dst)
+{
+  if (dst == DST_STACK) {
+    store64(jb, R15, -VALUE_SIZE + 8, RAX);
+    pop_slots(jb, 1);
+  } else if (dst == DST_PUSH) {
+    push_slot(jb);
+    store64(jb, R15, 8, RAX);
+    movimm64(jb, RAX, (uint64)klazz);
+    store64(jb, R15, 0, RAX);
+  } else {
+    store64(jb, R13, LOCVAR(dst) + 8, RAX);
+  }
+}
+
+static void emit_arith(JitBuf *jb, int op, int b1, int32 d1,
+                       int b2, int32 d2, int dst)
+{
+  int ifails[2], ffails[2], dfails[2], done[2];
+  int ndfails = 0;
+
+  guard_klass(jb, &Int_Klass, b1, d1, b2, d2, ifails);
+  if (op == OP_DIV) {
+    /* divided by zero or INT64_MIN / -1 would trap, left to numops */
+    emit_mem(jb, 0, 1, 0x83, 7, b2, d2 + 8);
+    emit1(jb, 0);
+    dfails[ndfails++] = jump_forward(jb, CC_E);
+    emit_mem(jb, 0, 1, 0x83, 7, b2, d2 + 8);
+    emit1(jb, 0xff);
+    dfails[ndfails++] = jump_forward(jb, CC_E);
+  }
+  emit_int_arith(jb, op, b1, d1, b2, d2);
+  write_result(jb, &Int_Klass, dst);
+  done[0] = jump_forward(jb, -1);
+
+  jump_here(jb, ifails[0]);
+  jump_here(jb, ifails[1]);
+  guard_klass(jb, &Float_Klass, b1, d1, b2, d2, ffails);
+  emit_float_arith(jb, op, b1, d1, b2, d2);
+  write_result(jb, &Float_Klass, dst);
+  done[1] = jump_forward(jb, -1);
+
+  /* other types, by numops of v1 */
+  jump_here(jb, ffails[0]);
+  jump_here(jb, ffails[1]);
+  for (int k = 0; k < ndfails; k++)
+    jump_here(jb, dfails[k]);
+  if (dst != DST_STACK) {
+    push_slot(jb);
+    copy_value(jb, R15, 0, b2, d2);
+    push_slot(jb);
+    copy_value(jb, R15, 0, b1, d1);
+  }
+  spill_top(jb);
+  mov64(jb, RDI, R12);
+  emit_bytes(jb, 1, 0xbe);
+  emit4(jb, op);
+  call_helper(jb, do_number_op);
+  reload_top(jb);
+  if (dst >= 0) {
+    load64(jb, RAX, R15, 8);
+    store64(jb, R13, LOCVAR(dst) + 8, RAX);
+    pop_slots(jb, 1);
+  }
+
+  jump_here(jb, done[0]);
+  jump_here(jb, done[1]);
+}
+
+static void setcc(JitBuf *jb, int cc, int reg)
+{
+  emit_bytes(jb, 3, 0x0f, 0x90 | cc, 0xc0 | reg);
+}
+
+/*
+  Comparison of v1(top) and v2, the result(0 or 1) is in eax,
+  if 'jmp' is set, or else it replaces v2 in stack.
+ */
+static void emit_compare(JitBuf *jb, int op, int jmp)
+{
+  int ifails[2], ffails[2], done[2];
+  int b1 = R15, d1 = 0, b2 = R15, d2 = -VALUE_SIZE;
+  int cc;
+
+  guard_klass(jb, &Int_Klass, b1, d1, b2, d2, ifails);
+  load64(jb, RAX, b1, d1 + 8);
+  cmp64(jb, RAX, b2, d2 + 8);
+  switch (op) {
+    case OP_GT:  cc = CC_G;  break;
+    case OP_GE:  cc = CC_GE; break;
+    case OP_LT:  cc = CC_L;  break;
+    case OP_LE:  cc = CC_LE; break;
+    case OP_EQ:  cc = CC_E;  break;
+    default:     cc = CC_NE; break;
+  }
+  setcc(jb, cc, RAX);
+  done[0] = jump_forward(jb, -1);
+
+  jump_here(jb, ifails[0]);
+  jump_here(jb, ifails[1]);
+  guard_klass(jb, &Float_Klass, b1, d1, b2, d2, ffails);
+  if (op == OP_LT || op == OP_LE) {
+    /* a < b is b > a, false if unordered */
+    emit_mem(jb, 0xf2, 0, 0x0f10, 0, b2, d2 + 8);
+    emit_mem(jb, 0x66, 0, 0x0f2e, 0, b1, d1 + 8);
+    setcc(jb, op == OP_LT ? CC_A : CC_AE, RAX);
+  } else {
+    emit_mem(jb, 0xf2, 0, 0x0f10, 0, b1, d1 + 8);
+    emit_mem(jb, 0x66, 0, 0x0f2e, 0, b2, d2 + 8);
+    if (op == OP_GT || op == OP_GE) {
+      setcc(jb, op == OP_GT ? CC_A : CC_AE, RAX);
+    } else if (op == OP_EQ) {
+      setcc(jb, CC_E, RAX);
+      setcc(jb, CC_NP, RCX);
+      emit_bytes(jb, 2, 0x20, 0xc8);
+    } else {
+      setcc(jb, CC_NE, RAX);
+      setcc(jb, CC_P, RCX);
+      emit_bytes(jb, 2, 0x08, 0xc8);
+    }
+  }
+  done[1] = jump_forward(jb, -1);
+
+  /* other types, by numops of v1 */
+  jump_here(jb, ffails[0]);
+  jump_here(jb, ffails[1]);
+  spill_top(jb);
+  mov64(jb, RDI, R12);
+  emit_bytes(jb, 1, 0xbe);
+  emit4(jb, op);
+  call_helper(jb, do_number_op);
+  reload_top(jb);
+  if (jmp) {
+    load32(jb, RAX, R15, 8);
+    pop_slots(jb, 1);
+  }
+  int slow = jump_forward(jb, -1);
+
+  jump_here(jb, done[0]);
+  jump_here(jb, done[1]);
+  /* movzx eax, al */
+  emit_bytes(jb, 3, 0x0f, 0xb6, 0xc0);
+  if (jmp) {
+    pop_slots(jb, 2);
+  } else {
+    store32(jb, R15, -VALUE_SIZE + 8, RAX);
+    movimm64(jb, RAX, (uint64)&Bool_Klass);
+    store64(jb, R15, -VALUE_SIZE, RAX);
+    pop_slots(jb, 1);
+  }
+  jump_here(jb, slow);
+}
+
+static int emit_inst(JitBuf *jb, CodeObject *code, Instr *i, int index)
+{
+  Object *consts = code->kf.consts;
+  int op = i->op;
+  TValue val;
+
+  switch (op) {
+    case OP_LOADK: {
+      val = Tuple_Get(consts, i->arg);
+      push_slot(jb);
+      movimm64(jb, RAX, (uint64)val.klazz);
+      store64(jb, R15, 0, RAX);
+      movimm64(jb, RAX, (uint64)val.ival);
+      store64(jb, R15, 8, RAX);
+      break;
+    }
+    case OP_LOAD:
+    case OP_LOAD0: {
+      push_slot(jb);
+      copy_value(jb, R15, 0, R13, LOCVAR(op == OP_LOAD ? i->arg : 0));
+      break;
+    }
+    case OP_STORE: {
+      /* verified, only the value is stored, as store() does */
+      load64(jb, RAX, R15, 8);
+      store64(jb, R13, LOCVAR(i->arg) + 8, RAX);
+      pop_slots(jb, 1);
+      break;
+    }
+    case OP2_LOADK: {
+      val = Tuple_Get(consts, i->arg);
+      movimm64(jb, RAX, (uint64)val.ival);
+      store64(jb, R13, LOCVAR(i->argc) + 8, RAX);
+      break;
+    }
+    case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV:
+    case OP_ADD_II: case OP_ADD_FF: case OP_SUB_II: case OP_SUB_FF:
+    case OP_MUL_II: case OP_MUL_FF: {
+      emit_arith(jb, base_op(op), R15, 0, R15, -VALUE_SIZE, DST_STACK);
+      break;
+    }
+    case OP2_ADD: case OP2_SUB: case OP2_MUL: case OP2_DIV: {
+      emit_arith(jb, base_op(op), R13, LOCVAR(i->arg),
+                 R13, LOCVAR(i->argc), DST_PUSH);
+      break;
+    }
+    case OP3_ADD: case OP3_SUB: case OP3_MUL: case OP3_DIV: {
+      emit_arith(jb, base_op(op), R13, LOCVAR(i->arg & 0xffff),
+                 R13, LOCVAR((int)((uint32)i->arg >> 16)), i->argc);
+      break;
+    }
+    case OP_GT: case OP_GE: case OP_LT: case OP_LE: case OP_EQ: case OP_NEQ:
+    case OP_GT_II: case OP_GT_FF: case OP_GE_II: case OP_GE_FF:
+    case OP_LT_II: case OP_LT_FF: case OP_LE_II: case OP_LE_FF:
+    case OP_EQ_II: case OP_EQ_FF: case OP_NEQ_II: case OP_NEQ_FF: {
+      emit_compare(jb, base_op(op), 0);
+      break;
+    }
+    case OP_GT_JUMP_TRUE: case OP_GE_JUMP_TRUE: case OP_LT_JUMP_TRUE:
+    case OP_LE_JUMP_TRUE: case OP_EQ_JUMP_TRUE: case OP_NEQ_JUMP_TRUE: {
+      emit_compare(jb, base_op(op), 1);
+      emit_bytes(jb, 2, 0x85, 0xc0);
+      jump_to(jb, CC_NE, i->arg);
+      break;
+    }
+    case OP_GT_JUMP_FALSE: case OP_GE_JUMP_FALSE: case OP_LT_JUMP_FALSE:
+    case OP_LE_JUMP_FALSE: case OP_EQ_JUMP_FALSE: case OP_NEQ_JUMP_FALSE: {
+      emit_compare(jb, base_op(op), 1);
+      emit_bytes(jb, 2, 0x85, 0xc0);
+      jump_to(jb, CC_E, i->arg);
+      break;
+    }
+    case OP_MOD: case OP_NEG:
+    case OP_BAND: case OP_BOR: case OP_BXOR: case OP_BNOT:
+    case OP_LSHIFT: case OP_RSHIFT:
+    case OP_LAND: case OP_LOR: case OP_LNOT: {
+      spill_top(jb);
+      mov64(jb, RDI, R12);
+      emit_bytes(jb, 1, 0xbe);
+      emit4(jb, op);
+      call_helper(jb, do_number_op);
+      reload_top(jb);
+      break;
+    }
+    case OP_FOR_RANGE: {
+      /* verified, i and its bound are Int */
+      load64(jb, RAX, R13, LOCVAR(i->argc) + 8);
+      addimm(jb, RAX, 1);
+      store64(jb, R13, LOCVAR(i->argc) + 8, RAX);
+      cmp64(jb, RAX, R13, LOCVAR(i->argc + 1) + 8);
+      jump_to(jb, CC_L, i->arg);
+      break;
+    }
+    case OP_JUMP: {
+      jump_to(jb, -1, i->arg);
+      break;
+    }
+    case OP_JUMP_TRUE:
+    case OP_JUMP_FALSE: {
+      load32(jb, RAX, R15, 8);
+      pop_slots(jb, 1);
+      emit_bytes(jb, 2, 0x85, 0xc0);
+      jump_to(jb, op == OP_JUMP_TRUE ? CC_NE : CC_E, i->arg);
+      break;
+    }
+    case OP_LOADM:
+    case OP_NEW: {
+      spill_top(jb);
+      mov64(jb, RDI, R12);
+      movimm64(jb, RSI, (uint64)consts);
+      movimm64(jb, RDX, (uint64)i);
+      call_helper(jb, op == OP_LOADM ? (void *)do_loadm : (void *)jit_new);
+      reload_top(jb);
+      break;
+    }
+    case OP_GETM: {
+      call_stack_helper(jb, do_getm);
+      break;
+    }
+    case OP_GETFIELD:
+    case OP_SETFIELD:
+    case OP2_GETFIELD:
+    case OP2_SETFIELD: {
+      if (op == OP_GETFIELD || op == OP_SETFIELD) {
+        load64(jb, RCX, R15, 8);
+        pop_slots(jb, 1);
+      } else {
+        load64(jb, RCX, R13, LOCVAR(i->argc) + 8);
+      }
+      spill_top(jb);
+      mov64(jb, RDI, R12);
+      movimm64(jb, RSI, (uint64)consts);
+      movimm64(jb, RDX, (uint64)i);
+      if (op == OP_GETFIELD || op == OP2_GETFIELD)
+        call_helper(jb, do_getfield);
+      else
+        call_helper(jb, do_setfield);
+      reload_top(jb);
+      break;
+    }
+    case OP_NEWARRAY: {
+      spill_top(jb);
+      mov64(jb, RDI, R12);
+      emit_bytes(jb, 1, 0xbe);
+      emit4(jb, i->arg);
+      call_helper(jb, jit_new_array);
+      reload_top(jb);
+      break;
+    }
+    case OP_LOAD_SUBSCR: {
+      call_stack_helper(jb, jit_load_subscr);
+      break;
+    }
+    case OP_STORE_SUBSCR: {
+      call_stack_helper(jb, do_store_subscr);
+      break;
+    }
+    /* leave native codes, Routine_Run() goes on with the new frame */
+    case OP_CALL: {
+      spill_top(jb);
+      mov64(jb, RDI, RBX);
+      movimm64(jb, RSI, (uint64)i);
+      emit_bytes(jb, 1, 0xba);
+      emit4(jb, index + 1);
+      call_helper(jb, do_call);
+      jump_to(jb, -1, EPILOGUE(jb));
+      break;
+    }
+    case OP_TAILCALL: {
+      spill_top(jb);
+      mov64(jb, RDI, RBX);
+      movimm64(jb, RSI, (uint64)i);
+      call_helper(jb, do_tailcall);
+      jump_to(jb, -1, EPILOGUE(jb));
+      break;
+    }
+    case OP_RET: {
+      spill_top(jb);
+      mov64(jb, RDI, RBX);
+      call_helper(jb, do_return);
+      jump_to(jb, -1, EPILOGUE(jb));
+      break;
+    }
+    default: {
+      debug("jit: unsupported instruction '%s'", opcode_string(op));
+      return -1;
+    }
+  }
+  return 0;
+}
+
+static void jitbuf_fini(JitBuf *jb)
+{
+  free(jb->codes);
+  free(jb->offsets);
+  free(jb->fixups);
+}
+
+int Jit_Compile(CodeObject *code)
+{
+  assert(CODE_ISKFUNC(code));
+  if (code->kf.jit) return 0;
+  if (!KFunc_Verified(code)) {
+    code->kf.hotness = -1;
+    return -1;
+  }
+
+  int ninsts = code->kf.ninsts;
+  JitCode *jc = calloc(1, sizeof(JitCode));
+  jc->entries = malloc(ninsts * sizeof(void *));
+  JitBuf jb = {
+    .ninsts = ninsts,
+    .offsets = malloc((ninsts + 1) * sizeof(int)),
+  };
+
+  emit_prologue(&jb, jc);
+  for (int k = 0; k < ninsts; k++) {
+    jb.offsets[k] = jb.size;
+    if (emit_inst(&jb, code, code->kf.insts + k, k)) {
+      jitbuf_fini(&jb);
+      free(jc->entries);
+      free(jc);
+      code->kf.hotness = -1;
+      return -1;
+    }
+  }
+  emit_epilogue(&jb);
+
+  for (int k = 0; k < jb.nfixups; k++) {
+    struct fixup *fix = jb.fixups + k;
+    assert(fix->target >= 0 && fix->target <= ninsts);
+    uint32 rel = jb.offsets[fix->target] - (fix->pos + 4);
+    memcpy(jb.codes + fix->pos, &rel, 4);
+  }
+
+  long pagesize = sysconf(_SC_PAGESIZE);
+  jc->size = (jb.size + pagesize - 1) & ~(pagesize - 1);
+  jc->mem = mmap(NULL, jc->size, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (jc->mem == MAP_FAILED) {
+    error("jit: mmap %zu bytes failed", jc->size);
+    jitbuf_fini(&jb);
+    free(jc->entries);
+    free(jc);
+    code->kf.hotness = -1;
+    return -1;
+  }
+  memcpy(jc->mem, jb.codes, jb.size);
+  mprotect(jc->mem, jc->size, PROT_READ | PROT_EXEC);
+  for (int k = 0; k < ninsts; k++)
+    jc->entries[k] = (uint8 *)jc->mem + jb.offsets[k];
+  debug("jit: %d instructions into %d bytes", ninsts, jb.size);
+
+  jitbuf_fini(&jb);
+  code->kf.jit = jc;
+  return 0;
+}
+
+void Jit_Run(Frame *f)
+{
+  CodeObject *code = (CodeObject *)f->code;
+  JitCode *jc = code->kf.jit;
+  assert(jc);
+  rt_stack_ensure(f->rt, code->kf.maxstack + JIT_STACK_EXTRA);
+  ((void (*)(Frame *))jc->mem)(f);
+}
+
+void Jit_Free(CodeObject *code)
+{
+  JitCode *jc = code->kf.jit;
+  if (!jc) return;
+  munmap(jc->mem, jc->size);
+  free(jc->entries);
+  free(jc);
+  code->kf.jit = NULL;
+}
+
+#else
+
+int Jit_Compile(CodeObject *code)
+{
+  code->kf.hotness = -1;
+  return -1;
+}
+
+void Jit_Run(Frame *f)
+{
+  UNUSED_PARAMETER(f);
+  assert(0);
+}
+
+void Jit_Free(CodeObject *code)
+{
+  UNUSED_PARAMETER(code);
+}
+
+#endif /* KOALA_JIT */
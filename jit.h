@@ -0,0 +1,38 @@
+
+#ifndef _KOALA_JIT_H_
+#define _KOALA_JIT_H_
+
+#include "routine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Baseline template jit, x86-64 Linux only.
+  A verified function is compiled into native codes after it is called, or
+  jumps backward, JIT_THRESHOLD times. Every instruction is translated by
+  its machine code template, and complex ones call the helpers in routine.c.
+  A function with unsupported instructions is left to frame_loop().
+  The templates use the 16 bytes TValue layout, jit is off with KOALA_NANBOX.
+ */
+#if defined(__x86_64__) && defined(__linux__) && !defined(KOALA_NANBOX)
+#define KOALA_JIT 1
+#else
+#define KOALA_JIT 0
+#endif
+
+#define JIT_THRESHOLD 100
+
+/* calls and backward jumps before compiling, 0 means jit is off */
+extern int Jit_Threshold;
+
+void Jit_Enable(int threshold);
+int Jit_Compile(CodeObject *code);
+void Jit_Run(Frame *f);
+void Jit_Free(CodeObject *code);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _KOALA_JIT_H_ */
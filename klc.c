@@ -184,7 +184,7 @@ ConstItem *ConstItem_Float_New(float64 val)
 
 ConstItem *ConstItem_Bool_New(int val)
 {
-  ConstItem *item = ConstItem_New(CONST_INT);
+  ConstItem *item = ConstItem_New(CONST_BOOL);
   item->bval = val;
   return item;
 }
@@ -824,11 +824,13 @@ uint32 constitem_hash(void *k)
       break;
     }
     case CONST_FLOAT: {
-      hash = hash_uint32(ptr2int(item, uint32), 32);
+      uint64 bits;
+      memcpy(&bits, &item->fval, sizeof(bits));
+      hash = hash_uint32((uint32)(bits ^ (bits >> 32)), 32);
       break;
     }
     case CONST_BOOL: {
-      hash = hash_uint32(ptr2int(item, uint32), 32);
+      hash = hash_uint32((uint32)!!item->bval, 32);
       break;
     }
     case CONST_STRING: {
@@ -856,11 +858,12 @@ int constitem_equal(void *k1, void *k2)
       break;
     }
     case CONST_FLOAT: {
-      res = (item1->fval == item2->fval);
+      /* by bits as hashed, 0.0 and -0.0 are two consts */
+      res = !memcmp(&item1->fval, &item2->fval, sizeof(float64));
       break;
     }
     case CONST_BOOL: {
-      res = (item1 == item2);
+      res = (!item1->bval == !item2->bval);
       break;
     }
     case CONST_STRING: {
@@ -1730,7 +1733,9 @@ KImage *KImage_Read_File(char *path)
         assert(sz == map->size);
         for (int i = 0; i < map->size; i++) {
           item = Item_Copy(sizeof(ConstItem), items + i);
-          AtomTable_Append(image->table, ITEM_CONST, item, 1);
+          /* older images may have equal float and bool consts */
+          int unique = ConstItem_Get(image->table, item) < 0;
+          AtomTable_Append(image->table, ITEM_CONST, item, unique);
         }
         break;
       }
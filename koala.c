@@ -1,6 +1,10 @@
 
 #include "koala.h"
 #include "options.h"
+#include "jit.h"
+#include "profile.h"
+#include "stats.h"
+#include "gc.h"
 
 #define KOALA_START "\
 +------------------------+\
@@ -22,11 +26,36 @@ static int __run(struct options *options)
 
   Koala_Initialize();
 
+  /* jitted codes are not counted */
+  if (options->stats)
+    Stats_Enable(options->statsjson);
+  else if (options->jit)
+    Jit_Enable(JIT_THRESHOLD);
+
+  /* pause budget of a gc step in microseconds, -1 is unbounded */
+  if (options->gcpause)
+    GC_Set_Pause(options->gcpause);
+
+  /* heap limit in megabytes, the vm exits if it is full after a collection */
+  if (options->gcheap)
+    GC_Set_Limit((long)options->gcheap << 20);
+
+  /* a collection at every safepoint, to check the roots and barriers */
+  if (options->gcstress)
+    GC_Set_Stress(1);
+
+  /* threads of parallel marking, one per online cpu by default */
+  if (options->gcmarkers)
+    GC_Set_Markers(options->gcmarkers);
+
   char *path;
   Vector_ForEach(path, &options->klcvec) {
     Koala_Env_Append("koala.path", path);
   }
 
+  if (options->prof || options->proftop)
+    Profile_Start(options->profhz, options->prof, options->proftop);
+
   Koala_Run(input, "main", &options->args);
 
   Koala_Finalize();
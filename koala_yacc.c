@@ -0,0 +1,3648 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 2 "yacc/koala.y"
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parser.h"
+
+/*----------------------------------------------------------------------------*/
+
+#if 1
+#define YYERROR_VERBOSE 1
+static int yyerror(ParserState *ps, void *scanner, const char *errmsg)
+{
+  UNUSED_PARAMETER(ps);
+  UNUSED_PARAMETER(scanner);
+  fprintf(stderr, "%s\n", errmsg);
+  return 0;
+}
+#else
+#define yyerror(ps, scanner, errmsg) ((void)0)
+#endif
+
+#define ERRMSG "expected '%s' before '%s'"
+#define syntax_error(expected) \
+  yyerrok; PSError(ERRMSG, expected, ps->line.token)
+#define syntax_error_clear(msg) yyclearin; yyerrok; \
+  PSError("%s", msg)
+
+stmt_t *do_vardecls(ParserState *ps, Vector *ids, TypeDesc *desc, Vector *exprs,
+                    int bconst);
+stmt_t *do_assignments(ParserState *ps, Vector *left, Vector *right);
+TypeDesc *do_usrdef_type(ParserState *ps, char *id, char *type);
+TypeDesc *do_array_type(TypeDesc *base);
+expr_t *do_array_initializer(ParserState *ps, Vector *explist);
+
+
+#line 108 "koala_yacc.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "koala_yacc.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_TYPELESS_ASSIGN = 3,            /* TYPELESS_ASSIGN  */
+  YYSYMBOL_PLUS_ASSGIN = 4,                /* PLUS_ASSGIN  */
+  YYSYMBOL_MINUS_ASSIGN = 5,               /* MINUS_ASSIGN  */
+  YYSYMBOL_MULT_ASSIGN = 6,                /* MULT_ASSIGN  */
+  YYSYMBOL_DIV_ASSIGN = 7,                 /* DIV_ASSIGN  */
+  YYSYMBOL_MOD_ASSIGN = 8,                 /* MOD_ASSIGN  */
+  YYSYMBOL_AND_ASSIGN = 9,                 /* AND_ASSIGN  */
+  YYSYMBOL_OR_ASSIGN = 10,                 /* OR_ASSIGN  */
+  YYSYMBOL_XOR_ASSIGN = 11,                /* XOR_ASSIGN  */
+  YYSYMBOL_RSHIFT_ASSIGN = 12,             /* RSHIFT_ASSIGN  */
+  YYSYMBOL_LSHIFT_ASSIGN = 13,             /* LSHIFT_ASSIGN  */
+  YYSYMBOL_POWER = 14,                     /* POWER  */
+  YYSYMBOL_ELLIPSIS = 15,                  /* ELLIPSIS  */
+  YYSYMBOL_DOTDOTLESS = 16,                /* DOTDOTLESS  */
+  YYSYMBOL_BY = 17,                        /* BY  */
+  YYSYMBOL_EQ = 18,                        /* EQ  */
+  YYSYMBOL_NE = 19,                        /* NE  */
+  YYSYMBOL_GE = 20,                        /* GE  */
+  YYSYMBOL_LE = 21,                        /* LE  */
+  YYSYMBOL_AND = 22,                       /* AND  */
+  YYSYMBOL_OR = 23,                        /* OR  */
+  YYSYMBOL_NOT = 24,                       /* NOT  */
+  YYSYMBOL_LSHIFT = 25,                    /* LSHIFT  */
+  YYSYMBOL_RSHIFT = 26,                    /* RSHIFT  */
+  YYSYMBOL_IF = 27,                        /* IF  */
+  YYSYMBOL_ELSE = 28,                      /* ELSE  */
+  YYSYMBOL_WHILE = 29,                     /* WHILE  */
+  YYSYMBOL_DO = 30,                        /* DO  */
+  YYSYMBOL_FOR = 31,                       /* FOR  */
+  YYSYMBOL_IN = 32,                        /* IN  */
+  YYSYMBOL_SWITCH = 33,                    /* SWITCH  */
+  YYSYMBOL_CASE = 34,                      /* CASE  */
+  YYSYMBOL_BREAK = 35,                     /* BREAK  */
+  YYSYMBOL_FALLTHROUGH = 36,               /* FALLTHROUGH  */
+  YYSYMBOL_CONTINUE = 37,                  /* CONTINUE  */
+  YYSYMBOL_DEFAULT = 38,                   /* DEFAULT  */
+  YYSYMBOL_VAR = 39,                       /* VAR  */
+  YYSYMBOL_FUNC = 40,                      /* FUNC  */
+  YYSYMBOL_TOKEN_RETURN = 41,              /* TOKEN_RETURN  */
+  YYSYMBOL_CLASS = 42,                     /* CLASS  */
+  YYSYMBOL_TRAIT = 43,                     /* TRAIT  */
+  YYSYMBOL_EXTENDS = 44,                   /* EXTENDS  */
+  YYSYMBOL_WITH = 45,                      /* WITH  */
+  YYSYMBOL_CONST = 46,                     /* CONST  */
+  YYSYMBOL_PACKAGE = 47,                   /* PACKAGE  */
+  YYSYMBOL_IMPORT = 48,                    /* IMPORT  */
+  YYSYMBOL_AS = 49,                        /* AS  */
+  YYSYMBOL_GO = 50,                        /* GO  */
+  YYSYMBOL_DEFER = 51,                     /* DEFER  */
+  YYSYMBOL_NEWLINE = 52,                   /* NEWLINE  */
+  YYSYMBOL_TYPEALIAS = 53,                 /* TYPEALIAS  */
+  YYSYMBOL_SYSCALL = 54,                   /* SYSCALL  */
+  YYSYMBOL_CHAR = 55,                      /* CHAR  */
+  YYSYMBOL_BYTE = 56,                      /* BYTE  */
+  YYSYMBOL_INTEGER = 57,                   /* INTEGER  */
+  YYSYMBOL_FLOAT = 58,                     /* FLOAT  */
+  YYSYMBOL_BOOL = 59,                      /* BOOL  */
+  YYSYMBOL_STRING = 60,                    /* STRING  */
+  YYSYMBOL_ANY = 61,                       /* ANY  */
+  YYSYMBOL_SELF = 62,                      /* SELF  */
+  YYSYMBOL_SUPER = 63,                     /* SUPER  */
+  YYSYMBOL_TOKEN_NIL = 64,                 /* TOKEN_NIL  */
+  YYSYMBOL_TOKEN_TRUE = 65,                /* TOKEN_TRUE  */
+  YYSYMBOL_TOKEN_FALSE = 66,               /* TOKEN_FALSE  */
+  YYSYMBOL_TYPEOF = 67,                    /* TYPEOF  */
+  YYSYMBOL_BYTE_CONST = 68,                /* BYTE_CONST  */
+  YYSYMBOL_CHAR_CONST = 69,                /* CHAR_CONST  */
+  YYSYMBOL_INT_CONST = 70,                 /* INT_CONST  */
+  YYSYMBOL_HEX_CONST = 71,                 /* HEX_CONST  */
+  YYSYMBOL_OCT_CONST = 72,                 /* OCT_CONST  */
+  YYSYMBOL_FLOAT_CONST = 73,               /* FLOAT_CONST  */
+  YYSYMBOL_STRING_CONST = 74,              /* STRING_CONST  */
+  YYSYMBOL_ID = 75,                        /* ID  */
+  YYSYMBOL_76_ = 76,                       /* '.'  */
+  YYSYMBOL_77_ = 77,                       /* '['  */
+  YYSYMBOL_78_ = 78,                       /* ']'  */
+  YYSYMBOL_79_ = 79,                       /* ':'  */
+  YYSYMBOL_80_ = 80,                       /* '('  */
+  YYSYMBOL_81_ = 81,                       /* ')'  */
+  YYSYMBOL_82_ = 82,                       /* ','  */
+  YYSYMBOL_83_ = 83,                       /* ';'  */
+  YYSYMBOL_84_ = 84,                       /* '*'  */
+  YYSYMBOL_85_ = 85,                       /* '='  */
+  YYSYMBOL_86_ = 86,                       /* '{'  */
+  YYSYMBOL_87_ = 87,                       /* '}'  */
+  YYSYMBOL_88_ = 88,                       /* '+'  */
+  YYSYMBOL_89_ = 89,                       /* '-'  */
+  YYSYMBOL_90_ = 90,                       /* '~'  */
+  YYSYMBOL_91_ = 91,                       /* '/'  */
+  YYSYMBOL_92_ = 92,                       /* '%'  */
+  YYSYMBOL_93_ = 93,                       /* '<'  */
+  YYSYMBOL_94_ = 94,                       /* '>'  */
+  YYSYMBOL_95_ = 95,                       /* '&'  */
+  YYSYMBOL_96_ = 96,                       /* '^'  */
+  YYSYMBOL_97_ = 97,                       /* '|'  */
+  YYSYMBOL_YYACCEPT = 98,                  /* $accept  */
+  YYSYMBOL_Type = 99,                      /* Type  */
+  YYSYMBOL_ArrayType = 100,                /* ArrayType  */
+  YYSYMBOL_BaseType = 101,                 /* BaseType  */
+  YYSYMBOL_MapType = 102,                  /* MapType  */
+  YYSYMBOL_PrimitiveType = 103,            /* PrimitiveType  */
+  YYSYMBOL_UsrDefType = 104,               /* UsrDefType  */
+  YYSYMBOL_FunctionType = 105,             /* FunctionType  */
+  YYSYMBOL_ReturnTypeList = 106,           /* ReturnTypeList  */
+  YYSYMBOL_TypeList = 107,                 /* TypeList  */
+  YYSYMBOL_CompileUnit = 108,              /* CompileUnit  */
+  YYSYMBOL_Package = 109,                  /* Package  */
+  YYSYMBOL_Imports = 110,                  /* Imports  */
+  YYSYMBOL_Import = 111,                   /* Import  */
+  YYSYMBOL_ModuleStatements = 112,         /* ModuleStatements  */
+  YYSYMBOL_ModuleStatement = 113,          /* ModuleStatement  */
+  YYSYMBOL_ConstDeclaration = 114,         /* ConstDeclaration  */
+  YYSYMBOL_VariableDeclaration = 115,      /* VariableDeclaration  */
+  YYSYMBOL_IDList = 116,                   /* IDList  */
+  YYSYMBOL_FunctionDeclaration = 117,      /* FunctionDeclaration  */
+  YYSYMBOL_ParameterList = 118,            /* ParameterList  */
+  YYSYMBOL_TypeAliasDeclaration = 119,     /* TypeAliasDeclaration  */
+  YYSYMBOL_TypeDeclaration = 120,          /* TypeDeclaration  */
+  YYSYMBOL_ExtendsOrEmpty = 121,           /* ExtendsOrEmpty  */
+  YYSYMBOL_WithesOrEmpty = 122,            /* WithesOrEmpty  */
+  YYSYMBOL_Traits = 123,                   /* Traits  */
+  YYSYMBOL_MemberDeclarationsOrEmpty = 124, /* MemberDeclarationsOrEmpty  */
+  YYSYMBOL_MemberDeclarations = 125,       /* MemberDeclarations  */
+  YYSYMBOL_MemberDeclaration = 126,        /* MemberDeclaration  */
+  YYSYMBOL_TraitMemberDeclarationsOrEmpty = 127, /* TraitMemberDeclarationsOrEmpty  */
+  YYSYMBOL_TraitMemberDeclarations = 128,  /* TraitMemberDeclarations  */
+  YYSYMBOL_TraitMemberDeclaration = 129,   /* TraitMemberDeclaration  */
+  YYSYMBOL_FieldDeclaration = 130,         /* FieldDeclaration  */
+  YYSYMBOL_ProtoDeclaration = 131,         /* ProtoDeclaration  */
+  YYSYMBOL_Block = 132,                    /* Block  */
+  YYSYMBOL_LocalStatements = 133,          /* LocalStatements  */
+  YYSYMBOL_LocalStatement = 134,           /* LocalStatement  */
+  YYSYMBOL_IfStatement = 135,              /* IfStatement  */
+  YYSYMBOL_OrElseStatement = 136,          /* OrElseStatement  */
+  YYSYMBOL_WhileStatement = 137,           /* WhileStatement  */
+  YYSYMBOL_SwitchStatement = 138,          /* SwitchStatement  */
+  YYSYMBOL_CaseStatements = 139,           /* CaseStatements  */
+  YYSYMBOL_CaseStatement = 140,            /* CaseStatement  */
+  YYSYMBOL_ForStatement = 141,             /* ForStatement  */
+  YYSYMBOL_JumpStatement = 142,            /* JumpStatement  */
+  YYSYMBOL_ReturnStatement = 143,          /* ReturnStatement  */
+  YYSYMBOL_PrimaryExpr = 144,              /* PrimaryExpr  */
+  YYSYMBOL_Selector = 145,                 /* Selector  */
+  YYSYMBOL_Arguments = 146,                /* Arguments  */
+  YYSYMBOL_Index = 147,                    /* Index  */
+  YYSYMBOL_Slice = 148,                    /* Slice  */
+  YYSYMBOL_Atom = 149,                     /* Atom  */
+  YYSYMBOL_CONSTANT = 150,                 /* CONSTANT  */
+  YYSYMBOL_ArrayExpr = 151,                /* ArrayExpr  */
+  YYSYMBOL_DictExpr = 152,                 /* DictExpr  */
+  YYSYMBOL_KVList = 153,                   /* KVList  */
+  YYSYMBOL_AnonyFuncExpr = 154,            /* AnonyFuncExpr  */
+  YYSYMBOL_SysCallExpr = 155,              /* SysCallExpr  */
+  YYSYMBOL_UnaryExpr = 156,                /* UnaryExpr  */
+  YYSYMBOL_UnaryOp = 157,                  /* UnaryOp  */
+  YYSYMBOL_MultiplExpr = 158,              /* MultiplExpr  */
+  YYSYMBOL_AddExpr = 159,                  /* AddExpr  */
+  YYSYMBOL_ShiftExpr = 160,                /* ShiftExpr  */
+  YYSYMBOL_RelationExpr = 161,             /* RelationExpr  */
+  YYSYMBOL_EqualityExpr = 162,             /* EqualityExpr  */
+  YYSYMBOL_AndExpr = 163,                  /* AndExpr  */
+  YYSYMBOL_ExclOrExpr = 164,               /* ExclOrExpr  */
+  YYSYMBOL_InclOrExpr = 165,               /* InclOrExpr  */
+  YYSYMBOL_LogAndExpr = 166,               /* LogAndExpr  */
+  YYSYMBOL_Expr = 167,                     /* Expr  */
+  YYSYMBOL_ExprList = 168,                 /* ExprList  */
+  YYSYMBOL_Assignment = 169,               /* Assignment  */
+  YYSYMBOL_CompAssignOp = 170              /* CompAssignOp  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  6
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   1143
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  98
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  73
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  240
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  416
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   330
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,    92,    95,     2,
+      80,    81,    84,    88,    82,    89,    76,    91,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,    79,    83,
+      93,    85,    94,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,    77,     2,    78,    96,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    86,    97,    87,    90,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   214,   214,   215,   219,   223,   224,   225,   226,   230,
+     231,   235,   236,   237,   238,   239,   243,   244,   248,   249,
+     250,   251,   255,   259,   265,   269,   273,   282,   283,   287,
+     288,   289,   293,   294,   298,   299,   300,   301,   302,   303,
+     304,   308,   309,   313,   314,   315,   316,   317,   318,   319,
+     323,   327,   335,   336,   337,   341,   345,   352,   353,   354,
+     355,   359,   363,   367,   374,   378,   387,   390,   393,   396,
+     399,   407,   411,   415,   424,   427,   430,   433,   441,   446,
+     449,   453,   459,   462,   470,   471,   475,   479,   487,   488,
+     492,   496,   503,   506,   512,   513,   517,   521,   528,   531,
+     534,   540,   543,   546,   552,   555,   558,   561,   569,   570,
+     574,   578,   585,   586,   587,   588,   589,   590,   591,   592,
+     593,   594,   595,   597,   601,   623,   630,   633,   637,   646,
+     649,   657,   663,   667,   685,   688,   696,   699,   707,   710,
+     713,   716,   722,   723,   724,   725,   731,   734,   737,   740,
+     743,   749,   753,   754,   758,   762,   763,   764,   765,   769,
+     770,   771,   772,   773,   774,   775,   776,   777,   778,   782,
+     783,   784,   785,   786,   787,   788,   789,   790,   791,   795,
+     796,   800,   801,   805,   806,   810,   813,   816,   819,   822,
+     829,   835,   836,   840,   841,   842,   843,   847,   848,   849,
+     850,   851,   855,   856,   857,   861,   862,   863,   867,   868,
+     869,   870,   871,   875,   876,   877,   881,   882,   886,   887,
+     891,   892,   896,   897,   901,   902,   906,   910,   917,   918,
+     921,   925,   926,   927,   928,   929,   930,   931,   932,   933,
+     934
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "TYPELESS_ASSIGN",
+  "PLUS_ASSGIN", "MINUS_ASSIGN", "MULT_ASSIGN", "DIV_ASSIGN", "MOD_ASSIGN",
+  "AND_ASSIGN", "OR_ASSIGN", "XOR_ASSIGN", "RSHIFT_ASSIGN",
+  "LSHIFT_ASSIGN", "POWER", "ELLIPSIS", "DOTDOTLESS", "BY", "EQ", "NE",
+  "GE", "LE", "AND", "OR", "NOT", "LSHIFT", "RSHIFT", "IF", "ELSE",
+  "WHILE", "DO", "FOR", "IN", "SWITCH", "CASE", "BREAK", "FALLTHROUGH",
+  "CONTINUE", "DEFAULT", "VAR", "FUNC", "TOKEN_RETURN", "CLASS", "TRAIT",
+  "EXTENDS", "WITH", "CONST", "PACKAGE", "IMPORT", "AS", "GO", "DEFER",
+  "NEWLINE", "TYPEALIAS", "SYSCALL", "CHAR", "BYTE", "INTEGER", "FLOAT",
+  "BOOL", "STRING", "ANY", "SELF", "SUPER", "TOKEN_NIL", "TOKEN_TRUE",
+  "TOKEN_FALSE", "TYPEOF", "BYTE_CONST", "CHAR_CONST", "INT_CONST",
+  "HEX_CONST", "OCT_CONST", "FLOAT_CONST", "STRING_CONST", "ID", "'.'",
+  "'['", "']'", "':'", "'('", "')'", "','", "';'", "'*'", "'='", "'{'",
+  "'}'", "'+'", "'-'", "'~'", "'/'", "'%'", "'<'", "'>'", "'&'", "'^'",
+  "'|'", "$accept", "Type", "ArrayType", "BaseType", "MapType",
+  "PrimitiveType", "UsrDefType", "FunctionType", "ReturnTypeList",
+  "TypeList", "CompileUnit", "Package", "Imports", "Import",
+  "ModuleStatements", "ModuleStatement", "ConstDeclaration",
+  "VariableDeclaration", "IDList", "FunctionDeclaration", "ParameterList",
+  "TypeAliasDeclaration", "TypeDeclaration", "ExtendsOrEmpty",
+  "WithesOrEmpty", "Traits", "MemberDeclarationsOrEmpty",
+  "MemberDeclarations", "MemberDeclaration",
+  "TraitMemberDeclarationsOrEmpty", "TraitMemberDeclarations",
+  "TraitMemberDeclaration", "FieldDeclaration", "ProtoDeclaration",
+  "Block", "LocalStatements", "LocalStatement", "IfStatement",
+  "OrElseStatement", "WhileStatement", "SwitchStatement", "CaseStatements",
+  "CaseStatement", "ForStatement", "JumpStatement", "ReturnStatement",
+  "PrimaryExpr", "Selector", "Arguments", "Index", "Slice", "Atom",
+  "CONSTANT", "ArrayExpr", "DictExpr", "KVList", "AnonyFuncExpr",
+  "SysCallExpr", "UnaryExpr", "UnaryOp", "MultiplExpr", "AddExpr",
+  "ShiftExpr", "RelationExpr", "EqualityExpr", "AndExpr", "ExclOrExpr",
+  "InclOrExpr", "LogAndExpr", "Expr", "ExprList", "Assignment",
+  "CompAssignOp", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-191)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-227)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+      -7,    29,    52,   124,  -191,     8,  -191,  -191,    71,    78,
+     -14,    -5,    79,    13,   122,  -191,   124,  -191,    16,  -191,
+      10,    33,  -191,  -191,  -191,  -191,  -191,  -191,  -191,    80,
+    -191,   101,   183,   107,  -191,   969,  -191,    34,    22,   169,
+    -191,   243,  -191,   105,  -191,  -191,  -191,  -191,  -191,  -191,
+     145,  -191,  -191,  -191,  -191,  -191,   155,  1066,   223,   283,
+     234,  -191,  -191,  -191,  -191,  -191,  -191,   108,   249,   136,
+     249,   192,   276,   335,   279,  -191,  -191,  -191,    35,   284,
+    -191,    36,  1005,   260,   290,   291,   295,  -191,  -191,  -191,
+       9,   289,  -191,  -191,  -191,  -191,  -191,  -191,  -191,  -191,
+    -191,  -191,  -191,  -191,  -191,  -191,   625,   885,  -191,  -191,
+    -191,   125,  -191,  -191,  -191,  -191,  -191,  -191,  -191,   885,
+      -9,   206,   255,    56,   278,   281,   282,   280,   357,   359,
+     301,   387,  1066,   962,   224,   107,  -191,   138,  -191,  -191,
+     139,   249,  -191,   301,   439,  -191,  -191,  -191,  -191,  -191,
+    1037,  -191,   244,  -191,  -191,  1066,  1066,  -191,   111,   885,
+    -191,   307,   -37,   159,   128,   -10,   311,   677,   729,  -191,
+     107,  -191,  -191,  -191,   885,   885,   885,   885,   885,   885,
+     885,   885,   885,   885,   885,   885,   885,   885,   885,   885,
+     885,   885,   885,   885,  -191,   301,  -191,  1066,   506,  -191,
+     305,  -191,   962,   312,  -191,   975,  -191,   303,   138,  -191,
+    -191,   129,  -191,   306,   139,  -191,  -191,  -191,  -191,  -191,
+     301,  -191,  1037,   921,   314,   316,   962,   246,   248,  -191,
+    -191,   885,   885,  -191,  -191,  -191,   781,   157,  -191,   250,
+    -191,  -191,  -191,  -191,  -191,    -9,    -9,   206,   206,   255,
+     255,   255,   255,    56,    56,   278,   281,   282,   280,   357,
+     359,   252,   885,   885,   305,   320,   333,   -23,   -20,   199,
+    -191,  -191,    38,  -191,   573,  -191,  -191,  -191,  -191,  -191,
+    -191,  -191,   304,    26,    30,  -191,  -191,   305,  -191,   926,
+     885,   113,  -191,  -191,   334,  -191,  -191,  -191,  -191,  -191,
+    -191,  -191,   305,  -191,   962,  -191,   161,   359,  -191,   167,
+    -191,   833,  -191,  -191,   109,   109,   367,   384,   885,   336,
+    -191,   337,  -191,  -191,  -191,    31,  -191,  -191,  -191,  -191,
+    -191,  -191,  -191,  -191,  -191,  -191,  -191,  -191,  -191,  -191,
+     885,  -191,  -191,   885,   885,  -191,  -191,  -191,     2,  -191,
+     885,  1030,  -191,   305,  -191,   885,  -191,  -191,   168,   389,
+    -191,   885,   885,   151,  -191,  -191,  -191,  -191,    15,   135,
+     256,  -191,   120,  1043,   931,   259,  -191,   359,  -191,   148,
+    -191,   146,    28,   332,  -191,  -191,  -191,  -191,  -191,   207,
+     998,  -191,  -191,  -191,   885,   885,   178,  -191,  -191,   338,
+     109,   109,   885,   343,   190,  -191,  -191,  -191,  -191,   162,
+     305,  -191,  -191,   305,  -191,  -191
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       0,     0,     0,     0,    31,     0,     1,    51,     0,     0,
+       0,     0,     0,     0,     0,    43,     0,    32,     0,    41,
+       0,     0,    46,    48,    47,    30,    29,    63,    64,     0,
+      70,     0,    82,    84,    56,     0,    40,     0,     0,     0,
+      77,     0,    33,     0,    42,    50,    45,    49,    44,    60,
+       0,    11,    12,    13,    14,    15,    16,     0,     0,     0,
+      57,     3,     2,     8,     5,     6,     7,     0,     0,     0,
+       0,     0,    85,     0,     0,    37,    34,    39,     0,     0,
+      76,     0,     0,     0,     0,     5,     6,    65,    61,   196,
+       0,     0,   160,   161,   176,   177,   178,   162,   170,   169,
+     171,   172,   173,   174,   175,   163,     0,     0,   193,   194,
+     195,   191,   146,   159,   165,   166,   167,   168,   197,     0,
+     202,   205,   208,   213,   216,   218,   220,   222,   224,   226,
+      58,     0,     0,     0,     0,    84,    80,    88,    86,    81,
+      94,     0,    54,    52,     0,    38,    35,    36,    75,    74,
+      21,    24,     0,    17,     4,     0,     0,   189,     0,     0,
+     180,     0,     0,   226,     0,     0,     0,     0,     0,   147,
+      84,   149,   150,   192,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,    62,    59,    71,     0,     0,    22,
+       0,    69,     0,     0,    83,     0,    93,     0,    89,    90,
+      92,     0,   100,     0,    95,    96,    98,    99,    87,    55,
+      53,    20,    19,     0,     0,     0,     0,     0,     0,   182,
+     181,     0,     0,   179,   164,   151,     0,     0,   152,     0,
+     148,   201,   198,   199,   200,   203,   204,   206,   207,   212,
+     211,   209,   210,   214,   215,   217,   219,   221,   223,   225,
+     227,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+     112,   109,     0,   122,     0,   110,   116,   117,   118,   119,
+     120,   121,   191,     0,     0,   115,    68,     0,    67,     0,
+       0,     0,    78,    91,     0,    79,    97,    18,    26,    25,
+       9,    10,     0,   188,     0,   190,     0,   183,   158,     0,
+     154,     0,   153,    23,     0,     0,     0,     0,     0,     0,
+     138,     0,   140,   144,   142,     0,   124,   114,   108,   111,
+     231,   232,   233,   234,   235,   236,   237,   238,   239,   240,
+       0,   123,   113,     0,     0,    66,    73,    72,     0,   101,
+       0,     0,   187,     0,   186,     0,   156,   157,     0,   126,
+     129,     0,     0,     0,   139,   141,   145,   143,     0,     0,
+       0,   102,     0,    16,     0,     0,   185,   184,   155,     0,
+     125,     0,     0,     0,   230,   229,   228,   103,   107,     0,
+       0,   127,   128,   130,     0,     0,     0,   106,   105,     0,
+       0,     0,     0,     0,     0,   132,   104,   137,   136,     0,
+       0,   131,   133,     0,   135,   134
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -191,   -29,  -191,  -191,  -191,   369,   -49,  -191,  -148,  -190,
+    -191,  -191,  -191,   412,   413,    24,  -191,  -174,   418,   -72,
+     273,  -191,  -191,  -191,  -104,  -191,  -191,  -191,   225,  -191,
+    -191,   218,   -83,  -191,  -180,  -191,   160,    57,  -191,  -191,
+    -191,  -191,    39,  -191,  -191,  -191,  -172,  -191,  -191,  -191,
+    -191,  -191,  -191,  -191,  -191,  -191,  -191,  -191,    74,  -191,
+     164,   181,    72,   179,   247,   253,   254,   257,   245,  -103,
+     -58,  -191,  -191
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int16 yydefgoto[] =
+{
+       0,   199,    61,    62,    63,    64,    65,    66,   200,   152,
+       2,     3,    16,    17,    18,    19,    20,    21,    29,    22,
+     134,    23,    24,    69,    71,    72,   207,   208,   209,   213,
+     214,   215,   210,   217,   201,   274,   275,   276,   380,   277,
+     278,   404,   405,   279,   280,   281,   111,   169,   170,   171,
+     172,   112,   113,   114,   115,   162,   116,   117,   118,   119,
+     120,   121,   122,   123,   124,   125,   126,   127,   128,   129,
+     284,   285,   340
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      60,   130,   221,   163,   165,   174,    74,   261,    86,    25,
+     157,    45,    81,   192,    36,   143,   -28,     7,   273,   135,
+     286,   138,   288,    77,   272,   192,   282,   341,    84,  -226,
+       4,   204,   366,   343,    47,    75,   145,   148,   192,   326,
+       1,   230,    44,   394,   395,   231,   303,   319,   164,   192,
+     321,   192,     6,   151,   287,     8,     9,   216,    10,    11,
+     320,    32,    12,   322,   237,   206,   240,    44,   212,    14,
+      33,   234,    27,   195,   297,   175,   182,   183,   302,    30,
+      34,    49,   176,   177,   316,   371,   220,    37,    38,   158,
+     260,    26,   218,    46,   273,   283,    78,    39,   384,    15,
+     272,   228,   282,   196,     5,   -27,     7,   345,  -226,   342,
+     239,  -226,   193,   193,   367,   344,    48,    76,   146,   149,
+      50,   327,   352,    40,   354,     7,   224,   225,   306,   307,
+      30,   216,   192,   309,   359,   360,   206,    51,    52,    53,
+      54,    55,   212,   192,     8,     9,    28,    10,    11,   184,
+     185,    12,    70,    31,    28,    56,   353,    57,    14,   314,
+     315,   375,    58,     8,     9,    59,    10,    11,   151,   192,
+      12,   283,    13,   376,   192,   262,   291,    14,     9,   211,
+     192,    67,   192,   132,   192,   192,   132,   348,    15,   133,
+     192,   192,   226,   173,   299,   198,   349,    41,   350,   391,
+     323,   166,   167,   387,   294,   168,   233,    15,   358,   286,
+     193,   325,   402,   205,   205,   363,   403,   193,   385,   136,
+     407,   408,   137,    89,   402,    82,   389,    68,   403,   393,
+     414,    83,   383,   415,   198,   310,   311,   368,   232,    90,
+     355,   413,   399,    79,    80,   356,   378,   372,   241,   242,
+     243,   244,   377,    91,   249,   250,   251,   252,   381,   382,
+     347,    92,    93,    94,    95,    96,    97,    98,    99,   100,
+     101,   102,   103,   104,   105,   139,   106,   411,   140,   107,
+     180,   181,   324,    50,    88,   369,   370,   108,   109,   110,
+     397,   400,   401,   198,   178,   179,   186,   187,    87,   409,
+      51,    52,    53,    54,    55,   202,   203,    89,   330,   331,
+     332,   333,   334,   335,   336,   337,   338,   339,    56,   131,
+      57,   141,   151,    90,    56,   222,   223,   304,   203,   305,
+     193,   312,   193,   313,   223,   153,   142,    91,   193,   386,
+     390,   223,   245,   246,   196,    92,    93,    94,    95,    96,
+      97,    98,    99,   100,   101,   102,   103,   104,   105,    89,
+     106,   247,   248,   107,   144,   253,   254,   147,   154,   159,
+     155,   108,   109,   110,   156,    90,   188,   190,   189,   191,
+     166,   167,   192,   193,   168,   229,   235,   289,   194,    91,
+     292,   198,   300,   295,   301,   317,   361,    92,    93,    94,
+      95,    96,    97,    98,    99,   100,   101,   102,   103,   104,
+     105,    89,   106,   318,   351,   107,   362,   379,   396,   364,
+     365,   406,   410,   108,   109,   110,    85,    90,    42,    43,
+      35,   227,   296,   293,   329,   255,   392,   259,     0,     0,
+     219,    91,   256,   412,   257,     0,     0,     0,   258,    92,
+      93,    94,    95,    96,    97,    98,    99,   100,   101,   102,
+     103,   104,   105,    89,   106,     0,     0,   107,     0,     0,
+       0,     0,     0,     0,     0,   108,   109,   110,     0,    90,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    91,     0,     0,     0,     0,     0,     0,
+       0,    92,    93,    94,    95,    96,    97,    98,    99,   100,
+     101,   102,   103,   104,   105,     0,   106,     0,     0,   107,
+       0,     0,     0,     0,     0,     0,     0,   108,   109,   110,
+      89,     0,     0,   262,     0,   263,   264,   265,     0,   266,
+       0,   267,     0,   268,     0,     8,    90,   269,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      91,     0,     0,     0,     0,     0,     0,     0,    92,    93,
+      94,    95,    96,    97,    98,    99,   100,   101,   102,   103,
+     104,   105,     0,   106,     0,     0,   107,     0,     0,   270,
+       0,     0,   198,   271,   108,   109,   110,    89,     0,     0,
+     262,     0,   263,   264,   265,     0,   266,     0,   267,     0,
+     268,     0,     8,    90,   269,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    91,     0,     0,
+       0,     0,     0,     0,     0,    92,    93,    94,    95,    96,
+      97,    98,    99,   100,   101,   102,   103,   104,   105,    89,
+     106,     0,     0,   107,     0,     0,   270,     0,     0,   198,
+     328,   108,   109,   110,     0,    90,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    91,
+       0,     0,     0,     0,     0,     0,     0,    92,    93,    94,
+      95,    96,    97,    98,    99,   100,   101,   102,   103,   104,
+     105,    89,   106,   160,   161,   107,     0,     0,     0,     0,
+       0,     0,     0,   108,   109,   110,     0,    90,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    91,     0,     0,     0,     0,     0,     0,     0,    92,
+      93,    94,    95,    96,    97,    98,    99,   100,   101,   102,
+     103,   104,   105,    89,   106,     0,   236,   107,     0,     0,
+       0,     0,     0,     0,     0,   108,   109,   110,     0,    90,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    91,     0,     0,     0,     0,     0,     0,
+       0,    92,    93,    94,    95,    96,    97,    98,    99,   100,
+     101,   102,   103,   104,   105,    89,   106,     0,     0,   107,
+     238,     0,     0,     0,     0,     0,     0,   108,   109,   110,
+       0,    90,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    91,     0,     0,     0,     0,
+       0,     0,     0,    92,    93,    94,    95,    96,    97,    98,
+      99,   100,   101,   102,   103,   104,   105,    89,   106,   308,
+       0,   107,     0,     0,     0,     0,     0,     0,     0,   108,
+     109,   110,     0,    90,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    91,     0,     0,
+       0,     0,     0,     0,     0,    92,    93,    94,    95,    96,
+      97,    98,    99,   100,   101,   102,   103,   104,   105,    89,
+     106,   357,     0,   107,     0,     0,     0,     0,     0,     0,
+       0,   108,   109,   110,     0,    90,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,   298,     0,     0,    91,
+       0,   346,     0,     0,     0,     0,     0,    92,    93,    94,
+      95,    96,    97,    98,    99,   100,   101,   102,   103,   104,
+     105,    50,   106,     0,     0,   107,    50,     0,     0,     0,
+       0,    50,     0,   108,   109,   110,     0,     0,    51,    52,
+      53,    54,    55,    51,    52,    53,    54,    55,    51,    52,
+      53,    54,    55,     0,     0,     0,    56,     0,    57,     0,
+       0,    56,    50,    57,     0,     0,    56,     0,    57,    50,
+       0,   197,     0,     0,   388,    50,     0,   198,     0,    51,
+      52,    53,    54,    55,     0,     0,    51,    52,    53,    54,
+      55,     0,    51,    52,    53,    54,    55,    56,    50,    57,
+       0,     0,   197,     0,    56,    50,    57,     0,   198,     0,
+      56,    58,    57,     0,    73,    51,    52,    53,    54,    55,
+     290,     0,    51,    52,    53,    54,    55,     0,     0,     0,
+      50,     0,     0,    56,     0,    57,     0,    50,   197,     0,
+      56,   398,    57,    50,     0,     0,   150,    51,    52,    53,
+      54,    55,     0,     0,    51,    52,    53,    54,    55,     0,
+      51,    52,    53,    54,    55,   373,    50,    57,     0,     0,
+       0,   374,    56,     0,    57,     0,     0,   197,    56,    83,
+      57,     0,     0,    51,    52,    53,    54,    55,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    56,     0,    57
+};
+
+static const yytype_int16 yycheck[] =
+{
+      29,    59,   150,   106,   107,    14,    35,   197,    57,     1,
+       1,     1,    41,    23,     1,    73,     0,     1,   198,    68,
+     200,    70,   202,     1,   198,    23,   198,     1,    57,     3,
+       1,   135,     1,     3,     1,     1,     1,     1,    23,     1,
+      47,    78,    18,    15,    16,    82,   226,    70,   106,    23,
+      70,    23,     0,    82,   202,    39,    40,   140,    42,    43,
+      83,    75,    46,    83,   167,   137,   170,    43,   140,    53,
+      75,    81,     1,   131,   222,    84,    20,    21,   226,     1,
+       1,     1,    91,    92,   264,    83,   144,    74,    75,    80,
+     193,    83,   141,    83,   274,   198,    74,    84,    83,    83,
+     274,   159,   274,   132,    75,     0,     1,   287,    82,    83,
+     168,    85,    82,    82,    83,    85,    83,    83,    83,    83,
+      40,    83,   302,     1,   304,     1,   155,   156,   231,   232,
+       1,   214,    23,   236,   314,   315,   208,    57,    58,    59,
+      60,    61,   214,    23,    39,    40,    75,    42,    43,    93,
+      94,    46,    45,    75,    75,    75,   304,    77,    53,   262,
+     263,   351,    82,    39,    40,    85,    42,    43,   197,    23,
+      46,   274,    48,   353,    23,    27,   205,    53,    40,    40,
+      23,    80,    23,    75,    23,    23,    75,   290,    83,    81,
+      23,    23,    81,   119,   223,    86,    83,    75,    85,   379,
+       1,    76,    77,    83,    75,    80,    78,    83,   311,   389,
+      82,   269,    34,    75,    75,   318,    38,    82,    83,    83,
+     400,   401,    86,    24,    34,    80,   374,    44,    38,    83,
+     410,    76,    81,   413,    86,    78,    79,   340,    79,    40,
+      79,    79,   390,    74,     1,    78,    78,   350,   174,   175,
+     176,   177,   355,    54,   182,   183,   184,   185,   361,   362,
+     289,    62,    63,    64,    65,    66,    67,    68,    69,    70,
+      71,    72,    73,    74,    75,    83,    77,    87,    86,    80,
+      25,    26,    83,    40,     1,   343,   344,    88,    89,    90,
+      83,   394,   395,    86,    88,    89,    18,    19,    75,   402,
+      57,    58,    59,    60,    61,    81,    82,    24,     4,     5,
+       6,     7,     8,     9,    10,    11,    12,    13,    75,    85,
+      77,    45,   351,    40,    75,    81,    82,    81,    82,    81,
+      82,    81,    82,    81,    82,    75,     1,    54,    82,    83,
+      81,    82,   178,   179,   373,    62,    63,    64,    65,    66,
+      67,    68,    69,    70,    71,    72,    73,    74,    75,    24,
+      77,   180,   181,    80,    85,   186,   187,    83,    78,    80,
+      79,    88,    89,    90,    79,    40,    95,    97,    96,    22,
+      76,    77,    23,    82,    80,    78,    75,    75,     1,    54,
+      87,    86,    78,    87,    78,    75,    29,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    24,    77,    80,    80,    80,    32,    28,    86,    83,
+      83,    83,    79,    88,    89,    90,    57,    40,    16,    16,
+      12,   158,   214,   208,   274,   188,   379,   192,    -1,    -1,
+       1,    54,   189,   404,   190,    -1,    -1,    -1,   191,    62,
+      63,    64,    65,    66,    67,    68,    69,    70,    71,    72,
+      73,    74,    75,    24,    77,    -1,    -1,    80,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    88,    89,    90,    -1,    40,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    54,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    62,    63,    64,    65,    66,    67,    68,    69,    70,
+      71,    72,    73,    74,    75,    -1,    77,    -1,    -1,    80,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    88,    89,    90,
+      24,    -1,    -1,    27,    -1,    29,    30,    31,    -1,    33,
+      -1,    35,    -1,    37,    -1,    39,    40,    41,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      54,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    62,    63,
+      64,    65,    66,    67,    68,    69,    70,    71,    72,    73,
+      74,    75,    -1,    77,    -1,    -1,    80,    -1,    -1,    83,
+      -1,    -1,    86,    87,    88,    89,    90,    24,    -1,    -1,
+      27,    -1,    29,    30,    31,    -1,    33,    -1,    35,    -1,
+      37,    -1,    39,    40,    41,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    54,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    62,    63,    64,    65,    66,
+      67,    68,    69,    70,    71,    72,    73,    74,    75,    24,
+      77,    -1,    -1,    80,    -1,    -1,    83,    -1,    -1,    86,
+      87,    88,    89,    90,    -1,    40,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    54,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    24,    77,    78,    79,    80,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    88,    89,    90,    -1,    40,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    54,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    62,
+      63,    64,    65,    66,    67,    68,    69,    70,    71,    72,
+      73,    74,    75,    24,    77,    -1,    79,    80,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    88,    89,    90,    -1,    40,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    54,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    62,    63,    64,    65,    66,    67,    68,    69,    70,
+      71,    72,    73,    74,    75,    24,    77,    -1,    -1,    80,
+      81,    -1,    -1,    -1,    -1,    -1,    -1,    88,    89,    90,
+      -1,    40,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    54,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    62,    63,    64,    65,    66,    67,    68,
+      69,    70,    71,    72,    73,    74,    75,    24,    77,    78,
+      -1,    80,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    88,
+      89,    90,    -1,    40,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    54,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    62,    63,    64,    65,    66,
+      67,    68,    69,    70,    71,    72,    73,    74,    75,    24,
+      77,    78,    -1,    80,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    88,    89,    90,    -1,    40,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    15,    -1,    -1,    54,
+      -1,    15,    -1,    -1,    -1,    -1,    -1,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    40,    77,    -1,    -1,    80,    40,    -1,    -1,    -1,
+      -1,    40,    -1,    88,    89,    90,    -1,    -1,    57,    58,
+      59,    60,    61,    57,    58,    59,    60,    61,    57,    58,
+      59,    60,    61,    -1,    -1,    -1,    75,    -1,    77,    -1,
+      -1,    75,    40,    77,    -1,    -1,    75,    -1,    77,    40,
+      -1,    80,    -1,    -1,    83,    40,    -1,    86,    -1,    57,
+      58,    59,    60,    61,    -1,    -1,    57,    58,    59,    60,
+      61,    -1,    57,    58,    59,    60,    61,    75,    40,    77,
+      -1,    -1,    80,    -1,    75,    40,    77,    -1,    86,    -1,
+      75,    82,    77,    -1,    85,    57,    58,    59,    60,    61,
+      85,    -1,    57,    58,    59,    60,    61,    -1,    -1,    -1,
+      40,    -1,    -1,    75,    -1,    77,    -1,    40,    80,    -1,
+      75,    83,    77,    40,    -1,    -1,    81,    57,    58,    59,
+      60,    61,    -1,    -1,    57,    58,    59,    60,    61,    -1,
+      57,    58,    59,    60,    61,    75,    40,    77,    -1,    -1,
+      -1,    81,    75,    -1,    77,    -1,    -1,    80,    75,    76,
+      77,    -1,    -1,    57,    58,    59,    60,    61,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    75,    -1,    77
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_uint8 yystos[] =
+{
+       0,    47,   108,   109,     1,    75,     0,     1,    39,    40,
+      42,    43,    46,    48,    53,    83,   110,   111,   112,   113,
+     114,   115,   117,   119,   120,     1,    83,     1,    75,   116,
+       1,    75,    75,    75,     1,   116,     1,    74,    75,    84,
+       1,    75,   111,   112,   113,     1,    83,     1,    83,     1,
+      40,    57,    58,    59,    60,    61,    75,    77,    82,    85,
+      99,   100,   101,   102,   103,   104,   105,    80,    44,   121,
+      45,   122,   123,    85,    99,     1,    83,     1,    74,    74,
+       1,    99,    80,    76,    99,   103,   104,    75,     1,    24,
+      40,    54,    62,    63,    64,    65,    66,    67,    68,    69,
+      70,    71,    72,    73,    74,    75,    77,    80,    88,    89,
+      90,   144,   149,   150,   151,   152,   154,   155,   156,   157,
+     158,   159,   160,   161,   162,   163,   164,   165,   166,   167,
+     168,    85,    75,    81,   118,   104,    83,    86,   104,    83,
+      86,    45,     1,   168,    85,     1,    83,    83,     1,    83,
+      81,    99,   107,    75,    78,    79,    79,     1,    80,    80,
+      78,    79,   153,   167,   168,   167,    76,    77,    80,   145,
+     146,   147,   148,   156,    14,    84,    91,    92,    88,    89,
+      25,    26,    20,    21,    93,    94,    18,    19,    95,    96,
+      97,    22,    23,    82,     1,   168,    99,    80,    86,    99,
+     106,   132,    81,    82,   122,    75,   117,   124,   125,   126,
+     130,    40,   117,   127,   128,   129,   130,   131,   104,     1,
+     168,   106,    81,    82,    99,    99,    81,   118,   168,    78,
+      78,    82,    79,    78,    81,    75,    79,   167,    81,   168,
+     122,   156,   156,   156,   156,   158,   158,   159,   159,   160,
+     160,   160,   160,   161,   161,   162,   163,   164,   165,   166,
+     167,   107,    27,    29,    30,    31,    33,    35,    37,    41,
+      83,    87,   115,   132,   133,   134,   135,   137,   138,   141,
+     142,   143,   144,   167,   168,   169,   132,   106,   132,    75,
+      85,    99,    87,   126,    75,    87,   129,   106,    15,    99,
+      78,    78,   106,   132,    81,    81,   167,   167,    78,   167,
+      78,    79,    81,    81,   167,   167,   132,    75,    80,    70,
+      83,    70,    83,     1,    83,   168,     1,    83,    87,   134,
+       4,     5,     6,     7,     8,     9,    10,    11,    12,    13,
+     170,     1,    83,     3,    85,   132,    15,    99,   167,    83,
+      85,    80,   132,   106,   132,    79,    78,    78,   167,   132,
+     132,    29,    32,   167,    83,    83,     1,    83,   167,   168,
+     168,    83,   167,    75,    81,   107,   132,   167,    78,    28,
+     136,   167,   167,    81,    83,    83,    83,    83,    83,   106,
+      81,   132,   135,    83,    15,    16,    86,    83,    83,   106,
+     167,   167,    34,    38,   139,   140,    83,   132,   132,   167,
+      79,    87,   140,    79,   132,   132
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_uint8 yyr1[] =
+{
+       0,    98,    99,    99,   100,   101,   101,   101,   101,   102,
+     102,   103,   103,   103,   103,   103,   104,   104,   105,   105,
+     105,   105,   106,   106,   107,   107,   107,   108,   108,   109,
+     109,   109,   110,   110,   111,   111,   111,   111,   111,   111,
+     111,   112,   112,   113,   113,   113,   113,   113,   113,   113,
+     113,   113,   114,   114,   114,   114,   114,   115,   115,   115,
+     115,   115,   115,   115,   116,   116,   117,   117,   117,   117,
+     117,   118,   118,   118,   119,   119,   119,   119,   120,   120,
+     120,   120,   121,   121,   122,   122,   123,   123,   124,   124,
+     125,   125,   126,   126,   127,   127,   128,   128,   129,   129,
+     129,   130,   130,   130,   131,   131,   131,   131,   132,   132,
+     133,   133,   134,   134,   134,   134,   134,   134,   134,   134,
+     134,   134,   134,   134,   134,   135,   136,   136,   136,   137,
+     137,   138,   139,   139,   140,   140,   141,   141,   142,   142,
+     142,   142,   143,   143,   143,   143,   144,   144,   144,   144,
+     144,   145,   146,   146,   147,   148,   148,   148,   148,   149,
+     149,   149,   149,   149,   149,   149,   149,   149,   149,   150,
+     150,   150,   150,   150,   150,   150,   150,   150,   150,   151,
+     151,   152,   152,   153,   153,   154,   154,   154,   154,   154,
+     155,   156,   156,   157,   157,   157,   157,   158,   158,   158,
+     158,   158,   159,   159,   159,   160,   160,   160,   161,   161,
+     161,   161,   161,   162,   162,   162,   163,   163,   164,   164,
+     165,   165,   166,   166,   167,   167,   168,   168,   169,   169,
+     169,   170,   170,   170,   170,   170,   170,   170,   170,   170,
+     170
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     1,     3,     1,     1,     1,     1,     5,
+       5,     1,     1,     1,     1,     1,     1,     3,     5,     4,
+       4,     3,     1,     3,     1,     3,     3,     3,     2,     3,
+       3,     2,     1,     2,     3,     4,     4,     3,     4,     3,
+       2,     1,     2,     1,     2,     2,     1,     1,     1,     2,
+       2,     1,     4,     5,     4,     5,     2,     3,     4,     5,
+       3,     4,     5,     2,     1,     3,     7,     6,     6,     5,
+       2,     2,     4,     4,     4,     4,     3,     2,     6,     6,
+       4,     4,     0,     3,     0,     1,     2,     3,     0,     1,
+       1,     2,     1,     1,     0,     1,     1,     2,     1,     1,
+       1,     3,     4,     5,     7,     6,     6,     5,     3,     2,
+       1,     2,     1,     2,     2,     1,     1,     1,     1,     1,
+       1,     1,     1,     2,     2,     4,     0,     2,     2,     3,
+       5,     7,     1,     2,     4,     3,     7,     7,     2,     3,
+       2,     3,     2,     3,     2,     3,     1,     2,     3,     2,
+       2,     2,     2,     3,     3,     5,     4,     4,     3,     1,
+       1,     1,     1,     1,     3,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     3,
+       2,     3,     3,     3,     5,     6,     5,     5,     4,     2,
+       4,     1,     2,     1,     1,     1,     1,     1,     3,     3,
+       3,     3,     1,     3,     3,     1,     3,     3,     1,     3,
+       3,     3,     3,     1,     3,     3,     1,     3,     1,     3,
+       1,     3,     1,     3,     1,     3,     1,     3,     4,     4,
+       4,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (ps, scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, ps, scanner); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, ParserState *ps, void *scanner)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (ps);
+  YY_USE (scanner);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, ParserState *ps, void *scanner)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep, ps, scanner);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, ParserState *ps, void *scanner)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], ps, scanner);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, ps, scanner); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, ParserState *ps, void *scanner)
+{
+  YY_USE (yyvaluep);
+  YY_USE (ps);
+  YY_USE (scanner);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (ParserState *ps, void *scanner)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, scanner);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* Type: BaseType  */
+#line 214 "yacc/koala.y"
+              { (yyval.type) = (yyvsp[0].type); }
+#line 1737 "koala_yacc.c"
+    break;
+
+  case 3: /* Type: ArrayType  */
+#line 215 "yacc/koala.y"
+              { (yyval.type) = (yyvsp[0].type); }
+#line 1743 "koala_yacc.c"
+    break;
+
+  case 4: /* ArrayType: '[' Type ']'  */
+#line 219 "yacc/koala.y"
+                  { (yyval.type) = do_array_type((yyvsp[-1].type)); }
+#line 1749 "koala_yacc.c"
+    break;
+
+  case 5: /* BaseType: PrimitiveType  */
+#line 223 "yacc/koala.y"
+                  { (yyval.type) = (yyvsp[0].type); }
+#line 1755 "koala_yacc.c"
+    break;
+
+  case 6: /* BaseType: UsrDefType  */
+#line 224 "yacc/koala.y"
+                  { (yyval.type) = (yyvsp[0].type); }
+#line 1761 "koala_yacc.c"
+    break;
+
+  case 7: /* BaseType: FunctionType  */
+#line 225 "yacc/koala.y"
+                  { (yyval.type) = (yyvsp[0].type); }
+#line 1767 "koala_yacc.c"
+    break;
+
+  case 8: /* BaseType: MapType  */
+#line 226 "yacc/koala.y"
+                  { (yyval.type) = (yyvsp[0].type); }
+#line 1773 "koala_yacc.c"
+    break;
+
+  case 9: /* MapType: '[' PrimitiveType ':' Type ']'  */
+#line 230 "yacc/koala.y"
+                                   { Type_New_Map((yyvsp[-3].type), (yyvsp[-1].type)); }
+#line 1779 "koala_yacc.c"
+    break;
+
+  case 10: /* MapType: '[' UsrDefType ':' Type ']'  */
+#line 231 "yacc/koala.y"
+                                   { Type_New_Map((yyvsp[-3].type), (yyvsp[-1].type)); }
+#line 1785 "koala_yacc.c"
+    break;
+
+  case 11: /* PrimitiveType: INTEGER  */
+#line 235 "yacc/koala.y"
+            { (yyval.type) = &Int_Type;    }
+#line 1791 "koala_yacc.c"
+    break;
+
+  case 12: /* PrimitiveType: FLOAT  */
+#line 236 "yacc/koala.y"
+            { (yyval.type) = &Float_Type;  }
+#line 1797 "koala_yacc.c"
+    break;
+
+  case 13: /* PrimitiveType: BOOL  */
+#line 237 "yacc/koala.y"
+            { (yyval.type) = &Bool_Type;   }
+#line 1803 "koala_yacc.c"
+    break;
+
+  case 14: /* PrimitiveType: STRING  */
+#line 238 "yacc/koala.y"
+            { (yyval.type) = &String_Type; }
+#line 1809 "koala_yacc.c"
+    break;
+
+  case 15: /* PrimitiveType: ANY  */
+#line 239 "yacc/koala.y"
+            { (yyval.type) = &Any_Type;    }
+#line 1815 "koala_yacc.c"
+    break;
+
+  case 16: /* UsrDefType: ID  */
+#line 243 "yacc/koala.y"
+              { (yyval.type) = do_usrdef_type(ps, NULL, (yyvsp[0].id)); }
+#line 1821 "koala_yacc.c"
+    break;
+
+  case 17: /* UsrDefType: ID '.' ID  */
+#line 244 "yacc/koala.y"
+              { (yyval.type) = do_usrdef_type(ps, (yyvsp[-2].id), (yyvsp[0].id));   }
+#line 1827 "koala_yacc.c"
+    break;
+
+  case 18: /* FunctionType: FUNC '(' TypeList ')' ReturnTypeList  */
+#line 248 "yacc/koala.y"
+                                         { (yyval.type) = Type_New_Proto((yyvsp[-2].list), (yyvsp[0].list));     }
+#line 1833 "koala_yacc.c"
+    break;
+
+  case 19: /* FunctionType: FUNC '(' TypeList ')'  */
+#line 249 "yacc/koala.y"
+                                         { (yyval.type) = Type_New_Proto((yyvsp[-1].list), NULL);   }
+#line 1839 "koala_yacc.c"
+    break;
+
+  case 20: /* FunctionType: FUNC '(' ')' ReturnTypeList  */
+#line 250 "yacc/koala.y"
+                                         { (yyval.type) = Type_New_Proto(NULL, (yyvsp[0].list));   }
+#line 1845 "koala_yacc.c"
+    break;
+
+  case 21: /* FunctionType: FUNC '(' ')'  */
+#line 251 "yacc/koala.y"
+                                         { (yyval.type) = Type_New_Proto(NULL, NULL); }
+#line 1851 "koala_yacc.c"
+    break;
+
+  case 22: /* ReturnTypeList: Type  */
+#line 255 "yacc/koala.y"
+         {
+    (yyval.list) = Vector_New();
+    Vector_Append((yyval.list), (yyvsp[0].type));
+  }
+#line 1860 "koala_yacc.c"
+    break;
+
+  case 23: /* ReturnTypeList: '(' TypeList ')'  */
+#line 259 "yacc/koala.y"
+                     {
+    (yyval.list) = (yyvsp[-1].list);
+  }
+#line 1868 "koala_yacc.c"
+    break;
+
+  case 24: /* TypeList: Type  */
+#line 265 "yacc/koala.y"
+         {
+    (yyval.list) = Vector_New();
+    Vector_Append((yyval.list), (yyvsp[0].type));
+  }
+#line 1877 "koala_yacc.c"
+    break;
+
+  case 25: /* TypeList: TypeList ',' Type  */
+#line 269 "yacc/koala.y"
+                      {
+    Vector_Append((yyvsp[-2].list), (yyvsp[0].type));
+    (yyval.list) = (yyvsp[-2].list);
+  }
+#line 1886 "koala_yacc.c"
+    break;
+
+  case 26: /* TypeList: TypeList ',' ELLIPSIS  */
+#line 273 "yacc/koala.y"
+                          {
+    Vector_Append((yyval.list), &Varg_Type);
+    (yyval.list) = (yyvsp[-2].list);
+  }
+#line 1895 "koala_yacc.c"
+    break;
+
+  case 29: /* Package: PACKAGE ID ';'  */
+#line 287 "yacc/koala.y"
+                     { Parser_Set_Package(ps, (yyvsp[-1].id));             }
+#line 1901 "koala_yacc.c"
+    break;
+
+  case 30: /* Package: PACKAGE ID error  */
+#line 288 "yacc/koala.y"
+                     { syntax_error(";"); exit(-1);            }
+#line 1907 "koala_yacc.c"
+    break;
+
+  case 31: /* Package: PACKAGE error  */
+#line 289 "yacc/koala.y"
+                     { syntax_error("package-name"); exit(-1); }
+#line 1913 "koala_yacc.c"
+    break;
+
+  case 34: /* Import: IMPORT STRING_CONST ';'  */
+#line 298 "yacc/koala.y"
+                                 { Parser_New_Import(ps, NULL, (yyvsp[-1].string_const));      }
+#line 1919 "koala_yacc.c"
+    break;
+
+  case 35: /* Import: IMPORT ID STRING_CONST ';'  */
+#line 299 "yacc/koala.y"
+                                 { Parser_New_Import(ps, (yyvsp[-2].id), (yyvsp[-1].string_const));        }
+#line 1925 "koala_yacc.c"
+    break;
+
+  case 36: /* Import: IMPORT '*' STRING_CONST ';'  */
+#line 300 "yacc/koala.y"
+                                 { }
+#line 1931 "koala_yacc.c"
+    break;
+
+  case 37: /* Import: IMPORT STRING_CONST error  */
+#line 301 "yacc/koala.y"
+                                 { syntax_error(";");                    }
+#line 1937 "koala_yacc.c"
+    break;
+
+  case 38: /* Import: IMPORT ID STRING_CONST error  */
+#line 302 "yacc/koala.y"
+                                 { syntax_error(";");                    }
+#line 1943 "koala_yacc.c"
+    break;
+
+  case 39: /* Import: IMPORT ID error  */
+#line 303 "yacc/koala.y"
+                                 { syntax_error_clear("invalid import"); }
+#line 1949 "koala_yacc.c"
+    break;
+
+  case 40: /* Import: IMPORT error  */
+#line 304 "yacc/koala.y"
+                                 { syntax_error_clear("invalid import"); }
+#line 1955 "koala_yacc.c"
+    break;
+
+  case 43: /* ModuleStatement: ';'  */
+#line 313 "yacc/koala.y"
+        {}
+#line 1961 "koala_yacc.c"
+    break;
+
+  case 44: /* ModuleStatement: VariableDeclaration ';'  */
+#line 314 "yacc/koala.y"
+                              { Parser_New_Vars(ps, (yyvsp[-1].stmt));         }
+#line 1967 "koala_yacc.c"
+    break;
+
+  case 45: /* ModuleStatement: ConstDeclaration ';'  */
+#line 315 "yacc/koala.y"
+                              { Parser_New_Vars(ps, (yyvsp[-1].stmt));         }
+#line 1973 "koala_yacc.c"
+    break;
+
+  case 46: /* ModuleStatement: FunctionDeclaration  */
+#line 316 "yacc/koala.y"
+                              { Parser_New_Func(ps, (yyvsp[0].stmt));         }
+#line 1979 "koala_yacc.c"
+    break;
+
+  case 47: /* ModuleStatement: TypeDeclaration  */
+#line 317 "yacc/koala.y"
+                              { Parser_New_ClassOrTrait(ps, (yyvsp[0].stmt)); }
+#line 1985 "koala_yacc.c"
+    break;
+
+  case 48: /* ModuleStatement: TypeAliasDeclaration  */
+#line 318 "yacc/koala.y"
+                              { Parser_New_TypeAlias(ps, (yyvsp[0].stmt));    }
+#line 1991 "koala_yacc.c"
+    break;
+
+  case 49: /* ModuleStatement: VariableDeclaration error  */
+#line 319 "yacc/koala.y"
+                              {
+    //stmt_free_vardecl_list($1);
+    syntax_error(";");
+  }
+#line 2000 "koala_yacc.c"
+    break;
+
+  case 50: /* ModuleStatement: ConstDeclaration error  */
+#line 323 "yacc/koala.y"
+                           {
+    //stmt_free_vardecl_list($1);
+    syntax_error(";");
+  }
+#line 2009 "koala_yacc.c"
+    break;
+
+  case 51: /* ModuleStatement: error  */
+#line 327 "yacc/koala.y"
+          {
+    syntax_error_clear("invalid statement");
+  }
+#line 2017 "koala_yacc.c"
+    break;
+
+  case 52: /* ConstDeclaration: CONST IDList '=' ExprList  */
+#line 335 "yacc/koala.y"
+                                   { (yyval.stmt) = do_vardecls(ps, (yyvsp[-2].list), NULL, (yyvsp[0].list), 1); }
+#line 2023 "koala_yacc.c"
+    break;
+
+  case 53: /* ConstDeclaration: CONST IDList Type '=' ExprList  */
+#line 336 "yacc/koala.y"
+                                   { (yyval.stmt) = do_vardecls(ps, (yyvsp[-3].list), (yyvsp[-2].type), (yyvsp[0].list), 1);   }
+#line 2029 "koala_yacc.c"
+    break;
+
+  case 54: /* ConstDeclaration: CONST IDList '=' error  */
+#line 337 "yacc/koala.y"
+                           {
+    syntax_error("rexpr-list");
+    (yyval.stmt) = NULL;
+  }
+#line 2038 "koala_yacc.c"
+    break;
+
+  case 55: /* ConstDeclaration: CONST IDList Type '=' error  */
+#line 341 "yacc/koala.y"
+                                {
+    syntax_error("rexpr-list");
+    (yyval.stmt) = NULL;
+  }
+#line 2047 "koala_yacc.c"
+    break;
+
+  case 56: /* ConstDeclaration: CONST error  */
+#line 345 "yacc/koala.y"
+                {
+    syntax_error("id-list");
+    (yyval.stmt) = NULL;
+  }
+#line 2056 "koala_yacc.c"
+    break;
+
+  case 57: /* VariableDeclaration: VAR IDList Type  */
+#line 352 "yacc/koala.y"
+                                 { (yyval.stmt) = do_vardecls(ps, (yyvsp[-1].list), (yyvsp[0].type), NULL, 0); }
+#line 2062 "koala_yacc.c"
+    break;
+
+  case 58: /* VariableDeclaration: VAR IDList '=' ExprList  */
+#line 353 "yacc/koala.y"
+                                 { (yyval.stmt) = do_vardecls(ps, (yyvsp[-2].list), NULL, (yyvsp[0].list), 0); }
+#line 2068 "koala_yacc.c"
+    break;
+
+  case 59: /* VariableDeclaration: VAR IDList Type '=' ExprList  */
+#line 354 "yacc/koala.y"
+                                 { (yyval.stmt) = do_vardecls(ps, (yyvsp[-3].list), (yyvsp[-2].type), (yyvsp[0].list), 0);   }
+#line 2074 "koala_yacc.c"
+    break;
+
+  case 60: /* VariableDeclaration: VAR IDList error  */
+#line 355 "yacc/koala.y"
+                     {
+    syntax_error("'TYPE' or '='");
+    (yyval.stmt) = NULL;
+  }
+#line 2083 "koala_yacc.c"
+    break;
+
+  case 61: /* VariableDeclaration: VAR IDList '=' error  */
+#line 359 "yacc/koala.y"
+                         {
+    syntax_error("right's expression-list");
+    (yyval.stmt) = NULL;
+  }
+#line 2092 "koala_yacc.c"
+    break;
+
+  case 62: /* VariableDeclaration: VAR IDList Type '=' error  */
+#line 363 "yacc/koala.y"
+                              {
+    syntax_error("right's expression-list");
+    (yyval.stmt) = NULL;
+  }
+#line 2101 "koala_yacc.c"
+    break;
+
+  case 63: /* VariableDeclaration: VAR error  */
+#line 367 "yacc/koala.y"
+              {
+    syntax_error("id-list");
+    (yyval.stmt) = NULL;
+  }
+#line 2110 "koala_yacc.c"
+    break;
+
+  case 64: /* IDList: ID  */
+#line 374 "yacc/koala.y"
+       {
+    (yyval.list) = Vector_New();
+    Vector_Append((yyval.list), (yyvsp[0].id));
+  }
+#line 2119 "koala_yacc.c"
+    break;
+
+  case 65: /* IDList: IDList ',' ID  */
+#line 378 "yacc/koala.y"
+                  {
+    Vector_Append((yyvsp[-2].list), (yyvsp[0].id));
+    (yyval.list) = (yyvsp[-2].list);
+  }
+#line 2128 "koala_yacc.c"
+    break;
+
+  case 66: /* FunctionDeclaration: FUNC ID '(' ParameterList ')' ReturnTypeList Block  */
+#line 387 "yacc/koala.y"
+                                                       {
+    (yyval.stmt) = stmt_from_func((yyvsp[-5].id), (yyvsp[-3].list), (yyvsp[-1].list), (yyvsp[0].list));
+  }
+#line 2136 "koala_yacc.c"
+    break;
+
+  case 67: /* FunctionDeclaration: FUNC ID '(' ParameterList ')' Block  */
+#line 390 "yacc/koala.y"
+                                        {
+    (yyval.stmt) = stmt_from_func((yyvsp[-4].id), (yyvsp[-2].list), NULL, (yyvsp[0].list));
+  }
+#line 2144 "koala_yacc.c"
+    break;
+
+  case 68: /* FunctionDeclaration: FUNC ID '(' ')' ReturnTypeList Block  */
+#line 393 "yacc/koala.y"
+                                         {
+    (yyval.stmt) = stmt_from_func((yyvsp[-4].id), NULL, (yyvsp[-1].list), (yyvsp[0].list));
+  }
+#line 2152 "koala_yacc.c"
+    break;
+
+  case 69: /* FunctionDeclaration: FUNC ID '(' ')' Block  */
+#line 396 "yacc/koala.y"
+                          {
+    (yyval.stmt) = stmt_from_func((yyvsp[-3].id), NULL, NULL, (yyvsp[0].list));
+  }
+#line 2160 "koala_yacc.c"
+    break;
+
+  case 70: /* FunctionDeclaration: FUNC error  */
+#line 399 "yacc/koala.y"
+               {
+    syntax_error("ID");
+    assert(0);
+    (yyval.stmt) = NULL;
+  }
+#line 2170 "koala_yacc.c"
+    break;
+
+  case 71: /* ParameterList: ID Type  */
+#line 407 "yacc/koala.y"
+            {
+    (yyval.list) = Vector_New();
+    Vector_Append((yyval.list), stmt_from_var((yyvsp[-1].id), (yyvsp[0].type), NULL, 0));
+  }
+#line 2179 "koala_yacc.c"
+    break;
+
+  case 72: /* ParameterList: ParameterList ',' ID Type  */
+#line 411 "yacc/koala.y"
+                              {
+    Vector_Append((yyval.list), stmt_from_var((yyvsp[-1].id), (yyvsp[0].type), NULL, 0));
+    (yyval.list) = (yyvsp[-3].list);
+  }
+#line 2188 "koala_yacc.c"
+    break;
+
+  case 73: /* ParameterList: ParameterList ',' ID ELLIPSIS  */
+#line 415 "yacc/koala.y"
+                                  {
+    Vector_Append((yyval.list), stmt_from_var((yyvsp[-1].id), &Varg_Type, NULL, 0));
+    (yyval.list) = (yyvsp[-3].list);
+  }
+#line 2197 "koala_yacc.c"
+    break;
+
+  case 74: /* TypeAliasDeclaration: TYPEALIAS ID Type ';'  */
+#line 424 "yacc/koala.y"
+                          {
+    // $$ = stmt_from_typealias($2, $3);
+  }
+#line 2205 "koala_yacc.c"
+    break;
+
+  case 75: /* TypeAliasDeclaration: TYPEALIAS ID Type error  */
+#line 427 "yacc/koala.y"
+                            {
+    syntax_error(";");
+  }
+#line 2213 "koala_yacc.c"
+    break;
+
+  case 76: /* TypeAliasDeclaration: TYPEALIAS ID error  */
+#line 430 "yacc/koala.y"
+                       {
+    syntax_error("TYPE");
+  }
+#line 2221 "koala_yacc.c"
+    break;
+
+  case 77: /* TypeAliasDeclaration: TYPEALIAS error  */
+#line 433 "yacc/koala.y"
+                    {
+    syntax_error("ID");
+  }
+#line 2229 "koala_yacc.c"
+    break;
+
+  case 78: /* TypeDeclaration: CLASS ID ExtendsOrEmpty '{' MemberDeclarationsOrEmpty '}'  */
+#line 441 "yacc/koala.y"
+                                                              {
+    (yyval.stmt) = (yyvsp[-3].stmt);
+    (yyval.stmt)->class_info.id = (yyvsp[-4].id);
+    (yyval.stmt)->class_info.body = (yyvsp[-1].list);
+  }
+#line 2239 "koala_yacc.c"
+    break;
+
+  case 79: /* TypeDeclaration: TRAIT ID WithesOrEmpty '{' TraitMemberDeclarationsOrEmpty '}'  */
+#line 446 "yacc/koala.y"
+                                                                  {
+    (yyval.stmt) = stmt_from_trait((yyvsp[-4].id), (yyvsp[-3].list), (yyvsp[-1].list));
+  }
+#line 2247 "koala_yacc.c"
+    break;
+
+  case 80: /* TypeDeclaration: CLASS ID ExtendsOrEmpty ';'  */
+#line 449 "yacc/koala.y"
+                                {
+    (yyval.stmt) = (yyvsp[-1].stmt);
+    (yyval.stmt)->class_info.id = (yyvsp[-2].id);
+  }
+#line 2256 "koala_yacc.c"
+    break;
+
+  case 81: /* TypeDeclaration: TRAIT ID WithesOrEmpty ';'  */
+#line 453 "yacc/koala.y"
+                               {
+    (yyval.stmt) = stmt_from_trait((yyvsp[-2].id), (yyvsp[-1].list), NULL);
+  }
+#line 2264 "koala_yacc.c"
+    break;
+
+  case 82: /* ExtendsOrEmpty: %empty  */
+#line 459 "yacc/koala.y"
+           {
+    (yyval.stmt) = stmt_new(CLASS_KIND);
+  }
+#line 2272 "koala_yacc.c"
+    break;
+
+  case 83: /* ExtendsOrEmpty: EXTENDS UsrDefType WithesOrEmpty  */
+#line 462 "yacc/koala.y"
+                                     {
+    (yyval.stmt) = stmt_new(CLASS_KIND);
+    (yyval.stmt)->class_info.super = (yyvsp[-1].type);
+    (yyval.stmt)->class_info.traits = (yyvsp[0].list);
+  }
+#line 2282 "koala_yacc.c"
+    break;
+
+  case 84: /* WithesOrEmpty: %empty  */
+#line 470 "yacc/koala.y"
+           { (yyval.list) = NULL; }
+#line 2288 "koala_yacc.c"
+    break;
+
+  case 85: /* WithesOrEmpty: Traits  */
+#line 471 "yacc/koala.y"
+           { (yyval.list) = (yyvsp[0].list);   }
+#line 2294 "koala_yacc.c"
+    break;
+
+  case 86: /* Traits: WITH UsrDefType  */
+#line 475 "yacc/koala.y"
+                    {
+    (yyval.list) = Vector_New();
+    Vector_Append((yyval.list), (yyvsp[0].type));
+  }
+#line 2303 "koala_yacc.c"
+    break;
+
+  case 87: /* Traits: Traits WITH UsrDefType  */
+#line 479 "yacc/koala.y"
+                           {
+    Vector_Append((yyvsp[-2].list), (yyvsp[0].type));
+    (yyval.list) = (yyvsp[-2].list);
+  }
+#line 2312 "koala_yacc.c"
+    break;
+
+  case 88: /* MemberDeclarationsOrEmpty: %empty  */
+#line 487 "yacc/koala.y"
+                       { (yyval.list) = NULL; }
+#line 2318 "koala_yacc.c"
+    break;
+
+  case 89: /* MemberDeclarationsOrEmpty: MemberDeclarations  */
+#line 488 "yacc/koala.y"
+                       { (yyval.list) = (yyvsp[0].list);   }
+#line 2324 "koala_yacc.c"
+    break;
+
+  case 90: /* MemberDeclarations: MemberDeclaration  */
+#line 492 "yacc/koala.y"
+                      {
+    (yyval.list) = Vector_New();
+    Vector_Append((yyval.list), (yyvsp[0].stmt));
+  }
+#line 2333 "koala_yacc.c"
+    break;
+
+  case 91: /* MemberDeclarations: MemberDeclarations MemberDeclaration  */
+#line 496 "yacc/koala.y"
+                                         {
+    Vector_Append((yyvsp[-1].list), (yyvsp[0].stmt));
+    (yyval.list) = (yyvsp[-1].list);
+  }
+#line 2342 "koala_yacc.c"
+    break;
+
+  case 92: /* MemberDeclaration: FieldDeclaration  */
+#line 503 "yacc/koala.y"
+                     {
+    (yyval.stmt) = (yyvsp[0].stmt);
+  }
+#line 2350 "koala_yacc.c"
+    break;
+
+  case 93: /* MemberDeclaration: FunctionDeclaration  */
+#line 506 "yacc/koala.y"
+                        {
+    (yyval.stmt) = (yyvsp[0].stmt);
+  }
+#line 2358 "koala_yacc.c"
+    break;
+
+  case 94: /* TraitMemberDeclarationsOrEmpty: %empty  */
+#line 512 "yacc/koala.y"
+                            { (yyval.list) = NULL; }
+#line 2364 "koala_yacc.c"
+    break;
+
+  case 95: /* TraitMemberDeclarationsOrEmpty: TraitMemberDeclarations  */
+#line 513 "yacc/koala.y"
+                            { (yyval.list) = (yyvsp[0].list);   }
+#line 2370 "koala_yacc.c"
+    break;
+
+  case 96: /* TraitMemberDeclarations: TraitMemberDeclaration  */
+#line 517 "yacc/koala.y"
+                           {
+    (yyval.list) = Vector_New();
+    Vector_Append((yyval.list), (yyvsp[0].stmt));
+  }
+#line 2379 "koala_yacc.c"
+    break;
+
+  case 97: /* TraitMemberDeclarations: TraitMemberDeclarations TraitMemberDeclaration  */
+#line 521 "yacc/koala.y"
+                                                   {
+    Vector_Append((yyvsp[-1].list), (yyvsp[0].stmt));
+    (yyval.list) = (yyvsp[-1].list);
+  }
+#line 2388 "koala_yacc.c"
+    break;
+
+  case 98: /* TraitMemberDeclaration: FieldDeclaration  */
+#line 528 "yacc/koala.y"
+                     {
+    (yyval.stmt) = (yyvsp[0].stmt);
+  }
+#line 2396 "koala_yacc.c"
+    break;
+
+  case 99: /* TraitMemberDeclaration: ProtoDeclaration  */
+#line 531 "yacc/koala.y"
+                     {
+    (yyval.stmt) = (yyvsp[0].stmt);
+  }
+#line 2404 "koala_yacc.c"
+    break;
+
+  case 100: /* TraitMemberDeclaration: FunctionDeclaration  */
+#line 534 "yacc/koala.y"
+                        {
+    (yyval.stmt) = (yyvsp[0].stmt);
+  }
+#line 2412 "koala_yacc.c"
+    break;
+
+  case 101: /* FieldDeclaration: ID Type ';'  */
+#line 540 "yacc/koala.y"
+                {
+    //$$ = stmt_from_vardecl(new_var($2, $3), NULL, 0);
+  }
+#line 2420 "koala_yacc.c"
+    break;
+
+  case 102: /* FieldDeclaration: ID '=' Expr ';'  */
+#line 543 "yacc/koala.y"
+                    {
+    //$$ = stmt_from_vardecl(new_var($2, NULL), $4, 0);
+  }
+#line 2428 "koala_yacc.c"
+    break;
+
+  case 103: /* FieldDeclaration: ID Type '=' Expr ';'  */
+#line 546 "yacc/koala.y"
+                         {
+    //$$ = stmt_from_vardecl(new_var($2, $3), $5, 0);
+  }
+#line 2436 "koala_yacc.c"
+    break;
+
+  case 104: /* ProtoDeclaration: FUNC ID '(' TypeList ')' ReturnTypeList ';'  */
+#line 552 "yacc/koala.y"
+                                                {
+    // $$ = stmt_from_funcproto($2, $4, $6);
+  }
+#line 2444 "koala_yacc.c"
+    break;
+
+  case 105: /* ProtoDeclaration: FUNC ID '(' TypeList ')' ';'  */
+#line 555 "yacc/koala.y"
+                                 {
+
+  }
+#line 2452 "koala_yacc.c"
+    break;
+
+  case 106: /* ProtoDeclaration: FUNC ID '(' ')' ReturnTypeList ';'  */
+#line 558 "yacc/koala.y"
+                                       {
+    //$$ = stmt_from_funcproto($2, NULL, $5);
+  }
+#line 2460 "koala_yacc.c"
+    break;
+
+  case 107: /* ProtoDeclaration: FUNC ID '(' ')' ';'  */
+#line 561 "yacc/koala.y"
+                        {
+
+  }
+#line 2468 "koala_yacc.c"
+    break;
+
+  case 108: /* Block: '{' LocalStatements '}'  */
+#line 569 "yacc/koala.y"
+                            { (yyval.list) = (yyvsp[-1].list);  }
+#line 2474 "koala_yacc.c"
+    break;
+
+  case 109: /* Block: '{' '}'  */
+#line 570 "yacc/koala.y"
+                            {(yyval.list) = NULL; }
+#line 2480 "koala_yacc.c"
+    break;
+
+  case 110: /* LocalStatements: LocalStatement  */
+#line 574 "yacc/koala.y"
+                   {
+    (yyval.list) = Vector_New();
+    if ((yyvsp[0].stmt) != NULL) Vector_Append((yyval.list), (yyvsp[0].stmt));
+  }
+#line 2489 "koala_yacc.c"
+    break;
+
+  case 111: /* LocalStatements: LocalStatements LocalStatement  */
+#line 578 "yacc/koala.y"
+                                   {
+    if ((yyvsp[0].stmt) != NULL) Vector_Append((yyvsp[-1].list), (yyvsp[0].stmt));
+    (yyval.list) = (yyvsp[-1].list);
+  }
+#line 2498 "koala_yacc.c"
+    break;
+
+  case 112: /* LocalStatement: ';'  */
+#line 585 "yacc/koala.y"
+                            { (yyval.stmt) = NULL;                }
+#line 2504 "koala_yacc.c"
+    break;
+
+  case 113: /* LocalStatement: Expr ';'  */
+#line 586 "yacc/koala.y"
+                            { (yyval.stmt) = stmt_from_expr((yyvsp[-1].expr));  }
+#line 2510 "koala_yacc.c"
+    break;
+
+  case 114: /* LocalStatement: VariableDeclaration ';'  */
+#line 587 "yacc/koala.y"
+                            { (yyval.stmt) = (yyvsp[-1].stmt);                  }
+#line 2516 "koala_yacc.c"
+    break;
+
+  case 115: /* LocalStatement: Assignment  */
+#line 588 "yacc/koala.y"
+                            { (yyval.stmt) = (yyvsp[0].stmt);                  }
+#line 2522 "koala_yacc.c"
+    break;
+
+  case 116: /* LocalStatement: IfStatement  */
+#line 589 "yacc/koala.y"
+                            { (yyval.stmt) = (yyvsp[0].stmt);                  }
+#line 2528 "koala_yacc.c"
+    break;
+
+  case 117: /* LocalStatement: WhileStatement  */
+#line 590 "yacc/koala.y"
+                            { (yyval.stmt) = (yyvsp[0].stmt);                  }
+#line 2534 "koala_yacc.c"
+    break;
+
+  case 118: /* LocalStatement: SwitchStatement  */
+#line 591 "yacc/koala.y"
+                            {                           }
+#line 2540 "koala_yacc.c"
+    break;
+
+  case 119: /* LocalStatement: ForStatement  */
+#line 592 "yacc/koala.y"
+                            { (yyval.stmt) = (yyvsp[0].stmt);                  }
+#line 2546 "koala_yacc.c"
+    break;
+
+  case 120: /* LocalStatement: JumpStatement  */
+#line 593 "yacc/koala.y"
+                            { (yyval.stmt) = (yyvsp[0].stmt);                  }
+#line 2552 "koala_yacc.c"
+    break;
+
+  case 121: /* LocalStatement: ReturnStatement  */
+#line 594 "yacc/koala.y"
+                            { (yyval.stmt) = (yyvsp[0].stmt);                  }
+#line 2558 "koala_yacc.c"
+    break;
+
+  case 122: /* LocalStatement: Block  */
+#line 595 "yacc/koala.y"
+                            { (yyval.stmt) = stmt_from_block((yyvsp[0].list)); }
+#line 2564 "koala_yacc.c"
+    break;
+
+  case 123: /* LocalStatement: Expr error  */
+#line 597 "yacc/koala.y"
+               {
+    //free
+    syntax_error(";"); (yyval.stmt) = NULL;
+  }
+#line 2573 "koala_yacc.c"
+    break;
+
+  case 124: /* LocalStatement: VariableDeclaration error  */
+#line 601 "yacc/koala.y"
+                              {
+    //free
+    syntax_error(";"); (yyval.stmt) = NULL;
+  }
+#line 2582 "koala_yacc.c"
+    break;
+
+  case 125: /* IfStatement: IF Expr Block OrElseStatement  */
+#line 623 "yacc/koala.y"
+                                  {
+    (yyval.stmt) = stmt_from_if((yyvsp[-2].expr), (yyvsp[-1].list), (yyvsp[0].stmt));
+    (yyval.stmt)->if_stmt.belse = 0;
+  }
+#line 2591 "koala_yacc.c"
+    break;
+
+  case 126: /* OrElseStatement: %empty  */
+#line 630 "yacc/koala.y"
+           {
+    (yyval.stmt) = NULL;
+  }
+#line 2599 "koala_yacc.c"
+    break;
+
+  case 127: /* OrElseStatement: ELSE Block  */
+#line 633 "yacc/koala.y"
+               {
+    (yyval.stmt) = stmt_from_if(NULL, (yyvsp[0].list), NULL);
+    (yyval.stmt)->if_stmt.belse = 1;
+  }
+#line 2608 "koala_yacc.c"
+    break;
+
+  case 128: /* OrElseStatement: ELSE IfStatement  */
+#line 637 "yacc/koala.y"
+                     {
+    (yyval.stmt) = (yyvsp[0].stmt);
+    (yyval.stmt)->if_stmt.belse = 1;
+  }
+#line 2617 "koala_yacc.c"
+    break;
+
+  case 129: /* WhileStatement: WHILE Expr Block  */
+#line 646 "yacc/koala.y"
+                     {
+    (yyval.stmt) = stmt_from_while((yyvsp[-1].expr), (yyvsp[0].list), 1);
+  }
+#line 2625 "koala_yacc.c"
+    break;
+
+  case 130: /* WhileStatement: DO Block WHILE Expr ';'  */
+#line 649 "yacc/koala.y"
+                            {
+    (yyval.stmt) = stmt_from_while((yyvsp[-1].expr), (yyvsp[-3].list), 0);
+  }
+#line 2633 "koala_yacc.c"
+    break;
+
+  case 131: /* SwitchStatement: SWITCH '(' Expr ')' '{' CaseStatements '}'  */
+#line 657 "yacc/koala.y"
+                                               {
+    (yyval.stmt) = stmt_from_switch((yyvsp[-4].expr), (yyvsp[-1].list));
+  }
+#line 2641 "koala_yacc.c"
+    break;
+
+  case 132: /* CaseStatements: CaseStatement  */
+#line 663 "yacc/koala.y"
+                  {
+    (yyval.list) = Vector_New();
+    Vector_Append((yyval.list), (yyvsp[0].testblock));
+  }
+#line 2650 "koala_yacc.c"
+    break;
+
+  case 133: /* CaseStatements: CaseStatements CaseStatement  */
+#line 667 "yacc/koala.y"
+                                 {
+    if ((yyvsp[0].testblock)->test == NULL) {
+      // default case
+      struct test_block *tb = Vector_Get((yyvsp[-1].list), 0);
+      if (tb != NULL && tb->test == NULL) {
+        fprintf(stderr, "[ERROR] default case needs only one\n");
+        exit(0);
+      } else {
+        Vector_Set((yyvsp[-1].list), 0, (yyvsp[0].testblock));
+      }
+    } else {
+      Vector_Append((yyvsp[-1].list), (yyvsp[0].testblock));
+    }
+    (yyval.list) = (yyvsp[-1].list);
+  }
+#line 2670 "koala_yacc.c"
+    break;
+
+  case 134: /* CaseStatement: CASE Expr ':' Block  */
+#line 685 "yacc/koala.y"
+                        {
+    (yyval.testblock) = new_test_block((yyvsp[-2].expr), (yyvsp[0].list));
+  }
+#line 2678 "koala_yacc.c"
+    break;
+
+  case 135: /* CaseStatement: DEFAULT ':' Block  */
+#line 688 "yacc/koala.y"
+                      {
+    (yyval.testblock) = new_test_block(NULL, (yyvsp[0].list));
+  }
+#line 2686 "koala_yacc.c"
+    break;
+
+  case 136: /* ForStatement: FOR ID IN Expr DOTDOTLESS Expr Block  */
+#line 696 "yacc/koala.y"
+                                         {
+    (yyval.stmt) = stmt_from_for_range((yyvsp[-5].id), (yyvsp[-3].expr), (yyvsp[-1].expr), 0, (yyvsp[0].list));
+  }
+#line 2694 "koala_yacc.c"
+    break;
+
+  case 137: /* ForStatement: FOR ID IN Expr ELLIPSIS Expr Block  */
+#line 699 "yacc/koala.y"
+                                       {
+    (yyval.stmt) = stmt_from_for_range((yyvsp[-5].id), (yyvsp[-3].expr), (yyvsp[-1].expr), 1, (yyvsp[0].list));
+  }
+#line 2702 "koala_yacc.c"
+    break;
+
+  case 138: /* JumpStatement: BREAK ';'  */
+#line 707 "yacc/koala.y"
+              {
+    (yyval.stmt) = stmt_from_jump(BREAK_KIND, 1);
+  }
+#line 2710 "koala_yacc.c"
+    break;
+
+  case 139: /* JumpStatement: BREAK INT_CONST ';'  */
+#line 710 "yacc/koala.y"
+                        {
+    (yyval.stmt) = stmt_from_jump(BREAK_KIND, (yyvsp[-1].ival));
+  }
+#line 2718 "koala_yacc.c"
+    break;
+
+  case 140: /* JumpStatement: CONTINUE ';'  */
+#line 713 "yacc/koala.y"
+                 {
+    (yyval.stmt) = stmt_from_jump(CONTINUE_KIND, 1);
+  }
+#line 2726 "koala_yacc.c"
+    break;
+
+  case 141: /* JumpStatement: CONTINUE INT_CONST ';'  */
+#line 716 "yacc/koala.y"
+                           {
+    (yyval.stmt) = stmt_from_jump(CONTINUE_KIND, (yyvsp[-1].ival));
+  }
+#line 2734 "koala_yacc.c"
+    break;
+
+  case 142: /* ReturnStatement: TOKEN_RETURN ';'  */
+#line 722 "yacc/koala.y"
+                                { (yyval.stmt) = stmt_from_return(NULL); }
+#line 2740 "koala_yacc.c"
+    break;
+
+  case 143: /* ReturnStatement: TOKEN_RETURN ExprList ';'  */
+#line 723 "yacc/koala.y"
+                                { (yyval.stmt) = stmt_from_return((yyvsp[-1].list));   }
+#line 2746 "koala_yacc.c"
+    break;
+
+  case 144: /* ReturnStatement: TOKEN_RETURN error  */
+#line 724 "yacc/koala.y"
+                                {}
+#line 2752 "koala_yacc.c"
+    break;
+
+  case 145: /* ReturnStatement: TOKEN_RETURN ExprList error  */
+#line 725 "yacc/koala.y"
+                                {}
+#line 2758 "koala_yacc.c"
+    break;
+
+  case 146: /* PrimaryExpr: Atom  */
+#line 731 "yacc/koala.y"
+         {
+    (yyval.expr) = (yyvsp[0].expr);
+  }
+#line 2766 "koala_yacc.c"
+    break;
+
+  case 147: /* PrimaryExpr: PrimaryExpr Selector  */
+#line 734 "yacc/koala.y"
+                         {
+    (yyval.expr) = expr_from_trailer(ATTRIBUTE_KIND, (yyvsp[0].id), (yyvsp[-1].expr));
+  }
+#line 2774 "koala_yacc.c"
+    break;
+
+  case 148: /* PrimaryExpr: PrimaryExpr Arguments WithesOrEmpty  */
+#line 737 "yacc/koala.y"
+                                        {
+    (yyval.expr) = expr_from_trailer(CALL_KIND, (yyvsp[-1].list), (yyvsp[-2].expr));
+  }
+#line 2782 "koala_yacc.c"
+    break;
+
+  case 149: /* PrimaryExpr: PrimaryExpr Index  */
+#line 740 "yacc/koala.y"
+                      {
+    (yyval.expr) = expr_from_trailer(SUBSCRIPT_KIND, (yyvsp[0].expr), (yyvsp[-1].expr));
+  }
+#line 2790 "koala_yacc.c"
+    break;
+
+  case 150: /* PrimaryExpr: PrimaryExpr Slice  */
+#line 743 "yacc/koala.y"
+                      {
+    (yyval.expr) = NULL;
+  }
+#line 2798 "koala_yacc.c"
+    break;
+
+  case 151: /* Selector: '.' ID  */
+#line 749 "yacc/koala.y"
+                     { (yyval.id) = (yyvsp[0].id);   }
+#line 2804 "koala_yacc.c"
+    break;
+
+  case 152: /* Arguments: '(' ')'  */
+#line 753 "yacc/koala.y"
+                     { (yyval.list) = NULL; }
+#line 2810 "koala_yacc.c"
+    break;
+
+  case 153: /* Arguments: '(' ExprList ')'  */
+#line 754 "yacc/koala.y"
+                     { (yyval.list) = (yyvsp[-1].list);   }
+#line 2816 "koala_yacc.c"
+    break;
+
+  case 154: /* Index: '[' Expr ']'  */
+#line 758 "yacc/koala.y"
+                     { (yyval.expr) = (yyvsp[-1].expr);   }
+#line 2822 "koala_yacc.c"
+    break;
+
+  case 159: /* Atom: CONSTANT  */
+#line 769 "yacc/koala.y"
+                    { (yyval.expr) = (yyvsp[0].expr); }
+#line 2828 "koala_yacc.c"
+    break;
+
+  case 160: /* Atom: SELF  */
+#line 770 "yacc/koala.y"
+                    { (yyval.expr) = expr_from_self(); }
+#line 2834 "koala_yacc.c"
+    break;
+
+  case 161: /* Atom: SUPER  */
+#line 771 "yacc/koala.y"
+                    { (yyval.expr) = expr_from_super(); }
+#line 2840 "koala_yacc.c"
+    break;
+
+  case 162: /* Atom: TYPEOF  */
+#line 772 "yacc/koala.y"
+                    { /* $$ = expr_from_typeof(); */ }
+#line 2846 "koala_yacc.c"
+    break;
+
+  case 163: /* Atom: ID  */
+#line 773 "yacc/koala.y"
+                    { (yyval.expr) = expr_from_id((yyvsp[0].id)); }
+#line 2852 "koala_yacc.c"
+    break;
+
+  case 164: /* Atom: '(' Expr ')'  */
+#line 774 "yacc/koala.y"
+                    { (yyval.expr) = (yyvsp[-1].expr); }
+#line 2858 "koala_yacc.c"
+    break;
+
+  case 165: /* Atom: ArrayExpr  */
+#line 775 "yacc/koala.y"
+                    { (yyval.expr) = (yyvsp[0].expr); }
+#line 2864 "koala_yacc.c"
+    break;
+
+  case 166: /* Atom: DictExpr  */
+#line 776 "yacc/koala.y"
+                    { }
+#line 2870 "koala_yacc.c"
+    break;
+
+  case 167: /* Atom: AnonyFuncExpr  */
+#line 777 "yacc/koala.y"
+                    { }
+#line 2876 "koala_yacc.c"
+    break;
+
+  case 168: /* Atom: SysCallExpr  */
+#line 778 "yacc/koala.y"
+                    { }
+#line 2882 "koala_yacc.c"
+    break;
+
+  case 169: /* CONSTANT: CHAR_CONST  */
+#line 782 "yacc/koala.y"
+                 {}
+#line 2888 "koala_yacc.c"
+    break;
+
+  case 170: /* CONSTANT: BYTE_CONST  */
+#line 783 "yacc/koala.y"
+                 {}
+#line 2894 "koala_yacc.c"
+    break;
+
+  case 171: /* CONSTANT: INT_CONST  */
+#line 784 "yacc/koala.y"
+                 { (yyval.expr) = expr_from_int((yyvsp[0].ival));    }
+#line 2900 "koala_yacc.c"
+    break;
+
+  case 172: /* CONSTANT: HEX_CONST  */
+#line 785 "yacc/koala.y"
+                 { (yyval.expr) = NULL;                 }
+#line 2906 "koala_yacc.c"
+    break;
+
+  case 173: /* CONSTANT: OCT_CONST  */
+#line 786 "yacc/koala.y"
+                 { (yyval.expr) = NULL;                 }
+#line 2912 "koala_yacc.c"
+    break;
+
+  case 174: /* CONSTANT: FLOAT_CONST  */
+#line 787 "yacc/koala.y"
+                 { (yyval.expr) = expr_from_float((yyvsp[0].fval));  }
+#line 2918 "koala_yacc.c"
+    break;
+
+  case 175: /* CONSTANT: STRING_CONST  */
+#line 788 "yacc/koala.y"
+                 { (yyval.expr) = expr_from_string((yyvsp[0].string_const)); }
+#line 2924 "koala_yacc.c"
+    break;
+
+  case 176: /* CONSTANT: TOKEN_NIL  */
+#line 789 "yacc/koala.y"
+                 { (yyval.expr) = expr_from_nil();      }
+#line 2930 "koala_yacc.c"
+    break;
+
+  case 177: /* CONSTANT: TOKEN_TRUE  */
+#line 790 "yacc/koala.y"
+                 { (yyval.expr) = expr_from_bool(1);    }
+#line 2936 "koala_yacc.c"
+    break;
+
+  case 178: /* CONSTANT: TOKEN_FALSE  */
+#line 791 "yacc/koala.y"
+                 { (yyval.expr) = expr_from_bool(0);    }
+#line 2942 "koala_yacc.c"
+    break;
+
+  case 179: /* ArrayExpr: '[' ExprList ']'  */
+#line 795 "yacc/koala.y"
+                     { (yyval.expr) = do_array_initializer(ps, (yyvsp[-1].list)); }
+#line 2948 "koala_yacc.c"
+    break;
+
+  case 180: /* ArrayExpr: '[' ']'  */
+#line 796 "yacc/koala.y"
+                     { (yyval.expr) = expr_from_array(NULL); }
+#line 2954 "koala_yacc.c"
+    break;
+
+  case 181: /* DictExpr: '[' KVList ']'  */
+#line 800 "yacc/koala.y"
+                   {}
+#line 2960 "koala_yacc.c"
+    break;
+
+  case 182: /* DictExpr: '[' ':' ']'  */
+#line 801 "yacc/koala.y"
+                   {}
+#line 2966 "koala_yacc.c"
+    break;
+
+  case 185: /* AnonyFuncExpr: FUNC '(' ParameterList ')' ReturnTypeList Block  */
+#line 810 "yacc/koala.y"
+                                                    {
+    // $$ = expr_from_anonymous_func($2, $3, $4);
+  }
+#line 2974 "koala_yacc.c"
+    break;
+
+  case 186: /* AnonyFuncExpr: FUNC '(' ParameterList ')' Block  */
+#line 813 "yacc/koala.y"
+                                     {
+
+  }
+#line 2982 "koala_yacc.c"
+    break;
+
+  case 187: /* AnonyFuncExpr: FUNC '(' ')' ReturnTypeList Block  */
+#line 816 "yacc/koala.y"
+                                      {
+
+  }
+#line 2990 "koala_yacc.c"
+    break;
+
+  case 188: /* AnonyFuncExpr: FUNC '(' ')' Block  */
+#line 819 "yacc/koala.y"
+                       {
+
+  }
+#line 2998 "koala_yacc.c"
+    break;
+
+  case 189: /* AnonyFuncExpr: FUNC error  */
+#line 822 "yacc/koala.y"
+               {
+    syntax_error_clear("invalid anonymous function");
+    (yyval.expr) = NULL;
+  }
+#line 3007 "koala_yacc.c"
+    break;
+
+  case 191: /* UnaryExpr: PrimaryExpr  */
+#line 835 "yacc/koala.y"
+                         { (yyval.expr) = (yyvsp[0].expr); }
+#line 3013 "koala_yacc.c"
+    break;
+
+  case 192: /* UnaryExpr: UnaryOp UnaryExpr  */
+#line 836 "yacc/koala.y"
+                      { (yyval.expr) = expr_from_unary((yyvsp[-1].operator), (yyvsp[0].expr)); }
+#line 3019 "koala_yacc.c"
+    break;
+
+  case 193: /* UnaryOp: '+'  */
+#line 840 "yacc/koala.y"
+        { (yyval.operator) = UNARY_PLUS;    }
+#line 3025 "koala_yacc.c"
+    break;
+
+  case 194: /* UnaryOp: '-'  */
+#line 841 "yacc/koala.y"
+        { (yyval.operator) = UNARY_MINUS;   }
+#line 3031 "koala_yacc.c"
+    break;
+
+  case 195: /* UnaryOp: '~'  */
+#line 842 "yacc/koala.y"
+        { (yyval.operator) = UNARY_BIT_NOT; }
+#line 3037 "koala_yacc.c"
+    break;
+
+  case 196: /* UnaryOp: NOT  */
+#line 843 "yacc/koala.y"
+        { (yyval.operator) = UNARY_LNOT;    }
+#line 3043 "koala_yacc.c"
+    break;
+
+  case 197: /* MultiplExpr: UnaryExpr  */
+#line 847 "yacc/koala.y"
+                              { (yyval.expr) = (yyvsp[0].expr); }
+#line 3049 "koala_yacc.c"
+    break;
+
+  case 198: /* MultiplExpr: MultiplExpr '*' UnaryExpr  */
+#line 848 "yacc/koala.y"
+                              { (yyval.expr) = expr_from_binary(BINARY_MULT, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3055 "koala_yacc.c"
+    break;
+
+  case 199: /* MultiplExpr: MultiplExpr '/' UnaryExpr  */
+#line 849 "yacc/koala.y"
+                              { (yyval.expr) = expr_from_binary(BINARY_DIV, (yyvsp[-2].expr), (yyvsp[0].expr));  }
+#line 3061 "koala_yacc.c"
+    break;
+
+  case 200: /* MultiplExpr: MultiplExpr '%' UnaryExpr  */
+#line 850 "yacc/koala.y"
+                              { (yyval.expr) = expr_from_binary(BINARY_MOD, (yyvsp[-2].expr), (yyvsp[0].expr));  }
+#line 3067 "koala_yacc.c"
+    break;
+
+  case 201: /* MultiplExpr: MultiplExpr POWER UnaryExpr  */
+#line 851 "yacc/koala.y"
+                                {}
+#line 3073 "koala_yacc.c"
+    break;
+
+  case 202: /* AddExpr: MultiplExpr  */
+#line 855 "yacc/koala.y"
+                            { (yyval.expr) = (yyvsp[0].expr); }
+#line 3079 "koala_yacc.c"
+    break;
+
+  case 203: /* AddExpr: AddExpr '+' MultiplExpr  */
+#line 856 "yacc/koala.y"
+                            { (yyval.expr) = expr_from_binary(BINARY_ADD, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3085 "koala_yacc.c"
+    break;
+
+  case 204: /* AddExpr: AddExpr '-' MultiplExpr  */
+#line 857 "yacc/koala.y"
+                            { (yyval.expr) = expr_from_binary(BINARY_SUB, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3091 "koala_yacc.c"
+    break;
+
+  case 205: /* ShiftExpr: AddExpr  */
+#line 861 "yacc/koala.y"
+                             { (yyval.expr) = (yyvsp[0].expr); }
+#line 3097 "koala_yacc.c"
+    break;
+
+  case 206: /* ShiftExpr: ShiftExpr LSHIFT AddExpr  */
+#line 862 "yacc/koala.y"
+                             { (yyval.expr) = expr_from_binary(BINARY_LSHIFT, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3103 "koala_yacc.c"
+    break;
+
+  case 207: /* ShiftExpr: ShiftExpr RSHIFT AddExpr  */
+#line 863 "yacc/koala.y"
+                             { (yyval.expr) = expr_from_binary(BINARY_RSHIFT, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3109 "koala_yacc.c"
+    break;
+
+  case 208: /* RelationExpr: ShiftExpr  */
+#line 867 "yacc/koala.y"
+                               { (yyval.expr) = (yyvsp[0].expr); }
+#line 3115 "koala_yacc.c"
+    break;
+
+  case 209: /* RelationExpr: RelationExpr '<' ShiftExpr  */
+#line 868 "yacc/koala.y"
+                               { (yyval.expr) = expr_from_binary(BINARY_LT, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3121 "koala_yacc.c"
+    break;
+
+  case 210: /* RelationExpr: RelationExpr '>' ShiftExpr  */
+#line 869 "yacc/koala.y"
+                               { (yyval.expr) = expr_from_binary(BINARY_GT, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3127 "koala_yacc.c"
+    break;
+
+  case 211: /* RelationExpr: RelationExpr LE ShiftExpr  */
+#line 870 "yacc/koala.y"
+                               { (yyval.expr) = expr_from_binary(BINARY_LE, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3133 "koala_yacc.c"
+    break;
+
+  case 212: /* RelationExpr: RelationExpr GE ShiftExpr  */
+#line 871 "yacc/koala.y"
+                               { (yyval.expr) = expr_from_binary(BINARY_GE, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3139 "koala_yacc.c"
+    break;
+
+  case 213: /* EqualityExpr: RelationExpr  */
+#line 875 "yacc/koala.y"
+                                 { (yyval.expr) = (yyvsp[0].expr); }
+#line 3145 "koala_yacc.c"
+    break;
+
+  case 214: /* EqualityExpr: EqualityExpr EQ RelationExpr  */
+#line 876 "yacc/koala.y"
+                                 { (yyval.expr) = expr_from_binary(BINARY_EQ, (yyvsp[-2].expr), (yyvsp[0].expr));  }
+#line 3151 "koala_yacc.c"
+    break;
+
+  case 215: /* EqualityExpr: EqualityExpr NE RelationExpr  */
+#line 877 "yacc/koala.y"
+                                 { (yyval.expr) = expr_from_binary(BINARY_NEQ, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3157 "koala_yacc.c"
+    break;
+
+  case 216: /* AndExpr: EqualityExpr  */
+#line 881 "yacc/koala.y"
+                             { (yyval.expr) = (yyvsp[0].expr); }
+#line 3163 "koala_yacc.c"
+    break;
+
+  case 217: /* AndExpr: AndExpr '&' EqualityExpr  */
+#line 882 "yacc/koala.y"
+                             { (yyval.expr) = expr_from_binary(BINARY_BIT_AND, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3169 "koala_yacc.c"
+    break;
+
+  case 218: /* ExclOrExpr: AndExpr  */
+#line 886 "yacc/koala.y"
+                           { (yyval.expr) = (yyvsp[0].expr); }
+#line 3175 "koala_yacc.c"
+    break;
+
+  case 219: /* ExclOrExpr: ExclOrExpr '^' AndExpr  */
+#line 887 "yacc/koala.y"
+                           { (yyval.expr) = expr_from_binary(BINARY_BIT_XOR, (yyvsp[-2].expr), (yyvsp[0].expr));}
+#line 3181 "koala_yacc.c"
+    break;
+
+  case 220: /* InclOrExpr: ExclOrExpr  */
+#line 891 "yacc/koala.y"
+                              { (yyval.expr) = (yyvsp[0].expr); }
+#line 3187 "koala_yacc.c"
+    break;
+
+  case 221: /* InclOrExpr: InclOrExpr '|' ExclOrExpr  */
+#line 892 "yacc/koala.y"
+                              { (yyval.expr) = expr_from_binary(BINARY_BIT_OR, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3193 "koala_yacc.c"
+    break;
+
+  case 222: /* LogAndExpr: InclOrExpr  */
+#line 896 "yacc/koala.y"
+                              { (yyval.expr) = (yyvsp[0].expr); }
+#line 3199 "koala_yacc.c"
+    break;
+
+  case 223: /* LogAndExpr: LogAndExpr AND InclOrExpr  */
+#line 897 "yacc/koala.y"
+                              { (yyval.expr) = expr_from_binary(BINARY_LAND, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3205 "koala_yacc.c"
+    break;
+
+  case 224: /* Expr: LogAndExpr  */
+#line 901 "yacc/koala.y"
+                       { (yyval.expr) = (yyvsp[0].expr); }
+#line 3211 "koala_yacc.c"
+    break;
+
+  case 225: /* Expr: Expr OR LogAndExpr  */
+#line 902 "yacc/koala.y"
+                       { (yyval.expr) = expr_from_binary(BINARY_LOR, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 3217 "koala_yacc.c"
+    break;
+
+  case 226: /* ExprList: Expr  */
+#line 906 "yacc/koala.y"
+         {
+    (yyval.list) = Vector_New();
+    Vector_Append((yyval.list), (yyvsp[0].expr));
+  }
+#line 3226 "koala_yacc.c"
+    break;
+
+  case 227: /* ExprList: ExprList ',' Expr  */
+#line 910 "yacc/koala.y"
+                      {
+    Vector_Append((yyvsp[-2].list), (yyvsp[0].expr));
+    (yyval.list) = (yyvsp[-2].list);
+  }
+#line 3235 "koala_yacc.c"
+    break;
+
+  case 228: /* Assignment: ExprList '=' ExprList ';'  */
+#line 917 "yacc/koala.y"
+                                      { (yyval.stmt) = do_assignments(ps, (yyvsp[-3].list), (yyvsp[-1].list));   }
+#line 3241 "koala_yacc.c"
+    break;
+
+  case 229: /* Assignment: ExprList TYPELESS_ASSIGN ExprList ';'  */
+#line 918 "yacc/koala.y"
+                                          {
+    (yyval.stmt) = NULL;
+  }
+#line 3249 "koala_yacc.c"
+    break;
+
+  case 230: /* Assignment: PrimaryExpr CompAssignOp Expr ';'  */
+#line 921 "yacc/koala.y"
+                                      { (yyval.stmt) = stmt_from_assign((yyvsp[-3].expr), (yyvsp[-2].operator), (yyvsp[-1].expr)); }
+#line 3255 "koala_yacc.c"
+    break;
+
+  case 231: /* CompAssignOp: PLUS_ASSGIN  */
+#line 925 "yacc/koala.y"
+                  { (yyval.operator) = OP_PLUS_ASSIGN;   }
+#line 3261 "koala_yacc.c"
+    break;
+
+  case 232: /* CompAssignOp: MINUS_ASSIGN  */
+#line 926 "yacc/koala.y"
+                  { (yyval.operator) = OP_MINUS_ASSIGN;  }
+#line 3267 "koala_yacc.c"
+    break;
+
+  case 233: /* CompAssignOp: MULT_ASSIGN  */
+#line 927 "yacc/koala.y"
+                  { (yyval.operator) = OP_MULT_ASSIGN;   }
+#line 3273 "koala_yacc.c"
+    break;
+
+  case 234: /* CompAssignOp: DIV_ASSIGN  */
+#line 928 "yacc/koala.y"
+                  { (yyval.operator) = OP_DIV_ASSIGN;    }
+#line 3279 "koala_yacc.c"
+    break;
+
+  case 235: /* CompAssignOp: MOD_ASSIGN  */
+#line 929 "yacc/koala.y"
+                  { (yyval.operator) = OP_MOD_ASSIGN;    }
+#line 3285 "koala_yacc.c"
+    break;
+
+  case 236: /* CompAssignOp: AND_ASSIGN  */
+#line 930 "yacc/koala.y"
+                  { (yyval.operator) = OP_AND_ASSIGN;    }
+#line 3291 "koala_yacc.c"
+    break;
+
+  case 237: /* CompAssignOp: OR_ASSIGN  */
+#line 931 "yacc/koala.y"
+                  { (yyval.operator) = OP_OR_ASSIGN;     }
+#line 3297 "koala_yacc.c"
+    break;
+
+  case 238: /* CompAssignOp: XOR_ASSIGN  */
+#line 932 "yacc/koala.y"
+                  { (yyval.operator) = OP_XOR_ASSIGN;    }
+#line 3303 "koala_yacc.c"
+    break;
+
+  case 239: /* CompAssignOp: RSHIFT_ASSIGN  */
+#line 933 "yacc/koala.y"
+                  { (yyval.operator) = OP_RSHIFT_ASSIGN; }
+#line 3309 "koala_yacc.c"
+    break;
+
+  case 240: /* CompAssignOp: LSHIFT_ASSIGN  */
+#line 934 "yacc/koala.y"
+                  { (yyval.operator) = OP_LSHIFT_ASSIGN; }
+#line 3315 "koala_yacc.c"
+    break;
+
+
+#line 3319 "koala_yacc.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (ps, scanner, YY_("syntax error"));
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, ps, scanner);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, ps, scanner);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (ps, scanner, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, ps, scanner);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, ps, scanner);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 937 "yacc/koala.y"
+
+
+int check_assignment(ParserState *ps, int ids, int exprs)
+{
+  if (ids < exprs) {
+    //var a = foo(), 100; whatever foo() is single or multi values
+    PSError("extra expression in var declaration");
+    return -1;
+  }
+
+  if (ids > exprs) {
+    /*
+     1. exprs > 1, it has an error
+     2. exprs == 1, it's partially ok and must be a multi-values exprs
+     3. exprs == 0, it's ok
+    */
+    if (exprs > 1) {
+      PSError("missing expression in var declaration");
+      return -1;
+    }
+  }
+
+  /*
+    if ids is equal with exprs, it MAYBE ok and will be checked in later
+  */
+  return 0;
+}
+
+stmt_t *do_vardecls(ParserState *ps, Vector *ids, TypeDesc *desc, Vector *exprs,
+                    int bconst)
+{
+  int isz = Vector_Size(ids);
+  int esz = Vector_Size(exprs);
+  if (check_assignment(ps, isz, esz)) {
+    return NULL;
+  }
+
+  if (isz == esz) {
+    stmt_t *stmt = stmt_from_list();
+    char *id;
+    stmt_t *s;
+    expr_t *e;
+    Vector_ForEach(id, ids) {
+      e = Vector_Get(exprs, i);
+      s = stmt_from_var(id, desc, e, bconst);
+      Vector_Append(&stmt->list, s);
+    }
+    return stmt;
+  } else {
+    assert(isz > esz && esz <= 1);
+    if (esz == 1) {
+      expr_t *e = Vector_Get(exprs, 0);
+      return stmt_from_varlist(ids, desc, e, bconst);
+    } else {
+      assert(!exprs);
+      stmt_t *stmt = stmt_from_list();
+      char *id;
+      stmt_t *s;
+      Vector_ForEach(id, ids) {
+        s = stmt_from_var(id, desc, NULL, bconst);
+        Vector_Append(&stmt->list, s);
+      }
+      return stmt;
+    }
+  }
+}
+
+stmt_t *do_assignments(ParserState *ps, Vector *left, Vector *right)
+{
+  int lsz = Vector_Size(left);
+  int rsz = Vector_Size(right);
+  if (check_assignment(ps, lsz, rsz)) {
+    return NULL;
+  }
+
+  if (lsz == rsz) {
+    stmt_t *stmt = stmt_from_list();
+    stmt_t *s;
+    expr_t *le;
+    expr_t *re;
+    Vector_ForEach(le, left) {
+      re = Vector_Get(right, i);
+      s = stmt_from_assign(le, OP_ASSIGN, re);
+      Vector_Append(&stmt->list, s);
+    }
+    return stmt;
+  } else {
+    assert(lsz > rsz && rsz <= 1);
+    expr_t *e;
+    if (rsz == 1) e = Vector_Get(right, 0);
+    else e = NULL;
+    return stmt_from_assignlist(left, e);
+  }
+}
+
+TypeDesc *do_usrdef_type(ParserState *ps, char *id, char *type)
+{
+  char *fullpath = NULL;
+  if (id) {
+    fullpath = Parser_Get_FullPath(ps, id);
+    if (!fullpath) {
+      PSError("cannot find package: '%s'", id);
+      return NULL;
+    }
+  }
+  return Type_New_UsrDef(fullpath, type);
+}
+
+TypeDesc *do_array_type(TypeDesc *base)
+{
+  if (base->kind != TYPE_ARRAY)
+    return Type_New_Array(1, base);
+  else
+    return Type_New_Array(base->array.dims + 1, base);
+}
+
+expr_t *do_array_initializer(ParserState *ps, Vector *explist)
+{
+  expr_t *e;
+  expr_t *e0 = Vector_Get(explist, 0);
+  Vector_ForEach(e, explist) {
+    if (!Type_Equal(e->desc, e0->desc)) {
+      PSError("element's type of array must be the same");
+      return NULL;
+    }
+    e->ctx = EXPR_LOAD;
+  }
+
+  expr_t *exp = expr_from_array(explist);
+  int dims = 1;
+  if (Type_IsArray(e0->desc)) dims = 1 + e0->desc->array.dims;
+  exp->desc = Type_New_Array(dims, Type_Dup(e0->desc));
+  return exp;
+}
+
+
+/******************************************************************************/
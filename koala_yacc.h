@@ -0,0 +1,172 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_KOALA_YACC_H_INCLUDED
+# define YY_YY_KOALA_YACC_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 1
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    TYPELESS_ASSIGN = 258,         /* TYPELESS_ASSIGN  */
+    PLUS_ASSGIN = 259,             /* PLUS_ASSGIN  */
+    MINUS_ASSIGN = 260,            /* MINUS_ASSIGN  */
+    MULT_ASSIGN = 261,             /* MULT_ASSIGN  */
+    DIV_ASSIGN = 262,              /* DIV_ASSIGN  */
+    MOD_ASSIGN = 263,              /* MOD_ASSIGN  */
+    AND_ASSIGN = 264,              /* AND_ASSIGN  */
+    OR_ASSIGN = 265,               /* OR_ASSIGN  */
+    XOR_ASSIGN = 266,              /* XOR_ASSIGN  */
+    RSHIFT_ASSIGN = 267,           /* RSHIFT_ASSIGN  */
+    LSHIFT_ASSIGN = 268,           /* LSHIFT_ASSIGN  */
+    POWER = 269,                   /* POWER  */
+    ELLIPSIS = 270,                /* ELLIPSIS  */
+    DOTDOTLESS = 271,              /* DOTDOTLESS  */
+    BY = 272,                      /* BY  */
+    EQ = 273,                      /* EQ  */
+    NE = 274,                      /* NE  */
+    GE = 275,                      /* GE  */
+    LE = 276,                      /* LE  */
+    AND = 277,                     /* AND  */
+    OR = 278,                      /* OR  */
+    NOT = 279,                     /* NOT  */
+    LSHIFT = 280,                  /* LSHIFT  */
+    RSHIFT = 281,                  /* RSHIFT  */
+    IF = 282,                      /* IF  */
+    ELSE = 283,                    /* ELSE  */
+    WHILE = 284,                   /* WHILE  */
+    DO = 285,                      /* DO  */
+    FOR = 286,                     /* FOR  */
+    IN = 287,                      /* IN  */
+    SWITCH = 288,                  /* SWITCH  */
+    CASE = 289,                    /* CASE  */
+    BREAK = 290,                   /* BREAK  */
+    FALLTHROUGH = 291,             /* FALLTHROUGH  */
+    CONTINUE = 292,                /* CONTINUE  */
+    DEFAULT = 293,                 /* DEFAULT  */
+    VAR = 294,                     /* VAR  */
+    FUNC = 295,                    /* FUNC  */
+    TOKEN_RETURN = 296,            /* TOKEN_RETURN  */
+    CLASS = 297,                   /* CLASS  */
+    TRAIT = 298,                   /* TRAIT  */
+    EXTENDS = 299,                 /* EXTENDS  */
+    WITH = 300,                    /* WITH  */
+    CONST = 301,                   /* CONST  */
+    PACKAGE = 302,                 /* PACKAGE  */
+    IMPORT = 303,                  /* IMPORT  */
+    AS = 304,                      /* AS  */
+    GO = 305,                      /* GO  */
+    DEFER = 306,                   /* DEFER  */
+    NEWLINE = 307,                 /* NEWLINE  */
+    TYPEALIAS = 308,               /* TYPEALIAS  */
+    SYSCALL = 309,                 /* SYSCALL  */
+    CHAR = 310,                    /* CHAR  */
+    BYTE = 311,                    /* BYTE  */
+    INTEGER = 312,                 /* INTEGER  */
+    FLOAT = 313,                   /* FLOAT  */
+    BOOL = 314,                    /* BOOL  */
+    STRING = 315,                  /* STRING  */
+    ANY = 316,                     /* ANY  */
+    SELF = 317,                    /* SELF  */
+    SUPER = 318,                   /* SUPER  */
+    TOKEN_NIL = 319,               /* TOKEN_NIL  */
+    TOKEN_TRUE = 320,              /* TOKEN_TRUE  */
+    TOKEN_FALSE = 321,             /* TOKEN_FALSE  */
+    TYPEOF = 322,                  /* TYPEOF  */
+    BYTE_CONST = 323,              /* BYTE_CONST  */
+    CHAR_CONST = 324,              /* CHAR_CONST  */
+    INT_CONST = 325,               /* INT_CONST  */
+    HEX_CONST = 326,               /* HEX_CONST  */
+    OCT_CONST = 327,               /* OCT_CONST  */
+    FLOAT_CONST = 328,             /* FLOAT_CONST  */
+    STRING_CONST = 329,            /* STRING_CONST  */
+    ID = 330                       /* ID  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 39 "yacc/koala.y"
+
+  char *id;
+  int64 ival;
+  float64 fval;
+  char *string_const;
+  int dims;
+  expr_t *expr;
+  Vector *list;
+  stmt_t *stmt;
+  TypeDesc *type;
+  int operator;
+  struct field *field;
+  struct test_block *testblock;
+
+#line 154 "koala_yacc.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+
+
+int yyparse (ParserState *ps, void *scanner);
+
+/* "%code provides" blocks.  */
+#line 205 "yacc/koala.y"
+ int yylex(YYSTYPE *yylval_param, void *yyscanner); 
+
+#line 171 "koala_yacc.h"
+
+#endif /* !YY_YY_KOALA_YACC_H_INCLUDED  */
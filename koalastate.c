@@ -7,6 +7,9 @@
 #include "routine.h"
 #include "gc.h"
 #include "klc.h"
+#include "verify.h"
+#include "profile.h"
+#include "stats.h"
 #include "log.h"
 #include "koalastate.h"
 #include "listobject.h"
@@ -539,6 +542,60 @@ static Object *__get_consts(KImage *image)
   return tuple;
 }
 
+static Klass *image_klass(AtomTable *table, Object *m, int32 index)
+{
+  TypeItem *type = TypeItem_Index(table, index);
+  StringItem *id = StringItem_Index(table, type->typeindex);
+  return Module_Get_ClassOrTrait(m, id->data);
+}
+
+/*
+  Verify the functions and methods after all of them are loaded, so the
+  calls among them are resolved. Returns -1 if any of them is invalid.
+ */
+static int verify_module(AtomTable *table, Object *m)
+{
+  int sz;
+  int res = 0;
+  int verified = 0;
+  int total = 0;
+  StringItem *id;
+  Klass *klazz;
+  Object *code;
+
+  sz = AtomTable_Size(table, ITEM_FUNC);
+  FuncItem *func;
+  for (int i = 0; i < sz; i++) {
+    func = AtomTable_Get(table, ITEM_FUNC, i);
+    id = StringItem_Index(table, func->nameindex);
+    code = Module_Get_Function(m, id->data);
+    if (!code || !CODE_ISKFUNC(code)) continue;
+    res = KFunc_Verify(code, m, NULL, id->data);
+    if (res == VERIFY_FAILED) return -1;
+    if (res == VERIFY_OK) verified++;
+    total++;
+  }
+
+  sz = AtomTable_Size(table, ITEM_METHOD);
+  MethodItem *mth;
+  for (int i = 0; i < sz; i++) {
+    mth = AtomTable_Get(table, ITEM_METHOD, i);
+    klazz = image_klass(table, m, mth->classindex);
+    if (!klazz) continue;
+    id = StringItem_Index(table, mth->nameindex);
+    code = Klass_Get_Method(klazz, id->data, NULL);
+    if (!code || !CODE_ISKFUNC(code)) continue;
+    res = KFunc_Verify(code, m, klazz, id->data);
+    if (res == VERIFY_FAILED) return -1;
+    if (res == VERIFY_OK) verified++;
+    total++;
+  }
+
+  debug("module '%s': %d of %d functions verified", Module_Name(m),
+        verified, total);
+  return 0;
+}
+
 static Object *module_from_image(char *path, KImage *image)
 {
   AtomTable *table = image->table;
@@ -549,6 +606,11 @@ static Object *module_from_image(char *path, KImage *image)
   load_functions(table, m);
   load_traits(table, m);
   load_classes(table, m);
+  if (verify_module(table, m) < 0) {
+    error("verify module '%s' failed", path);
+    Module_Free(m);
+    return NULL;
+  }
   return m;
 }
 
@@ -688,5 +750,8 @@ static void __mod_entry_free_fn(HashNode *hnode, void *arg)
 
 void Koala_Finalize(void)
 {
+  Profile_Stop();
+  Stats_Dump();
+  Routine_Show_CallStats();
   HashTable_Fini(&gs.modules, __mod_entry_free_fn, NULL);
 }
@@ -2,18 +2,19 @@
 #include "listobject.h"
 #include "tupleobject.h"
 #include "stringobject.h"
+#include "gc.h"
+#include "slab.h"
 #include "log.h"
 
 Object *List_New(Klass *klazz)
 {
   int sz = sizeof(ListObject);
-  ListObject *list = malloc(sz);
-  assert(list);
+  ListObject *list = Slab_Alloc(sz);
   Init_Object_Head(list, &List_Klass);
   list->size = 0;
   list->type = klazz;
   list->capacity = LIST_DEFAULT_SIZE;
-  list->items = malloc(sizeof(TValue) * LIST_DEFAULT_SIZE);
+  list->items = Slab_Alloc(sizeof(TValue) * LIST_DEFAULT_SIZE);
   for (int i = 0; i < LIST_DEFAULT_SIZE; i++) {
     initnilvalue(list->items + i);
   }
@@ -24,8 +25,8 @@ void List_Free(Object *ob)
 {
   if (!ob) return;
   ListObject *list = OB_TYPE_OF(ob, ListObject, List_Klass);
-  free(list->items);
-  free(list);
+  Slab_Free(list->items, sizeof(TValue) * list->capacity);
+  Slab_Free(list, sizeof(ListObject));
 }
 
 int List_Set(Object *ob, int index, TValue *val)
@@ -42,6 +43,7 @@ int List_Set(Object *ob, int index, TValue *val)
 
   list->size++;
 
+  GC_Write_Barrier(ob, val);
   list->items[index] = *val;
   return 0;
 }
@@ -148,7 +150,7 @@ static Object *list_tostring(TValue *val)
 {
   //FIXME
   char buf[128];
-  ListObject *lo = val->ob;
+  ListObject *lo = (ListObject *)VALUE_OBJECT(val);
   int count = 0;
   TValue *v;
   count = snprintf(buf, 127, "[");
@@ -162,6 +164,14 @@ static Object *list_tostring(TValue *val)
   return Tuple_Build("O", String_New(buf));
 }
 
+static void list_mark(Object *ob)
+{
+  ListObject *list = OB_TYPE_OF(ob, ListObject, List_Klass);
+  int size = min(list->size, list->capacity);
+  for (int i = 0; i < size; i++)
+    GC_Mark_Value(list->items + i);
+}
+
 static void list_free(Object *ob)
 {
   List_Free(ob);
@@ -169,12 +179,12 @@ static void list_free(Object *ob)
 
 void list_setitem(TValue *o, TValue *k, TValue *v)
 {
-  List_Set(o->ob, k->ival, v);
+  List_Set(VALUE_OBJECT(o), VALUE_INT(k), v);
 }
 
 TValue list_getitem(TValue *o, TValue *k)
 {
-  return List_Get(o->ob, k->ival);
+  return List_Get(VALUE_OBJECT(o), VALUE_INT(k));
 }
 
 MapOperations list_map_ops = {
@@ -187,6 +197,7 @@ Klass List_Klass = {
   .name = "List",
   .basesize = sizeof(ListObject),
   .mapops = &list_map_ops,
+  .ob_mark = list_mark,
   .ob_free = list_free,
   .ob_tostr = list_tostring,
 };
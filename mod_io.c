@@ -4,27 +4,27 @@
 #include "koalastate.h"
 #include "log.h"
 
-static Object *__io_print(Object *ob, Object *args)
+static int __io_print(Object *ob, TValue *argv, int argc, TValue *ret,
+                      int nret)
 {
   UNUSED_PARAMETER(ob);
-  if (!args) {
+  UNUSED_PARAMETER(ret);
+  UNUSED_PARAMETER(nret);
+  if (argc <= 0) {
     fprintf(stdout, "(nil)\n");
-    return NULL;
+    return 0;
   }
 
 #define BUF_SIZE  512
 
   char temp[BUF_SIZE] = {0};
   char *buf = temp;
-  int sz = Tuple_Size(args);
-  debug("io.Print, argc:%d", sz);
-  TValue val;
+  debug("io.Print, argc:%d", argc);
   int avail = 0;
-  for (int i = 0; i < sz; i++) {
-    val = Tuple_Get(args, i);
-    avail = TValue_Print(buf, BUF_SIZE - (buf - temp), &val, 1);
+  for (int i = 0; i < argc; i++) {
+    avail = TValue_Print(buf, BUF_SIZE - (buf - temp), argv + i, 1);
     buf += avail;
-    if (i + 1 < sz) {
+    if (i + 1 < argc) {
       avail = snprintf(buf, BUF_SIZE - (buf - temp), " ");
       buf += avail;
     }
@@ -33,18 +33,19 @@ static Object *__io_print(Object *ob, Object *args)
 
   fwrite(temp, strlen(temp), 1, stdout);
   fflush(stdout);
-  return NULL;
+  return 0;
 }
 
-static Object *__io_println(Object *ob, Object *args)
+static int __io_println(Object *ob, TValue *argv, int argc, TValue *ret,
+                        int nret)
 {
-  __io_print(ob, args);
+  __io_print(ob, argv, argc, ret, nret);
   fwrite("\n", 1, 1, stdout);
   fflush(stdout);
-  return NULL;
+  return 0;
 }
 
-static FuncDef io_funcs[] = {
+static NFuncDef io_funcs[] = {
   {"Print", NULL, "...", __io_print},
   {"Println", NULL, "...", __io_println},
   {NULL}
@@ -54,5 +55,5 @@ void Init_IO_Module(void)
 {
   Object *ob = Koala_New_Module("io", "koala/io");
   assert(ob);
-  Module_Add_CFunctions(ob, io_funcs);
+  Module_Add_NFunctions(ob, io_funcs);
 }
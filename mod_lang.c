@@ -16,7 +16,7 @@ static Object *__lang_typeof(Object *ob, Object *args)
 	if (size == 1) {
 		debug("typeof(obj)");
 		TValue val = Tuple_Get(args, 0);
-		Object *o = val.ob;
+		Object *o = VALUE_OBJECT(&val);
 		return Tuple_Build("O", OB_KLASS(o));
 	} else {
 		assert(size == 2);
@@ -25,24 +25,29 @@ static Object *__lang_typeof(Object *ob, Object *args)
 	}
 }
 
-static Object *__string_concat(Object *ob, Object *args)
+static int __string_concat(Object *ob, TValue *argv, int argc, TValue *ret,
+	int nret)
 {
 	OB_ASSERT_KLASS(ob, Module_Klass);
-	TValue v1 = Tuple_Get(args, 0);
-	TValue v2 = Tuple_Get(args, 1);
-	assert(v1.klazz == &String_Klass);
-	StringObject *s1 = (StringObject *)v1.ob;
-	assert(v2.klazz == &String_Klass);
-	StringObject *s2 = (StringObject *)v2.ob;
+	assert(argc == 2 && nret >= 1);
+	assert(VALUE_KLASS(argv) == &String_Klass);
+	StringObject *s1 = (StringObject *)VALUE_OBJECT(argv);
+	assert(VALUE_KLASS(argv + 1) == &String_Klass);
+	StringObject *s2 = (StringObject *)VALUE_OBJECT(argv + 1);
 	char buf[s1->len + s2->len + 1];
 	strcpy(buf, s1->str);
 	strcat(buf, s2->str);
 	Object *res = String_New(buf);
-	return Tuple_Build("O", res);
+	setobjvalue(ret, res);
+	return 1;
 }
 
 static FuncDef lang_funcs[] = {
 	{"TypeOf", "Okoala/lang.Class;", "...", __lang_typeof},
+	{NULL}
+};
+
+static NFuncDef lang_nfuncs[] = {
 	{"Concat", "s", "ss", __string_concat},
 	{NULL}
 };
@@ -52,6 +57,7 @@ void Init_Lang_Module(void)
 	Object *m = Koala_New_Module("lang", "koala/lang");
 	assert(m);
 	Module_Add_CFunctions(m, lang_funcs);
+	Module_Add_NFunctions(m, lang_nfuncs);
 
 	Module_Add_Class(m, &String_Klass);
 	Module_Add_Class(m, &Tuple_Klass);
@@ -1,6 +1,7 @@
 
 #include "moduleobject.h"
 #include "tupleobject.h"
+#include "gc.h"
 #include "log.h"
 
 /*-------------------------------------------------------------------------*/
@@ -58,6 +59,8 @@ int Module_Add_Func(Object *ob, char *name, Object *code)
 	int res = HashTable_Insert(__get_table(m), &member->hnode);
 	if (!res) {
 		member->code = code;
+		co->name = member->name;
+		co->owner = ob;
 		if (CODE_ISKFUNC(code)) {
 			co->kf.consts = m->consts;
 		}
@@ -77,6 +80,15 @@ int Module_Add_CFunc(Object *ob, FuncDef *f)
 	return Module_Add_Func(ob, f->name, code);
 }
 
+int Module_Add_NFunc(Object *ob, NFuncDef *f)
+{
+	Vector *rdesc = CString_To_TypeList(f->rdesc);
+	Vector *pdesc = CString_To_TypeList(f->pdesc);
+	TypeDesc *proto = Type_New_Proto(pdesc, rdesc);
+	Object *code = NFunc_New(f->fn, proto);
+	return Module_Add_Func(ob, f->name, code);
+}
+
 int Module_Add_Class(Object *ob, Klass *klazz)
 {
 	ModuleObject *m = OBJ_TO_MOD(ob);
@@ -210,8 +222,26 @@ int Module_Add_CFunctions(Object *ob, FuncDef *funcs)
 	return 0;
 }
 
+int Module_Add_NFunctions(Object *ob, NFuncDef *funcs)
+{
+	int res;
+	NFuncDef *f = funcs;
+	while (f->name) {
+		res = Module_Add_NFunc(ob, f);
+		assert(res == 0);
+		++f;
+	}
+	return 0;
+}
+
 /*-------------------------------------------------------------------------*/
 
+static void module_mark(Object *ob)
+{
+	ModuleObject *m = OBJ_TO_MOD(ob);
+	if (m->values) GC_Mark(m->values);
+}
+
 static void module_free(Object *ob)
 {
 	Module_Free(ob);
@@ -221,5 +251,6 @@ Klass Module_Klass = {
 	OBJECT_HEAD_INIT(&Module_Klass, &Klass_Klass)
 	.name = "Module",
 	.basesize = sizeof(ModuleObject),
+	.ob_mark = module_mark,
 	.ob_free = module_free
 };
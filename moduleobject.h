@@ -29,6 +29,7 @@ void Module_Free(Object *ob);
 int Module_Add_Var(Object *ob, char *name, TypeDesc *desc, int bconst);
 int Module_Add_Func(Object *ob, char *name, Object *code);
 int Module_Add_CFunc(Object *ob, FuncDef *f);
+int Module_Add_NFunc(Object *ob, NFuncDef *f);
 int Module_Add_Class(Object *ob, Klass *klazz);
 int Module_Add_Trait(Object *ob, Klass *klazz);
 TValue Module_Get_Value(Object *ob, char *name);
@@ -38,6 +39,7 @@ Klass *Module_Get_Class(Object *ob, char *name);
 Klass *Module_Get_Trait(Object *ob, char *name);
 Klass *Module_Get_ClassOrTrait(Object *ob, char *name);
 int Module_Add_CFunctions(Object *ob, FuncDef *funcs);
+int Module_Add_NFunctions(Object *ob, NFuncDef *funcs);
 #define Module_Name(ob) (((ModuleObject *)(ob))->name)
 
 #ifdef __cplusplus
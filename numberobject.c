@@ -1,6 +1,7 @@
 
 #include "numberobject.h"
 #include "stringobject.h"
+#include "log.h"
 
 static int hexavalue (int c) {
   if (isdigit(c)) return c - '0';
@@ -54,7 +55,7 @@ static int str2flt(char *s, float64 *result)
 TValue int_add_string(TValue *v1, TValue *v2)
 {
 	TValue v;
-	StringObject *strobj = (StringObject *)v2->ob;
+	StringObject *strobj = (StringObject *)VALUE_OBJECT(v2);
 	uint64 i = 0;
 	float64 f = 0.0L;
 	if (!str2int(strobj->str, &i)) {
@@ -72,15 +73,15 @@ TValue int_add_string(TValue *v1, TValue *v2)
 static TValue int_add(TValue *v1, TValue *v2)
 {
   TValue v = NilValue;
-	assert(v1->klazz == &Int_Klass);
-	if (v2->klazz == &Int_Klass) {
+	VALUE_ASSERT_INT(v1);
+	if (VALUE_ISINT(v2)) {
     uint64 i = (uint64)VALUE_INT(v1) + (uint64)VALUE_INT(v2);
     setivalue(&v, i);
-	} else if (v2->klazz == &Float_Klass) {
+	} else if (VALUE_ISFLOAT(v2)) {
     float64 f = (float64)VALUE_INT(v1) + (float64)VALUE_FLOAT(v2);
     setfltvalue(&v, f);
 	} else {
-		kassert(0, "int_add:not supported with %s", v2->klazz->name);
+		kassert(0, "int_add:not supported with %s", VALUE_KLASS(v2)->name);
 	}
   return v;
 }
@@ -88,15 +89,15 @@ static TValue int_add(TValue *v1, TValue *v2)
 static TValue int_sub(TValue *v1, TValue *v2)
 {
   TValue v = NilValue;
-	assert(v1->klazz == &Int_Klass);
-	if (v2->klazz == &Int_Klass) {
+	VALUE_ASSERT_INT(v1);
+	if (VALUE_ISINT(v2)) {
     uint64 i = (uint64)VALUE_INT(v1) - (uint64)VALUE_INT(v2);
     setivalue(&v, i);
-	} else if (v2->klazz == &Float_Klass) {
+	} else if (VALUE_ISFLOAT(v2)) {
     float64 f = (float64)VALUE_INT(v1) - (float64)VALUE_FLOAT(v2);
     setfltvalue(&v, f);
 	} else {
-		kassert(0, "int_sub:not supported with %s", v2->klazz->name);
+		kassert(0, "int_sub:not supported with %s", VALUE_KLASS(v2)->name);
 	}
   return v;
 }
@@ -104,15 +105,15 @@ static TValue int_sub(TValue *v1, TValue *v2)
 static TValue int_mul(TValue *v1, TValue *v2)
 {
   TValue v = NilValue;
-	assert(v1->klazz == &Int_Klass);
-	if (v2->klazz == &Int_Klass) {
+	VALUE_ASSERT_INT(v1);
+	if (VALUE_ISINT(v2)) {
     uint64 i = (uint64)VALUE_INT(v1) * (uint64)VALUE_INT(v2);
     setivalue(&v, i);
-	} else if (v2->klazz == &Float_Klass) {
+	} else if (VALUE_ISFLOAT(v2)) {
     float64 f = (float64)VALUE_INT(v1) * (float64)VALUE_FLOAT(v2);
     setfltvalue(&v, f);
 	} else {
-		kassert(0, "int_mul:not supported with %s", v2->klazz->name);
+		kassert(0, "int_mul:not supported with %s", VALUE_KLASS(v2)->name);
 	}
   return v;
 }
@@ -120,15 +121,18 @@ static TValue int_mul(TValue *v1, TValue *v2)
 static TValue int_div(TValue *v1, TValue *v2)
 {
   TValue v = NilValue;
-	assert(v1->klazz == &Int_Klass);
-	if (v2->klazz == &Int_Klass) {
-    uint64 i = (uint64)VALUE_INT(v1) / (uint64)VALUE_INT(v2);
-    setivalue(&v, i);
-	} else if (v2->klazz == &Float_Klass) {
+	VALUE_ASSERT_INT(v1);
+	if (VALUE_ISINT(v2)) {
+    if (!VALUE_INT(v2)) {
+      error("int_div: divided by zero");
+      exit(-1);
+    }
+    setivalue(&v, Int_Div(VALUE_INT(v1), VALUE_INT(v2)));
+	} else if (VALUE_ISFLOAT(v2)) {
     float64 f = (float64)VALUE_INT(v1) / (float64)VALUE_FLOAT(v2);
     setfltvalue(&v, f);
 	} else {
-		kassert(0, "int_div:not supported with %s", v2->klazz->name);
+		kassert(0, "int_div:not supported with %s", VALUE_KLASS(v2)->name);
 	}
   return v;
 }
@@ -136,15 +140,18 @@ static TValue int_div(TValue *v1, TValue *v2)
 static TValue int_mod(TValue *v1, TValue *v2)
 {
   TValue v = NilValue;
-	assert(v1->klazz == &Int_Klass);
-	if (v2->klazz == &Int_Klass) {
-    uint64 i = (uint64)VALUE_INT(v1) % (uint64)VALUE_INT(v2);
-    setivalue(&v, i);
-	} else if (v2->klazz == &Float_Klass) {
+	VALUE_ASSERT_INT(v1);
+	if (VALUE_ISINT(v2)) {
+    if (!VALUE_INT(v2)) {
+      error("int_mod: divided by zero");
+      exit(-1);
+    }
+    setivalue(&v, Int_Mod(VALUE_INT(v1), VALUE_INT(v2)));
+	} else if (VALUE_ISFLOAT(v2)) {
     float64 f = 0; //FIXME (float64)VALUE_INT(v1) % (float64)VALUE_FLOAT(v2);
     setfltvalue(&v, f);
 	} else {
-		kassert(0, "int_mod:not supported with %s", v2->klazz->name);
+		kassert(0, "int_mod:not supported with %s", VALUE_KLASS(v2)->name);
 	}
   return v;
 }
@@ -152,12 +159,61 @@ static TValue int_mod(TValue *v1, TValue *v2)
 static TValue int_neg(TValue *v1)
 {
   TValue v = NilValue;
-	assert(v1->klazz == &Int_Klass);
+	VALUE_ASSERT_INT(v1);
   uint64 i = 0 - VALUE_INT(v1);
   setivalue(&v, i);
   return v;
 }
 
+#define INT_COMPARE_FUNC(_name_, _op_) \
+static TValue int_##_name_(TValue *v1, TValue *v2) \
+{ \
+  TValue v = NilValue; \
+	VALUE_ASSERT_INT(v1); \
+	if (VALUE_ISINT(v2)) { \
+    setbvalue(&v, VALUE_INT(v1) _op_ VALUE_INT(v2)); \
+	} else if (VALUE_ISFLOAT(v2)) { \
+    setbvalue(&v, (float64)VALUE_INT(v1) _op_ VALUE_FLOAT(v2)); \
+	} else { \
+		kassert(0, "int_" #_name_ ":not supported with %s", VALUE_KLASS(v2)->name); \
+	} \
+  return v; \
+}
+
+INT_COMPARE_FUNC(gt, >)
+INT_COMPARE_FUNC(ge, >=)
+INT_COMPARE_FUNC(lt, <)
+INT_COMPARE_FUNC(le, <=)
+INT_COMPARE_FUNC(eq, ==)
+INT_COMPARE_FUNC(neq, !=)
+
+/* bitwise operations are of Ints only */
+#define INT_BIT_FUNC(_name_, _expr_) \
+static TValue int_##_name_(TValue *v1, TValue *v2) \
+{ \
+  TValue v = NilValue; \
+	VALUE_ASSERT_INT(v1); \
+	VALUE_ASSERT_INT(v2); \
+  int64 a = VALUE_INT(v1); \
+  int64 b = VALUE_INT(v2); \
+  setivalue(&v, _expr_); \
+  return v; \
+}
+
+INT_BIT_FUNC(bit_and, a & b)
+INT_BIT_FUNC(bit_or, a | b)
+INT_BIT_FUNC(bit_xor, a ^ b)
+INT_BIT_FUNC(lshift, Int_Lshift(a, b))
+INT_BIT_FUNC(rshift, Int_Rshift(a, b))
+
+static TValue int_bit_not(TValue *v1)
+{
+  TValue v = NilValue;
+	VALUE_ASSERT_INT(v1);
+  setivalue(&v, ~VALUE_INT(v1));
+  return v;
+}
+
 NumberOperations int_ops = {
 	.add = int_add,
   .sub = int_sub,
@@ -165,24 +221,18 @@ NumberOperations int_ops = {
   .div = int_div,
   .mod = int_mod,
   .neg = int_neg,
-  /*
-  .gt = int_gt,
-  .lt = int_lt,
-  .ge = int_ge,
-  .le = int_le,
-  .eq = int_eq,
-
+  .gt  = int_gt,
+  .ge  = int_ge,
+  .lt  = int_lt,
+  .le  = int_le,
+  .eq  = int_eq,
+  .neq = int_neq,
   .band = int_bit_and,
   .bor  = int_bit_or,
   .bxor = int_bit_xor,
-  .binvert = int_bit_invert,
-  .blshift = int_lshift,
-  .brshift = int_rshift,
-
-  .land = int_logic_and,
-  .lor  = int_logic_or,
-  .lnot = int_logic_not,
-  */
+  .bnot = int_bit_not,
+  .lshift = int_lshift,
+  .rshift = int_rshift,
 };
 
 Klass Int_Klass = {
@@ -197,15 +247,15 @@ Klass Int_Klass = {
 static TValue float_add(TValue *v1, TValue *v2)
 {
   TValue v = NilValue;
-	assert(v1->klazz == &Float_Klass);
-	if (v2->klazz == &Int_Klass) {
+	VALUE_ASSERT_FLOAT(v1);
+	if (VALUE_ISINT(v2)) {
     float64 f = (float64)VALUE_FLOAT(v1) + (uint64)VALUE_INT(v2);
     setfltvalue(&v, f);
-	} else if (v2->klazz == &Float_Klass) {
+	} else if (VALUE_ISFLOAT(v2)) {
     float64 f = (float64)VALUE_FLOAT(v1) + (float64)VALUE_FLOAT(v2);
     setfltvalue(&v, f);
 	} else {
-		kassert(0, "float_add:not supported with %s", v2->klazz->name);
+		kassert(0, "float_add:not supported with %s", VALUE_KLASS(v2)->name);
 	}
   return v;
 }
@@ -213,15 +263,15 @@ static TValue float_add(TValue *v1, TValue *v2)
 static TValue float_sub(TValue *v1, TValue *v2)
 {
   TValue v = NilValue;
-	assert(v1->klazz == &Float_Klass);
-	if (v2->klazz == &Int_Klass) {
+	VALUE_ASSERT_FLOAT(v1);
+	if (VALUE_ISINT(v2)) {
     float64 f = (float64)VALUE_FLOAT(v1) - (uint64)VALUE_INT(v2);
     setfltvalue(&v, f);
-	} else if (v2->klazz == &Float_Klass) {
+	} else if (VALUE_ISFLOAT(v2)) {
     float64 f = (float64)VALUE_FLOAT(v1) - (float64)VALUE_FLOAT(v2);
     setfltvalue(&v, f);
 	} else {
-		kassert(0, "float_sub:not supported with %s", v2->klazz->name);
+		kassert(0, "float_sub:not supported with %s", VALUE_KLASS(v2)->name);
 	}
   return v;
 }
@@ -229,15 +279,15 @@ static TValue float_sub(TValue *v1, TValue *v2)
 static TValue float_mul(TValue *v1, TValue *v2)
 {
   TValue v = NilValue;
-	assert(v1->klazz == &Float_Klass);
-	if (v2->klazz == &Int_Klass) {
+	VALUE_ASSERT_FLOAT(v1);
+	if (VALUE_ISINT(v2)) {
     float64 f = (float64)VALUE_FLOAT(v1) * (uint64)VALUE_INT(v2);
     setfltvalue(&v, f);
-	} else if (v2->klazz == &Float_Klass) {
+	} else if (VALUE_ISFLOAT(v2)) {
     float64 f = (float64)VALUE_FLOAT(v1) * (float64)VALUE_FLOAT(v2);
     setfltvalue(&v, f);
 	} else {
-		kassert(0, "int_mul:not supported with %s", v2->klazz->name);
+		kassert(0, "int_mul:not supported with %s", VALUE_KLASS(v2)->name);
 	}
   return v;
 }
@@ -245,15 +295,15 @@ static TValue float_mul(TValue *v1, TValue *v2)
 static TValue float_div(TValue *v1, TValue *v2)
 {
   TValue v = NilValue;
-	assert(v1->klazz == &Float_Klass);
-	if (v2->klazz == &Int_Klass) {
+	VALUE_ASSERT_FLOAT(v1);
+	if (VALUE_ISINT(v2)) {
     float64 f = (float64)VALUE_FLOAT(v1) / (uint64)VALUE_INT(v2);
     setfltvalue(&v, f);
-	} else if (v2->klazz == &Float_Klass) {
+	} else if (VALUE_ISFLOAT(v2)) {
     float64 f = (float64)VALUE_FLOAT(v1) / (float64)VALUE_FLOAT(v2);
     setfltvalue(&v, f);
 	} else {
-		kassert(0, "int_div:not supported with %s", v2->klazz->name);
+		kassert(0, "int_div:not supported with %s", VALUE_KLASS(v2)->name);
 	}
   return v;
 }
@@ -261,15 +311,15 @@ static TValue float_div(TValue *v1, TValue *v2)
 static TValue float_mod(TValue *v1, TValue *v2)
 {
   TValue v = NilValue;
-	assert(v1->klazz == &Float_Klass);
-	if (v2->klazz == &Int_Klass) {
+	VALUE_ASSERT_FLOAT(v1);
+	if (VALUE_ISINT(v2)) {
     float64 f = 0; //FIXME: (float64)VALUE_FLOAT(v1) % (uint64)VALUE_INT(v2);
     setfltvalue(&v, f);
-	} else if (v2->klazz == &Float_Klass) {
+	} else if (VALUE_ISFLOAT(v2)) {
     float64 f = 0; //FIXME: (float64)VALUE_FLOAT(v1) % (float64)VALUE_FLOAT(v2);
     setfltvalue(&v, f);
 	} else {
-		kassert(0, "int_mod:not supported with %s", v2->klazz->name);
+		kassert(0, "int_mod:not supported with %s", VALUE_KLASS(v2)->name);
 	}
   return v;
 }
@@ -277,12 +327,34 @@ static TValue float_mod(TValue *v1, TValue *v2)
 static TValue float_neg(TValue *v1)
 {
   TValue v = NilValue;
-	assert(v1->klazz == &Float_Klass);
+	VALUE_ASSERT_FLOAT(v1);
   float64 f = 0 - VALUE_FLOAT(v1);
   setfltvalue(&v, f);
   return v;
 }
 
+#define FLOAT_COMPARE_FUNC(_name_, _op_) \
+static TValue float_##_name_(TValue *v1, TValue *v2) \
+{ \
+  TValue v = NilValue; \
+	VALUE_ASSERT_FLOAT(v1); \
+	if (VALUE_ISINT(v2)) { \
+    setbvalue(&v, VALUE_FLOAT(v1) _op_ (float64)VALUE_INT(v2)); \
+	} else if (VALUE_ISFLOAT(v2)) { \
+    setbvalue(&v, VALUE_FLOAT(v1) _op_ VALUE_FLOAT(v2)); \
+	} else { \
+		kassert(0, "float_" #_name_ ":not supported with %s", VALUE_KLASS(v2)->name); \
+	} \
+  return v; \
+}
+
+FLOAT_COMPARE_FUNC(gt, >)
+FLOAT_COMPARE_FUNC(ge, >=)
+FLOAT_COMPARE_FUNC(lt, <)
+FLOAT_COMPARE_FUNC(le, <=)
+FLOAT_COMPARE_FUNC(eq, ==)
+FLOAT_COMPARE_FUNC(neq, !=)
+
 static NumberOperations float_ops = {
   .add = float_add,
   .sub = float_sub,
@@ -290,6 +362,12 @@ static NumberOperations float_ops = {
   .div = float_div,
   .mod = float_mod,
   .neg = float_neg,
+  .gt  = float_gt,
+  .ge  = float_ge,
+  .lt  = float_lt,
+  .le  = float_le,
+  .eq  = float_eq,
+  .neq = float_neq,
 };
 
 Klass Float_Klass = {
@@ -304,8 +382,8 @@ Klass Float_Klass = {
 TValue bool_and(TValue *v1, TValue *v2)
 {
   TValue v;
-  assert(v1->klazz == &Bool_Klass);
-  assert(v2->klazz == &Bool_Klass);
+  VALUE_ASSERT_BOOL(v1);
+  VALUE_ASSERT_BOOL(v2);
   int b = VALUE_BOOL(v1) && VALUE_BOOL(v2);
   setbvalue(&v, b);
   return v;
@@ -314,8 +392,8 @@ TValue bool_and(TValue *v1, TValue *v2)
 TValue bool_or(TValue *v1, TValue *v2)
 {
   TValue v;
-  assert(v1->klazz == &Bool_Klass);
-  assert(v2->klazz == &Bool_Klass);
+  VALUE_ASSERT_BOOL(v1);
+  VALUE_ASSERT_BOOL(v2);
   int b = VALUE_BOOL(v1) || VALUE_BOOL(v2);
   setbvalue(&v, b);
   return v;
@@ -324,13 +402,35 @@ TValue bool_or(TValue *v1, TValue *v2)
 TValue bool_not(TValue *v1)
 {
   TValue v;
-  assert(v1->klazz == &Bool_Klass);
+  VALUE_ASSERT_BOOL(v1);
   int b = !VALUE_BOOL(v1);
   setbvalue(&v, b);
   return v;
 }
 
+TValue bool_eq(TValue *v1, TValue *v2)
+{
+  TValue v;
+  VALUE_ASSERT_BOOL(v1);
+  VALUE_ASSERT_BOOL(v2);
+  int b = VALUE_BOOL(v1) == VALUE_BOOL(v2);
+  setbvalue(&v, b);
+  return v;
+}
+
+TValue bool_neq(TValue *v1, TValue *v2)
+{
+  TValue v;
+  VALUE_ASSERT_BOOL(v1);
+  VALUE_ASSERT_BOOL(v2);
+  int b = VALUE_BOOL(v1) != VALUE_BOOL(v2);
+  setbvalue(&v, b);
+  return v;
+}
+
 static NumberOperations bool_ops = {
+  .eq   = bool_eq,
+  .neq  = bool_neq,
   .land = bool_and,
   .lor  = bool_or,
   .lnot = bool_not,
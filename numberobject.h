@@ -12,6 +12,32 @@ extern Klass Int_Klass;
 extern Klass Float_Klass;
 extern Klass Bool_Klass;
 
+/*
+  Int division truncated toward zero, 'b' is not zero.
+  INT64_MIN / -1 wraps around as the other Int operations do.
+ */
+static inline int64 Int_Div(int64 a, int64 b)
+{
+  return (b == -1) ? (int64)(0 - (uint64)a) : a / b;
+}
+
+/* the remainder of Int_Div(), with the sign of 'a' */
+static inline int64 Int_Mod(int64 a, int64 b)
+{
+  return (b == -1) ? 0 : a % b;
+}
+
+/* shifts out of 0..63 shift all bits out, '>>' keeps the sign */
+static inline int64 Int_Lshift(int64 a, int64 b)
+{
+  return (b < 0 || b >= 64) ? 0 : (int64)((uint64)a << b);
+}
+
+static inline int64 Int_Rshift(int64 a, int64 b)
+{
+  return (b < 0 || b >= 64) ? (a < 0 ? -1 : 0) : a >> b;
+}
+
 #ifdef __cplusplus
 }
 #endif
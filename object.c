@@ -15,79 +15,73 @@ TValue FalseValue = BOOL_VALUE_INIT(0);
 
 static void va_integer_build(TValue *v, va_list *ap)
 {
-  v->klazz = &Int_Klass;
-  v->ival = (int64)va_arg(*ap, uint32);
+  setivalue(v, va_arg(*ap, uint32));
 }
 
 static void va_integer_parse(TValue *v, va_list *ap)
 {
-  assert(v->klazz == &Int_Klass);
+  VALUE_ASSERT_INT(v);
   int32 *i = va_arg(*ap, int32 *);
   *i = (int32)VALUE_INT(v);
 }
 
 static void va_long_build(TValue *v, va_list *ap)
 {
-  v->klazz = &Int_Klass;
-  v->ival = va_arg(*ap, uint64);
+  setivalue(v, va_arg(*ap, uint64));
 }
 
 static void va_long_parse(TValue *v, va_list *ap)
 {
-  assert(v->klazz == &Int_Klass);
+  VALUE_ASSERT_INT(v);
   int64 *i = va_arg(*ap, int64 *);
   *i = VALUE_INT(v);
 }
 
 static void va_float_build(TValue *v, va_list *ap)
 {
-  v->klazz = &Float_Klass;
-  v->fval = va_arg(*ap, float64);
+  setfltvalue(v, va_arg(*ap, float64));
 }
 
 static void va_float_parse(TValue *v, va_list *ap)
 {
-  assert(v->klazz == &Float_Klass);
+  VALUE_ASSERT_FLOAT(v);
   float64 *f = va_arg(*ap, float64 *);
   *f = VALUE_FLOAT(v);
 }
 
 static void va_bool_build(TValue *v, va_list *ap)
 {
-  v->klazz = &Bool_Klass;
-  v->bval = va_arg(*ap, int);
+  setbvalue(v, va_arg(*ap, int));
 }
 
 static void va_bool_parse(TValue *v, va_list *ap)
 {
-  assert(v->klazz == &Bool_Klass);
+  VALUE_ASSERT_BOOL(v);
   int *i = va_arg(*ap, int *);
   *i = VALUE_BOOL(v);
 }
 
 static void va_string_build(TValue *v, va_list *ap)
 {
-  v->klazz = &String_Klass;
-  v->ob = String_New(va_arg(*ap, char *));
+  setobjvalue(v, String_New(va_arg(*ap, char *)));
 }
 
 static void va_string_parse(TValue *v, va_list *ap)
 {
-  assert(v->klazz == &String_Klass);
+  assert(VALUE_KLASS(v) == &String_Klass);
   char **str = va_arg(*ap, char **);
-  *str = String_RawString(v->ob);
+  *str = String_RawString(VALUE_OBJECT(v));
 }
 
 static void va_object_build(TValue *v, va_list *ap)
 {
-  v->ob = va_arg(*ap, Object *);
-  v->klazz = OB_KLASS(v->ob);
+  setobjvalue(v, va_arg(*ap, Object *));
 }
 
 static void va_object_parse(TValue *v, va_list *ap)
 {
   Object **o = va_arg(*ap, Object **);
-  *o = v->ob;
+  *o = VALUE_OBJECT(v);
 }
 
 typedef void (*va_build_t)(TValue *v, va_list *ap);
@@ -158,11 +152,19 @@ int TValue_Parse(TValue *val, int ch, ...)
 
 /*---------------------------------------------------------------------------*/
 
+/* fields of the object and of its base and trait sub-objects */
 static void object_mark(Object *ob)
 {
   Check_Klass(OB_KLASS(ob));
   assert(OB_Head(ob) && OB_Head(ob) == ob);
-  //FIXME: ob_ref_inc
+  TValue *values;
+  while (1) {
+    values = (TValue *)(ob + 1);
+    for (int i = 0; i < ob->ob_size; i++)
+      GC_Mark_Value(values + i);
+    if (!OB_HasBase(ob)) break;
+    ob = OB_Base(ob);
+  }
 }
 
 static int get_object_size(Klass *klazz)
@@ -271,7 +273,7 @@ static void object_free(Object *ob)
 
 static uint32 object_hash(TValue *v)
 {
-  Object *ob = v->ob;
+  Object *ob = VALUE_OBJECT(v);
   Check_Klass(OB_KLASS(ob));
   assert(OB_Head(ob) && OB_Head(ob) == ob);
   return hash_uint32(ptr2int(OB_Head(ob), uint32), 32);
@@ -279,16 +281,16 @@ static uint32 object_hash(TValue *v)
 
 static int object_equal(TValue *v1, TValue *v2)
 {
-  Object *ob1 = v1->ob;
+  Object *ob1 = VALUE_OBJECT(v1);
   Check_Klass(OB_KLASS(ob1));
-  Object *ob2 = v2->ob;
+  Object *ob2 = VALUE_OBJECT(v2);
   Check_Klass(OB_KLASS(ob2));
   return OB_Head(ob1) == OB_Head(ob2);
 }
 
 static Object *object_tostring(TValue *v)
 {
-  Object *ob = v->ob;
+  Object *ob = VALUE_OBJECT(v);
   assert(OB_Head(ob) && OB_Head(ob) == ob);
   Klass *klazz = OB_KLASS(OB_Head(ob));
   char buf[128];
@@ -391,6 +393,8 @@ int Klass_Add_Method(Klass *klazz, char *name, Object *code)
   int res = HashTable_Insert(__get_table(klazz), &member->hnode);
   if (!res) {
     member->code = code;
+    co->name = member->name;
+    co->owner = (Object *)klazz;
     if (CODE_ISKFUNC(code)) {
       co->kf.consts = klazz->consts;
     }
@@ -461,7 +465,7 @@ int Klass_Add_CFunctions(Klass *klazz, FuncDef *funcs)
   while (f->name) {
     rdesc = CString_To_TypeList(f->rdesc);
     pdesc = CString_To_TypeList(f->pdesc);
-    proto = Type_New_Proto(rdesc, pdesc);
+    proto = Type_New_Proto(pdesc, rdesc);
     meth = CFunc_New(f->fn, proto);
     res = Klass_Add_Method(klazz, f->name, meth);
     assert(res == 0);
@@ -560,10 +564,31 @@ int Object_Set_Value(Object *ob, char *name, TValue *val)
   TValue *value = (TValue *)(rob + 1);
   int index = member->offset;
   assert(index >= 0 && index < rob->ob_size);
+  GC_Write_Barrier(rob, val);
   value[index] = *val;
   return 0;
 }
 
+/*
+  Resolve the field 'name' of 'ob' for inline caches.
+  Returns the field's index in the object holding it and the number of
+  OB_Base hops from 'ob' to that object.
+ */
+int Object_Field_Index(Object *ob, char *name, int *hops)
+{
+  Object *rob = NULL;
+  MemberDef *member = get_field(ob, name, &rob);
+  assert(rob);
+  int count = 0;
+  while (ob != rob) {
+    ob = OB_Base(ob);
+    count++;
+  }
+  *hops = count;
+  assert(member->offset >= 0 && member->offset < rob->ob_size);
+  return member->offset;
+}
+
 Object *Object_Get_Method(Object *ob, char *name, Object **rob)
 {
   Check_Klass(OB_KLASS(ob));
@@ -652,7 +677,7 @@ Object *Object_Get_Method(Object *ob, char *name, Object **rob)
 
 static int object_print(char *buf, int sz, TValue *val)
 {
-  Object *ob = val->ob;
+  Object *ob = VALUE_OBJECT(val);
   Klass *klazz = OB_KLASS(ob);
   MemberDef key = {.name = "ToString"};
   MemberDef *member = HashTable_Find(__get_table(klazz), &key);
@@ -664,7 +689,7 @@ static int object_print(char *buf, int sz, TValue *val)
   }
   OB_ASSERT_KLASS(ob, Tuple_Klass);
   TValue v = Tuple_Get(ob, 0);
-  return snprintf(buf, sz, "%s", String_RawString(v.ob));
+  return snprintf(buf, sz, "%s", String_RawString(VALUE_OBJECT(&v)));
 }
 
 #if 0
@@ -736,13 +761,13 @@ int TValue_Print(char *buf, int sz, TValue *val, int escape)
   }
 
   int count;
-  if (!val->klazz) {
+  if (VALUE_ISNIL(val)) {
     count = snprintf(buf, sz, "(nil)");
-  } else if (val->klazz == &Int_Klass) {
+  } else if (VALUE_ISINT(val)) {
     count = snprintf(buf, sz, "%lld", VALUE_INT(val));
-  } else if (val->klazz == &Float_Klass) {
+  } else if (VALUE_ISFLOAT(val)) {
     count = snprintf(buf, sz, "%lf", VALUE_FLOAT(val));
-  } else if (val->klazz == &Bool_Klass) {
+  } else if (VALUE_ISBOOL(val)) {
     count = snprintf(buf, sz, "%s", VALUE_BOOL(val) ? "true" : "false");
   } else {
     count = object_print(buf, sz, val);
@@ -821,8 +846,13 @@ static int check_interface_inheritance(Klass *intf, Klass *klz)
 int TValue_Check(TValue *v1, TValue *v2)
 {
   //FIXME
-  assert(v1->klazz);
-  assert(v2->klazz);
+#ifdef KOALA_NANBOX
+  /* 8-byte nil values have no class, see object.h */
+  UNUSED_PARAMETER(v1);
+#else
+  assert(VALUE_KLASS(v1));
+#endif
+  assert(VALUE_KLASS(v2));
   return 0;
 
   // if (v1->klazz != v2->klazz) {
@@ -866,16 +896,16 @@ int TValue_Check_TypeDesc(TValue *val, TypeDesc *desc)
       if (Type_IsBool(desc) && VALUE_ISBOOL(val))
         return 0;
       if (Type_IsString(desc)) {
-        Object *ob = val->ob;
+        Object *ob = VALUE_OBJECT(val);
         if (OB_CHECK_KLASS(ob, String_Klass)) return 0;
       }
       break;
     }
     case TYPE_USRDEF: {
-      Object *ob = OB_KLASS(val->ob)->module;
+      Object *ob = OB_KLASS(VALUE_OBJECT(val))->module;
       Klass *klazz = Koala_Get_Klass(ob, desc->usrdef.path, desc->usrdef.type);
       if (!klazz) return -1;
-      Klass *k = OB_KLASS(val->ob);
+      Klass *k = OB_KLASS(VALUE_OBJECT(val));
       while (k) {
         if (k == klazz) return 0;
         k = OB_HasBase(k) ? (Klass *)OB_Base(k) : NULL;
@@ -974,6 +1004,9 @@ void TValue_Set_Value(TValue *val, TValue *v)
     return;
   }
 
+#ifdef KOALA_NANBOX
+  *val = *v;
+#else
   if (v->klazz == &Int_Klass) {
     VALUE_ASSERT_INT(val);
     val->ival = v->ival;
@@ -988,6 +1021,7 @@ void TValue_Set_Value(TValue *val, TValue *v)
     //assert(v->klazz == val->klazz);
     val->ob = v->ob;
   }
+#endif
 }
 
 MemberDef *Member_New(int kind, char *name, TypeDesc *desc, int konst)
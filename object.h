@@ -2,6 +2,7 @@
 #ifndef _KOALA_OBJECT_H_
 #define _KOALA_OBJECT_H_
 
+#include <stdint.h>
 #include "common.h"
 #include "hashtable.h"
 #include "typedesc.h"
@@ -30,6 +31,104 @@ typedef struct value {
   UNION_VALUE;
 } Value;
 
+#ifdef KOALA_NANBOX
+
+/*
+  8-byte values, built with -DKOALA_NANBOX('make NANBOX=1').
+  Floats are stored as their bits plus 2^49, so the top 16 bits tell the
+  kind of a value:
+    0x0000 0000 0000 0000   nil
+    0x0000 0000 0000 0006   false
+    0x0000 0000 0000 0007   true
+    0x0000 pppp pppp pppp   object pointer
+    0x0002 .... 0xfffe      Float
+    0xffff iiii iiii iiii   Int, 48 bits
+  Ints out of 48 bits wrap, and NaNs are made canonical before boxed.
+  All-zero memory is nil, as in the 16-byte form. A nil value has no
+  class, the declared types of locvars are known to the verifier only.
+  The jit is off, its templates are of the 16-byte form.
+ */
+typedef struct tvalue {
+  uint64 bits;
+} TValue;
+
+#define NANBOX_FLOAT_OFFSET ((uint64)1 << 49)
+#define NANBOX_INT_TAG      ((uint64)0xffff << 48)
+#define NANBOX_PAYLOAD      (((uint64)1 << 48) - 1)
+#define NANBOX_FALSE        ((uint64)6)
+#define NANBOX_TRUE         ((uint64)7)
+
+static inline uint64 nanbox_float(float64 d)
+{
+  union { float64 d; uint64 u; } x = {.d = d};
+  if (d != d) x.u = 0x7ff8000000000000ULL;
+  return x.u + NANBOX_FLOAT_OFFSET;
+}
+
+static inline float64 nanbox_float_value(uint64 bits)
+{
+  union { float64 d; uint64 u; } x = {.u = bits - NANBOX_FLOAT_OFFSET};
+  return x.d;
+}
+
+/* not a macro cast, which warns on a call as its operand */
+static inline uint64 nanbox_object(void *ob)
+{
+  return (uint64)(uintptr_t)ob;
+}
+
+/* sign extended from 48 bits */
+static inline int64 nanbox_int_value(uint64 bits)
+{
+  return (int64)(bits << 16) >> 16;
+}
+
+/* Constant values */
+extern TValue NilValue;
+extern TValue TrueValue;
+extern TValue FalseValue;
+
+/* Macros to initialize struct value */
+#define initnilvalue(v) ((v)->bits = 0)
+
+#define setivalue(v, _v) \
+  ((v)->bits = NANBOX_INT_TAG | ((uint64)(int64)(_v) & NANBOX_PAYLOAD))
+
+#define setfltvalue(v, _v) ((v)->bits = nanbox_float((float64)(_v)))
+
+#define setbvalue(v, _v) ((v)->bits = (_v) ? NANBOX_TRUE : NANBOX_FALSE)
+
+/* nil of object's type is only nil */
+#define setobjtype(v, _klazz) ((void)(_klazz), initnilvalue(v))
+
+#define setobjvalue(v, _v) ((v)->bits = nanbox_object(_v))
+
+/* the object is dropped, the value is the nil of its type */
+#define clearobjvalue(v) initnilvalue(v)
+
+#define NIL_VALUE_INIT()      {.bits = 0}
+#define INT_VALUE_INIT(v)     \
+  {.bits = NANBOX_INT_TAG | ((uint64)(int64)(v) & NANBOX_PAYLOAD)}
+#define BOOL_VALUE_INIT(v)    {.bits = (v) ? NANBOX_TRUE : NANBOX_FALSE}
+
+/* Macros to test type */
+#define VALUE_ISNIL(v)     ((v)->bits == 0)
+#define VALUE_ISINT(v)     (((v)->bits >> 48) == 0xffff)
+#define VALUE_ISFLOAT(v)   \
+  (((v)->bits >> 48) >= 2 && ((v)->bits >> 48) != 0xffff)
+#define VALUE_ISBOOL(v)    (((v)->bits | 1) == NANBOX_TRUE)
+#define VALUE_ISOBJECT(v)  ((v)->bits > NANBOX_TRUE && !((v)->bits >> 48))
+
+/* Macros to access type & values, see TValue_Klass() */
+#define VALUE_KLASS(v)  TValue_Klass(v)
+#define VALUE_OBJECT(v) \
+  (VALUE_ISOBJECT(v) ? (Object *)(uintptr_t)(v)->bits : NULL)
+#define VALUE_INT(v)    (VALUE_ASSERT_INT(v), nanbox_int_value((v)->bits))
+#define VALUE_FLOAT(v)  (VALUE_ASSERT_FLOAT(v), nanbox_float_value((v)->bits))
+#define VALUE_BOOL(v)   (VALUE_ASSERT_BOOL(v), (int)((v)->bits & 1))
+
+#else /* !KOALA_NANBOX */
+
 typedef struct tvalue {
   Klass *klazz;
   UNION_VALUE;
@@ -46,15 +145,15 @@ extern TValue FalseValue;
 } while (0)
 
 #define setivalue(v, _v) do { \
-  (v)->klazz = &Int_Klass; (v)->ival = (int64)_v; \
+  (v)->klazz = &Int_Klass; (v)->ival = (int64)(_v); \
 } while (0)
 
 #define setfltvalue(v, _v) do { \
-  (v)->klazz = &Float_Klass; (v)->fval = (float64)_v; \
+  (v)->klazz = &Float_Klass; (v)->fval = (float64)(_v); \
 } while (0)
 
 #define setbvalue(v, _v) do { \
-  (v)->klazz = &Bool_Klass; (v)->bval = (int)_v; \
+  (v)->klazz = &Bool_Klass; (v)->bval = (int)(_v); \
 } while (0)
 
 #define setobjtype(v, _klazz) do { \
@@ -62,11 +161,13 @@ extern TValue FalseValue;
 } while (0)
 
 #define setobjvalue(v, _v) do { \
-  Object *obj = (Object *)_v; \
+  Object *obj = (Object *)(_v); \
   (v)->klazz = obj->ob_klass; \
   (v)->ob = obj; \
 } while (0)
 
+#define clearobjvalue(v) ((v)->ob = NULL)
+
 #define NIL_VALUE_INIT()      {.klazz = NULL,         .ival = 0}
 #define INT_VALUE_INIT(v)     {.klazz = &Int_Klass,   .ival = (v)}
 #define FLOAT_VALUE_INIT(v)   {.klazz = &Float_Klass, .fval = (v)}
@@ -77,6 +178,18 @@ extern TValue FalseValue;
 #define VALUE_ISINT(v)     ((v)->klazz == &Int_Klass)
 #define VALUE_ISFLOAT(v)   ((v)->klazz == &Float_Klass)
 #define VALUE_ISBOOL(v)    ((v)->klazz == &Bool_Klass)
+#define VALUE_ISOBJECT(v)  \
+  ((v)->klazz && !VALUE_ISINT(v) && !VALUE_ISFLOAT(v) && !VALUE_ISBOOL(v) \
+   && (v)->ob)
+
+/* Macros to access type & values */
+#define VALUE_KLASS(v)  ((v)->klazz)
+#define VALUE_OBJECT(v) ((v)->ob)
+#define VALUE_INT(v)    (VALUE_ASSERT_INT(v), (v)->ival)
+#define VALUE_FLOAT(v)  (VALUE_ASSERT_FLOAT(v), (v)->fval)
+#define VALUE_BOOL(v)   (VALUE_ASSERT_BOOL(v), (v)->bval)
+
+#endif /* KOALA_NANBOX */
 
 /* Assert for TValue */
 #define VALUE_ASSERT(v)         (assert(!VALUE_ISNIL(v)))
@@ -84,11 +197,6 @@ extern TValue FalseValue;
 #define VALUE_ASSERT_FLOAT(v)   (assert(VALUE_ISFLOAT(v)))
 #define VALUE_ASSERT_BOOL(v)    (assert(VALUE_ISBOOL(v)))
 
-/* Macros to access type & values */
-#define VALUE_INT(v)    (VALUE_ASSERT_INT(v), (v)->ival)
-#define VALUE_FLOAT(v)  (VALUE_ASSERT_FLOAT(v), (v)->fval)
-#define VALUE_BOOL(v)   (VALUE_ASSERT_BOOL(v), (v)->bval)
-
 /* TValue utils's functions */
 TValue Va_Build_Value(char ch, va_list *ap);
 TValue TValue_Build(int ch, ...);
@@ -137,8 +245,20 @@ struct object {
   o->ob_size = (klazz)->itemsize; \
 } while (0)
 
+#ifdef KOALA_NANBOX
+static inline Klass *TValue_Klass(TValue *v)
+{
+  if (VALUE_ISOBJECT(v)) return OB_KLASS((Object *)(uintptr_t)v->bits);
+  if (VALUE_ISINT(v)) return &Int_Klass;
+  if (VALUE_ISBOOL(v)) return &Bool_Klass;
+  if (VALUE_ISNIL(v)) return NULL;
+  return &Float_Klass;
+}
+#endif
+
 TValue Object_Get_Value(Object *ob, char *name);
 int Object_Set_Value(Object *ob, char *name, TValue *val);
+int Object_Field_Index(Object *ob, char *name, int *hops);
 Object *Object_Get_Method(Object *ob, char *name, Object **rob);
 
 /*---------------------------------------------------------------------------*/
@@ -242,6 +362,23 @@ typedef struct funcdef {
 
 int Klass_Add_CFunctions(Klass *klazz, FuncDef *funcs);
 
+/*
+  Native function, no allocation for arguments and results.
+  'argv' points to the arguments in the operand stack, argv[0] is the first
+  one. Results are written into 'ret' which has room for 'nret' values.
+  'ret' may be the same slots as 'argv', so read arguments before writing
+  results. Returns the number of results, or -1 if failed.
+ */
+typedef int (*nfunc)(Object *ob, TValue *argv, int argc, TValue *ret,
+                     int nret);
+
+typedef struct nfuncdef {
+  char *name;
+  char *rdesc;
+  char *pdesc;
+  nfunc fn;
+} NFuncDef;
+
 #define MEMBER_VAR    1
 #define MEMBER_CODE   2
 #define MEMBER_PROTO  3
@@ -18,6 +18,7 @@ static struct opcode {
   {OP_CALL,     "call",     6},
   {OP_CALL0,    "call0",    2},
   {OP_RET,      "return",   0},
+  {OP_TAILCALL, "tailcall", 6},
   {OP_ADD,      "add",      0},
   {OP_SUB,      "sub",      0},
   {OP_MUL,      "mul",      0},
@@ -30,14 +31,66 @@ static struct opcode {
   {OP_EQ,       "eq",       0},
   {OP_NEQ,      "neq",      0},
   {OP_NEG,      "minus",    0},
+  {OP_BAND,     "band",     0},
+  {OP_BOR,      "bor",      0},
+  {OP_BXOR,     "bxor",     0},
+  {OP_BNOT,     "bnot",     0},
+  {OP_LSHIFT,   "lshift",   0},
+  {OP_RSHIFT,   "rshift",   0},
+  {OP_LAND,     "land",     0},
+  {OP_LOR,      "lor",      0},
+  {OP_LNOT,     "lnot",     0},
   {OP_JUMP,     "jump",     4},
   {OP_JUMP_TRUE,   "jump_true",   4},
   {OP_JUMP_FALSE,  "jump_false",  4},
   {OP_NEW,      "new",      6},
-  {OP_NEWARRAY, "array",    2},
+  {OP_NEWARRAY, "array",    4},
   {OP_NEWMAP,   "map",      2},
   {OP_LOAD_SUBSCR, "load_subscr",   0},
-  {OP_STORE_SUBSCR, "store_subscr", 0}
+  {OP_STORE_SUBSCR, "store_subscr", 0},
+  {OP2_LOADK,    "loadk2",    6},
+  {OP2_GETFIELD, "getfield2", 6},
+  {OP2_SETFIELD, "setfield2", 6},
+  {OP2_ADD,      "add2",      4},
+  {OP2_SUB,      "sub2",      4},
+  {OP2_MUL,      "mul2",      4},
+  {OP2_DIV,      "div2",      4},
+  {OP3_ADD,      "add3",      6},
+  {OP3_SUB,      "sub3",      6},
+  {OP3_MUL,      "mul3",      6},
+  {OP3_DIV,      "div3",      6},
+  {OP_GT_JUMP_TRUE,   "gt_jump_true",   4},
+  {OP_GT_JUMP_FALSE,  "gt_jump_false",  4},
+  {OP_GE_JUMP_TRUE,   "ge_jump_true",   4},
+  {OP_GE_JUMP_FALSE,  "ge_jump_false",  4},
+  {OP_LT_JUMP_TRUE,   "lt_jump_true",   4},
+  {OP_LT_JUMP_FALSE,  "lt_jump_false",  4},
+  {OP_LE_JUMP_TRUE,   "le_jump_true",   4},
+  {OP_LE_JUMP_FALSE,  "le_jump_false",  4},
+  {OP_EQ_JUMP_TRUE,   "eq_jump_true",   4},
+  {OP_EQ_JUMP_FALSE,  "eq_jump_false",  4},
+  {OP_NEQ_JUMP_TRUE,  "neq_jump_true",  4},
+  {OP_NEQ_JUMP_FALSE, "neq_jump_false", 4},
+  {OP_FOR_RANGE,  "for_range",  6},
+  /* quickened ones are never in codes, so the loader rejects them */
+  {OP_ADD_II,   "add_ii",   -1},
+  {OP_ADD_FF,   "add_ff",   -1},
+  {OP_SUB_II,   "sub_ii",   -1},
+  {OP_SUB_FF,   "sub_ff",   -1},
+  {OP_MUL_II,   "mul_ii",   -1},
+  {OP_MUL_FF,   "mul_ff",   -1},
+  {OP_GT_II,    "gt_ii",    -1},
+  {OP_GT_FF,    "gt_ff",    -1},
+  {OP_GE_II,    "ge_ii",    -1},
+  {OP_GE_FF,    "ge_ff",    -1},
+  {OP_LT_II,    "lt_ii",    -1},
+  {OP_LT_FF,    "lt_ff",    -1},
+  {OP_LE_II,    "le_ii",    -1},
+  {OP_LE_FF,    "le_ff",    -1},
+  {OP_EQ_II,    "eq_ii",    -1},
+  {OP_EQ_FF,    "eq_ff",    -1},
+  {OP_NEQ_II,   "neq_ii",   -1},
+  {OP_NEQ_FF,   "neq_ff",   -1}
 };
 
 static struct opcode *get_opcode(uint8 op)
@@ -53,7 +106,7 @@ static struct opcode *get_opcode(uint8 op)
 int opcode_argsize(uint8 op)
 {
   struct opcode *opcode = get_opcode(op);
-  return opcode->argsize;
+  return opcode ? opcode->argsize : -1;
 }
 
 char *opcode_string(uint8 op)
@@ -70,7 +123,7 @@ void code_show(uint8 *code, int32 size)
   printf("------code show--------\n");
   while (i < size) {
     op = get_opcode(code[i]);
-    if (!op) break;
+    if (!op || op->argsize < 0) break;
     i++;
     printf("op:%-12s", op->str);
     if (op->argsize == 4) arg = *(int32 *)(code + i);
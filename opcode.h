@@ -106,6 +106,15 @@ extern "C" {
  */
 #define OP_RET  9
 
+/*
+	Tail call, like OP_CALL followed by OP_RET.
+	The callee's frame replaces the current one, and its return values are
+	returned to the caller of the current frame.
+	arg1: 4 bytes, index of const pool, function name
+	arg2: 2 bytes, number of arguments
+ */
+#define OP_TAILCALL 10
+
 /*
 	Number Operations
 	All args, include object, are in stack. Result is also saved in stack.
@@ -174,7 +183,7 @@ extern "C" {
 	val = load(arg0)
 	store(val, arg1)
  */
-#define OP2_LOADK 50
+#define OP2_LOADK 60
 
 /*
 	Get the field from object directly
@@ -185,7 +194,7 @@ extern "C" {
 	val = getfield(obj, arg0)
 	push(val)
  */
-#define OP2_GETFIELD  51
+#define OP2_GETFIELD  61
 
 /*
 	Set the field to object directly
@@ -197,16 +206,96 @@ extern "C" {
 	val = pop()
 	setfield(arg1, arg0, val)
  */
-#define OP2_SETFIELD  52
+#define OP2_SETFIELD  62
 
 /*
 	Arthmetic operation: add, sub, mul, div
 	Args are in locvars. Result is saved in stack.
+	arg0: 2 bytes, index of left operand in locvars
+	arg1: 2 bytes, index of right operand in locvars
+	-------------------------------------------------------
+	val = op(load(arg0), load(arg1))
+	push(val)
  */
-#define OP2_ADD   53
-#define OP2_SUB   54
-#define OP2_MUL   55
-#define OP2_DIV   56
+#define OP2_ADD   63
+#define OP2_SUB   64
+#define OP2_MUL   65
+#define OP2_DIV   66
+
+/*
+	Superinstructions, fused by the peephole pass of compiler
+	OP3_XXX: OP2_XXX followed by OP_STORE
+	arg0: 2 bytes, index of left operand in locvars
+	arg1: 2 bytes, index of right operand in locvars
+	arg2: 2 bytes, index of result in locvars
+	-------------------------------------------------------
+	val = op(load(arg0), load(arg1))
+	store(val, arg2)
+ */
+#define OP3_ADD   70
+#define OP3_SUB   71
+#define OP3_MUL   72
+#define OP3_DIV   73
+
+/*
+	Compare and jump, comparison followed by OP_JUMP_TRUE or OP_JUMP_FALSE
+	arg: 4 bytes, relative offset
+	-------------------------------------------------------
+	v1 = pop()
+	v2 = pop()
+	if (op(v1, v2) == true(false)) jump(arg)
+ */
+#define OP_GT_JUMP_TRUE   80
+#define OP_GT_JUMP_FALSE  81
+#define OP_GE_JUMP_TRUE   82
+#define OP_GE_JUMP_FALSE  83
+#define OP_LT_JUMP_TRUE   84
+#define OP_LT_JUMP_FALSE  85
+#define OP_LE_JUMP_TRUE   86
+#define OP_LE_JUMP_FALSE  87
+#define OP_EQ_JUMP_TRUE   88
+#define OP_EQ_JUMP_FALSE  89
+#define OP_NEQ_JUMP_TRUE  90
+#define OP_NEQ_JUMP_FALSE 91
+
+/*
+	Counted loop of 'for i in a..<b', the bound is in the locvar next to i
+	arg0: 4 bytes, relative offset, the start of loop body
+	arg1: 2 bytes, index of i in locvars, both i and bound are Int
+	-------------------------------------------------------
+	i = load(arg1) + 1
+	store(i, arg1)
+	if (i < load(arg1 + 1)) jump(arg0)
+ */
+#define OP_FOR_RANGE 92
+
+/*
+	Quickened number operations, type-specialized forms of OP_ADD etc.
+	They are never emitted by compiler. The interpreter rewrites a generic
+	instruction in place after it observes the same operand types several
+	times, and rewrites it back if the guard of the operand types fails.
+	_II: both operands are Int, _FF: both operands are Float.
+	Their argsize is -1, as they are invalid in codes of a .klc file.
+ */
+#define OP_ADD_II 100
+#define OP_ADD_FF 101
+#define OP_SUB_II 102
+#define OP_SUB_FF 103
+#define OP_MUL_II 104
+#define OP_MUL_FF 105
+
+#define OP_GT_II  106
+#define OP_GT_FF  107
+#define OP_GE_II  108
+#define OP_GE_FF  109
+#define OP_LT_II  110
+#define OP_LT_FF  111
+#define OP_LE_II  112
+#define OP_LE_FF  113
+#define OP_EQ_II  114
+#define OP_EQ_FF  115
+#define OP_NEQ_II 116
+#define OP_NEQ_FF 117
 
 int opcode_argsize(uint8 op);
 char *opcode_string(uint8 op);
@@ -38,6 +38,71 @@ int iskar(struct options *ops, char *arg)
   return arg[0] == '-' && arg[1] == 'k' && arg[2] == 'a' && arg[3] == 'r';
 }
 
+int isolevel(struct options *ops, char *arg)
+{
+  return !strcmp(arg, "-O");
+}
+
+/* -O<level> in one argument, like -O0 */
+int isolevel_n(struct options *ops, char *arg)
+{
+  if (arg[0] != '-' || arg[1] != 'O' || !arg[2]) return 0;
+  for (char *s = arg + 2; *s; s++) {
+    if (!isdigit(*s)) return 0;
+  }
+  return 1;
+}
+
+int isjit(struct options *ops, char *arg)
+{
+  return !strcmp(arg, "-jit");
+}
+
+int isprof(struct options *ops, char *arg)
+{
+  return !strcmp(arg, "-prof");
+}
+
+int isproftop(struct options *ops, char *arg)
+{
+  return !strcmp(arg, "-proftop");
+}
+
+int isprofhz(struct options *ops, char *arg)
+{
+  return !strcmp(arg, "-profhz");
+}
+
+int isstats(struct options *ops, char *arg)
+{
+  return !strcmp(arg, "-stats");
+}
+
+int isstatsjson(struct options *ops, char *arg)
+{
+  return !strcmp(arg, "-statsjson");
+}
+
+int isgcpause(struct options *ops, char *arg)
+{
+  return !strcmp(arg, "-gcpause");
+}
+
+int isgcheap(struct options *ops, char *arg)
+{
+  return !strcmp(arg, "-gcheap");
+}
+
+int isgcstress(struct options *ops, char *arg)
+{
+  return !strcmp(arg, "-gcstress");
+}
+
+int isgcmarkers(struct options *ops, char *arg)
+{
+  return !strcmp(arg, "-gcmarkers");
+}
+
 void parse_klc_list(char *klc, struct options *ops)
 {
   ops->klc = strdup(klc);
@@ -112,6 +177,71 @@ int parse_options(int argc, char *argv[], struct options *ops)
         error("invalid package");
         return -1;
       }
+    } else if (isolevel_n(ops, argv[i])) {
+      ops->olevel = atoi(argv[i] + 2);
+    } else if (isolevel(ops, argv[i])) {
+      if (++i < argc && isdigit(argv[i][0])) {
+        ops->olevel = atoi(argv[i]);
+      } else {
+        error("invalid -O option");
+        return -1;
+      }
+    } else if (isjit(ops, argv[i])) {
+      ops->jit = 1;
+    } else if (isprof(ops, argv[i])) {
+      if (++i < argc) {
+        ops->prof = strdup(argv[i]);
+      } else {
+        error("invalid -prof option");
+        return -1;
+      }
+    } else if (isproftop(ops, argv[i])) {
+      if (++i < argc) {
+        ops->proftop = strdup(argv[i]);
+      } else {
+        error("invalid -proftop option");
+        return -1;
+      }
+    } else if (isprofhz(ops, argv[i])) {
+      if (++i < argc) {
+        ops->profhz = atoi(argv[i]);
+      } else {
+        error("invalid -profhz option");
+        return -1;
+      }
+    } else if (isstats(ops, argv[i])) {
+      ops->stats = 1;
+    } else if (isstatsjson(ops, argv[i])) {
+      if (++i < argc) {
+        ops->stats = 1;
+        ops->statsjson = strdup(argv[i]);
+      } else {
+        error("invalid -statsjson option");
+        return -1;
+      }
+    } else if (isgcpause(ops, argv[i])) {
+      if (++i < argc) {
+        ops->gcpause = atoi(argv[i]);
+      } else {
+        error("invalid -gcpause option");
+        return -1;
+      }
+    } else if (isgcheap(ops, argv[i])) {
+      if (++i < argc && atoi(argv[i]) > 0) {
+        ops->gcheap = atoi(argv[i]);
+      } else {
+        error("invalid -gcheap option");
+        return -1;
+      }
+    } else if (isgcstress(ops, argv[i])) {
+      ops->gcstress = 1;
+    } else if (isgcmarkers(ops, argv[i])) {
+      if (++i < argc && atoi(argv[i]) > 0) {
+        ops->gcmarkers = atoi(argv[i]);
+      } else {
+        error("invalid -gcmarkers option");
+        return -1;
+      }
     } else if (isargs(ops, argv[i])) {
       if (++i < argc) {
         char *args = argv[i];
@@ -139,6 +269,7 @@ int init_options(struct options *ops, char *cmd, char delimiter)
   ops->__delims[1] = 0;
   ops->delimiter = ops->__delims;
   ops->cmd = cmd;
+  ops->olevel = 1;
   Vector_Init(&ops->klcvec);
   Vector_Init(&ops->karvec);
   Vector_Init(&ops->args);
@@ -151,6 +282,20 @@ void show_options(struct options *ops)
   printf("src: '%s'\n", ops->srcpkg);
   printf("out: '%s'\n", ops->outpkg);
   printf("delimiter: '%c'\n", ops->__delims[0]);
+  printf("olevel: %d\n", ops->olevel);
+  printf("jit: %s\n", ops->jit ? "on" : "off");
+  if (ops->prof || ops->proftop)
+    printf("prof: '%s' '%s', %d hz\n", ops->prof, ops->proftop, ops->profhz);
+  if (ops->stats)
+    printf("stats: on, json: '%s'\n", ops->statsjson);
+  if (ops->gcpause)
+    printf("gc pause: %d us\n", ops->gcpause);
+  if (ops->gcheap)
+    printf("gc heap: %d MB\n", ops->gcheap);
+  if (ops->gcstress)
+    printf("gc stress: on\n");
+  if (ops->gcmarkers)
+    printf("gc markers: %d\n", ops->gcmarkers);
 
   char *str;
   printf("klc:%s\n", ops->klc);
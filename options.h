@@ -19,6 +19,17 @@ struct options {
   Vector klcvec;
   Vector karvec;
   Vector args;
+  int olevel;
+  int jit;
+  char *prof;
+  char *proftop;
+  int profhz;
+  int stats;
+  char *statsjson;
+  int gcpause;
+  int gcheap;
+  int gcstress;
+  int gcmarkers;
   char __delims[2];
 };
 
@@ -6,6 +6,7 @@
 #include "codegen.h"
 #include "opcode.h"
 #include "moduleobject.h"
+#include "numberobject.h"
 #include "log.h"
 #include "koala_yacc.h"
 #include "koala_lex.h"
@@ -668,99 +669,234 @@ void Parser_New_TypeAlias(ParserState *ps, stmt_t *stmt)
 
 /*---------------------------------------------------------------------------*/
 
-#if 0
-static struct expr *optimize_binary_add(struct expr *l, struct expr *r)
+/*
+ * Constant folding, enabled when olevel > 0.
+ * The operands are literals and initialized 'const' variables, and the result
+ * is a literal expr, or NULL if it is not a constant or is left to runtime.
+ * Only operations which the virtual machine has are folded, with the same
+ * results as its numops, so -O 0 and -O 1 print the same.
+ */
+
+static struct expr *fold_expr(ParserState *ps, struct expr *exp);
+
+static Symbol *find_konst_symbol(ParserState *ps, char *id)
 {
-  struct expr *e;
-  if (l->kind == INT_KIND) {
-    int64 val;
-    if (r->kind == INT_KIND) {
-      val = l->ival + r->ival;
-    } else if (r->kind == FLOAT_KIND) {
-      val = l->ival + r->fval;
-    } else {
-      assert(0);
-    }
-    e = expr_from_int(val);
-  } else if (l->kind == FLOAT_KIND) {
-    float64 val;
-    if (r->kind == INT_KIND) {
-      val = l->fval + r->ival;
-    } else if (r->kind == FLOAT_KIND) {
-      val = l->fval + r->fval;
-    } else {
-      assert(0);
+  // the same scopes as parser_ident, a shadowed symbol is not a constant
+  Symbol *sym = STable_Get(ps->u->stbl, id);
+  if (!sym) {
+    ParserUnit *up;
+    list_for_each_entry(up, &ps->ustack, link) {
+      sym = STable_Get(up->stbl, id);
+      if (sym) break;
     }
-    e = expr_from_float(val);
-  } else {
-    kassert(0, "unsupported optimized type:%d", l->kind);
   }
-  return e;
+
+  if (!sym || sym->kind != SYM_VAR || !(sym->access & ACCESS_CONST))
+    return NULL;
+  return sym;
 }
 
-static struct expr *optimize_binary_sub(struct expr *l, struct expr *r)
+static struct expr *fold_unary(ParserState *ps, struct expr *exp)
 {
-  struct expr *e;
-  if (l->kind == INT_KIND) {
-    int64 val;
-    if (r->kind == INT_KIND) {
-      val = l->ival - r->ival;
-    } else if (r->kind == FLOAT_KIND) {
-      val = l->ival - r->fval;
-    } else {
-      assert(0);
+  struct expr *e = fold_expr(ps, exp->unary.operand);
+  if (!e) return NULL;
+
+  switch (exp->unary.op) {
+    case UNARY_PLUS: {
+      if (e->kind == INT_KIND || e->kind == FLOAT_KIND) return e;
+      break;
     }
-    e = expr_from_int(val);
-  } else if (l->kind == FLOAT_KIND) {
-    float64 val;
-    if (r->kind == INT_KIND) {
-      val = l->fval - r->ival;
-    } else if (r->kind == FLOAT_KIND) {
-      val = l->fval - r->fval;
-    } else {
-      assert(0);
+    case UNARY_MINUS: {
+      if (e->kind == INT_KIND) return expr_from_int(0 - (uint64)e->ival);
+      if (e->kind == FLOAT_KIND) return expr_from_float(0 - e->fval);
+      break;
     }
-    e = expr_from_float(val);
-  } else {
-    kassert(0, "unsupported optimized type:%d", l->kind);
+    case UNARY_BIT_NOT: {
+      if (e->kind == INT_KIND) return expr_from_int(~e->ival);
+      break;
+    }
+    case UNARY_LNOT: {
+      if (e->kind == BOOL_KIND) return expr_from_bool(!e->bval);
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+  return NULL;
+}
+
+static int fold_compare(int op, int cmp)
+{
+  switch (op) {
+    case BINARY_GT:  return cmp > 0;
+    case BINARY_GE:  return cmp >= 0;
+    case BINARY_LT:  return cmp < 0;
+    case BINARY_LE:  return cmp <= 0;
+    case BINARY_EQ:  return cmp == 0;
+    case BINARY_NEQ: return cmp != 0;
+    default: assert(0); return 0;
+  }
+}
+
+static struct expr *fold_binary_int(int op, int64 l, int64 r)
+{
+  uint64 ul = l, ur = r;
+  switch (op) {
+    case BINARY_ADD:
+      return expr_from_int(ul + ur);
+    case BINARY_SUB:
+      return expr_from_int(ul - ur);
+    case BINARY_MULT:
+      return expr_from_int(ul * ur);
+    case BINARY_DIV:
+      // division by zero is an error of runtime
+      if (!r) return NULL;
+      return expr_from_int(Int_Div(l, r));
+    case BINARY_MOD:
+      if (!r) return NULL;
+      return expr_from_int(Int_Mod(l, r));
+    case BINARY_LSHIFT:
+      return expr_from_int(Int_Lshift(l, r));
+    case BINARY_RSHIFT:
+      return expr_from_int(Int_Rshift(l, r));
+    case BINARY_BIT_AND:
+      return expr_from_int(l & r);
+    case BINARY_BIT_XOR:
+      return expr_from_int(l ^ r);
+    case BINARY_BIT_OR:
+      return expr_from_int(l | r);
+    default:
+      if (binop_relation(op))
+        return expr_from_bool(fold_compare(op, (l > r) - (l < r)));
+      return NULL;
   }
-  return e;
 }
 
-static int optimize_binary_expr(ParserState *ps, struct expr **exp)
+static struct expr *fold_binary_float(int op, float64 l, float64 r)
 {
-  if (ps->olevel <= 0) return 0;
+  switch (op) {
+    case BINARY_ADD:
+      return expr_from_float(l + r);
+    case BINARY_SUB:
+      return expr_from_float(l - r);
+    case BINARY_MULT:
+      return expr_from_float(l * r);
+    case BINARY_DIV:
+      return expr_from_float(l / r);
+    default:
+      // comparisons with NaN are left to runtime
+      if (binop_relation(op) && l == l && r == r)
+        return expr_from_bool(fold_compare(op, (l > r) - (l < r)));
+      return NULL;
+  }
+}
 
-  int ret = 0;
-  struct expr *origin = *exp;
-  struct expr *left = origin->binary.left;
-  struct expr *right = origin->binary.right;
-  if (left->konst && right->konst) {
-    ret = 1;
-    struct expr *e = NULL;
-    switch (origin->binary.op) {
-      case BINARY_ADD: {
-        debug("optimize add");
-        e = optimize_binary_add(left, right);
-        break;
-      }
-      case BINARY_SUB: {
-        debug("optimize sub");
-        e = optimize_binary_sub(left, right);
-        break;
-      }
-      default: {
-        assert(0);
-      }
-    }
-    //free origin, left and right expression
-    *exp = e;
+static struct expr *fold_binary_bool(int op, int l, int r)
+{
+  switch (op) {
+    case BINARY_EQ:
+      return expr_from_bool(!l == !r);
+    case BINARY_NEQ:
+      return expr_from_bool(!l != !r);
+    case BINARY_LAND:
+      return expr_from_bool(l && r);
+    case BINARY_LOR:
+      return expr_from_bool(l || r);
+    default:
+      return NULL;
+  }
+}
+
+static struct expr *fold_binary(ParserState *ps, struct expr *exp)
+{
+  struct expr *l = fold_expr(ps, exp->binary.left);
+  if (!l) return NULL;
+  struct expr *r = fold_expr(ps, exp->binary.right);
+  if (!r) return NULL;
+
+  // mixed types are left to runtime
+  if (l->kind != r->kind) return NULL;
+
+  int op = exp->binary.op;
+  switch (l->kind) {
+    case INT_KIND:
+      return fold_binary_int(op, l->ival, r->ival);
+    case FLOAT_KIND:
+      return fold_binary_float(op, l->fval, r->fval);
+    case BOOL_KIND:
+      return fold_binary_bool(op, l->bval, r->bval);
+    default:
+      return NULL;
   }
+}
 
-  return ret;
+static struct expr *fold_expr(ParserState *ps, struct expr *exp)
+{
+  if (ps->olevel <= 0 || exp->right) return NULL;
+
+  switch (exp->kind) {
+    case INT_KIND:
+    case FLOAT_KIND:
+    case BOOL_KIND:
+    case STRING_KIND:
+      return exp;
+    case ID_KIND: {
+      Symbol *sym = find_konst_symbol(ps, exp->id);
+      return sym ? sym->value : NULL;
+    }
+    case UNARY_KIND:
+      return fold_unary(ps, exp);
+    case BINARY_KIND:
+      return fold_binary(ps, exp);
+    default:
+      return NULL;
+  }
 }
 
-#endif
+/* the constants are used, though no codes are generated for them */
+static void fold_refer(ParserState *ps, struct expr *exp)
+{
+  switch (exp->kind) {
+    case ID_KIND:
+      find_konst_symbol(ps, exp->id)->refcnt++;
+      break;
+    case UNARY_KIND:
+      fold_refer(ps, exp->unary.operand);
+      break;
+    case BINARY_KIND:
+      fold_refer(ps, exp->binary.left);
+      fold_refer(ps, exp->binary.right);
+      break;
+    default:
+      break;
+  }
+}
+
+/* generate one 'OP_LOADK' for a constant expr */
+static int parser_fold_expr(ParserState *ps, struct expr *exp)
+{
+  if (exp->ctx != EXPR_LOAD) return 0;
+
+  struct expr *e = fold_expr(ps, exp);
+  if (!e) return 0;
+
+  debug("fold expr(%d) to constant", exp->kind);
+  fold_refer(ps, exp);
+  exp->desc = e->desc;
+  e->ctx = EXPR_LOAD;
+  parser_visit_expr(ps, e);
+  return 1;
+}
+
+/* test of if/while: 1 - true, 0 - false, -1 - not a constant */
+static int parser_fold_test(ParserState *ps, struct expr *test)
+{
+  struct expr *e = fold_expr(ps, test);
+  if (!e || e->kind != BOOL_KIND) return -1;
+  fold_refer(ps, test);
+  return e->bval ? 1 : 0;
+}
 
 /*--------------------------------------------------------------------------*/
 
@@ -822,7 +958,7 @@ static void parser_merge(ParserState *ps)
           offset = u->block->bytes - jmp->inst->upbytes;
         } else {
           assert(jmp->type == JMP_CONTINUE);
-          offset = 0 - jmp->inst->upbytes;
+          offset = u->cont - jmp->inst->upbytes;
         }
         jmp->inst->arg.kind = ARG_INT;
         jmp->inst->arg.ival = offset;
@@ -1069,11 +1205,12 @@ static void parser_curscope_ident(ParserState *ps, Symbol *sym,
           exp->right && exp->right->kind == CALL_KIND) {
           Inst_Append_NoArg(u->block, OP_LOAD0);
         }
-        int opcode;
         debug("local's variable");
-        opcode = (exp->ctx == EXPR_LOAD) ? OP_LOAD : OP_STORE;
         Argument val = {.kind = ARG_INT, .ival = sym->index};
-        Inst_Append(u->block, opcode, &val);
+        if (exp->ctx == EXPR_LOAD)
+          Inst_Append(u->block, OP_LOAD, &val);
+        else
+          codegen_store(ps, sym->index);
         if (sym->desc->kind == TYPE_PROTO &&
           exp->right && exp->right->kind == CALL_KIND) {
           Inst *i = Inst_Append(u->block, OP_CALL0, &val);
@@ -1240,9 +1377,12 @@ static void parser_upscope_ident(ParserState *ps, Symbol *sym,
       if (!up || up->kind == SYM_PROTO) {
         debug("symbol '%s' is local variable", sym->name);
         // local's variable
-        int opcode = (exp->ctx == EXPR_LOAD) ? OP_LOAD : OP_STORE;
-        Argument val = {.kind = ARG_INT, .ival = sym->index};
-        Inst_Append(u->block, opcode, &val);
+        if (exp->ctx == EXPR_LOAD) {
+          Argument val = {.kind = ARG_INT, .ival = sym->index};
+          Inst_Append(u->block, OP_LOAD, &val);
+        } else {
+          codegen_store(ps, sym->index);
+        }
       } else if (up->kind == SYM_CLASS) {
         debug("symbol '%s' is class variable", sym->name);
         debug("symbol '%s' is inherited ? %s", sym->name,
@@ -1524,12 +1664,11 @@ static void parser_attribute(ParserState *ps, struct expr *exp)
 
     if (exp->ctx == EXPR_LOAD) {
       debug("load:%s", val.str);
-      Inst_Append(ps->u->block, OP_GETFIELD, &val);
     } else {
       assert(exp->ctx == EXPR_STORE);
       debug("store:%s", val.str);
-      Inst_Append(ps->u->block, OP_SETFIELD, &val);
     }
+    codegen_field(ps, exp->ctx, &val);
   } else if (sym->kind == SYM_PROTO) {
     if (exp->supername) {
       char *namebuf = malloc(strlen(exp->supername) + 1 +
@@ -1812,6 +1951,7 @@ static void parser_visit_expr(ParserState *ps, struct expr *exp)
 {
   switch (exp->kind) {
     case ID_KIND: {
+      if (parser_fold_expr(ps, exp)) break;
       parser_ident(ps, exp);
       break;
     }
@@ -1829,7 +1969,7 @@ static void parser_visit_expr(ParserState *ps, struct expr *exp)
     }
     case BOOL_KIND: {
       assert(exp->ctx == EXPR_LOAD);
-      Argument val = {.kind = ARG_BOOL, .fval = exp->bval};
+      Argument val = {.kind = ARG_BOOL, .bval = exp->bval};
       Inst_Append(ps->u->block, OP_LOADK, &val);
       break;
     }
@@ -1888,6 +2028,7 @@ static void parser_visit_expr(ParserState *ps, struct expr *exp)
     }
     case BINARY_KIND: {
       debug("binary_op:%d", exp->binary.op);
+      if (parser_fold_expr(ps, exp)) break;
       exp->binary.right->ctx = EXPR_LOAD;
       parser_visit_expr(ps, exp->binary.right);
       exp->binary.left->ctx = EXPR_LOAD;
@@ -1902,6 +2043,7 @@ static void parser_visit_expr(ParserState *ps, struct expr *exp)
     }
     case UNARY_KIND: {
       debug("unary_op:%d", exp->unary.op);
+      if (parser_fold_expr(ps, exp)) break;
       exp->unary.operand->ctx = EXPR_LOAD;
       parser_visit_expr(ps, exp->unary.operand);
       exp->desc = Type_Dup(exp->unary.operand->desc);
@@ -2215,8 +2357,7 @@ static void parse_variable(ParserState *ps, stmt_t *stmt)
     Vector_Append(&u->sym->locvec, sym);
     /* generate code */
     if (rexp) {
-      Argument val = {.kind = ARG_INT, .ival = sym->index};
-      Inst_Append(ps->u->block, OP_STORE, &val);
+      codegen_store(ps, sym->index);
     }
   } else if (u->scope == SCOPE_BLOCK) {
     /* local's variable in block */
@@ -2237,13 +2378,16 @@ static void parse_variable(ParserState *ps, stmt_t *stmt)
     Vector_Append(&pu->sym->locvec, sym);
     /* generate code */
     if (rexp) {
-      Argument val = {.kind = ARG_INT, .ival = sym->index};
-      Inst_Append(ps->u->block, OP_STORE, &val);
+      codegen_store(ps, sym->index);
     }
   } else {
     kassert(0, "unknown unit scope:%d", u->scope);
   }
 
+  // save constant's value for folding
+  if (konst && rexp)
+    sym->value = fold_expr(ps, rexp);
+
 #if 0
   if (var->typealias) {
     debug("update typealias symbol '%s' desc", sym->name);
@@ -2844,22 +2988,51 @@ static void parser_return(ParserState *ps, stmt_t *stmt)
     kassert(0, "invalid scope:%d", u->scope);
   }
 
+  /* only the call made by 'return f(...)' itself is a tail call */
   struct expr *e;
+  Inst *call = NULL;
+  Inst *last;
+  int tail = Vector_Size(stmt->returns) == 1 &&
+             ((struct expr *)Vector_Get(stmt->returns, 0))->kind == CALL_KIND;
   Vector_ForEach(e, stmt->returns) {
     e->ctx = EXPR_LOAD;
+    last = tail ? codegen_tail(ps) : NULL;
     parser_visit_expr(ps, e);
+    if (tail) {
+      call = codegen_tail(ps);
+      if (!call || call == last || call->op != OP_CALL) call = NULL;
+    }
   }
   check_return_types(sym, stmt->returns);
 
-  Inst_Append(u->block, OP_RET, NULL);
+  codegen_return(ps, call);
   u->block->bret = 1;
 }
 
 static void parser_if(ParserState *ps, stmt_t *stmt)
 {
+  struct expr *test = stmt->if_stmt.test;
+  Vector *body = stmt->if_stmt.body;
+  stmt_t *orelse = stmt->if_stmt.orelse;
+
+  // dead branch of constant condition is not generated
+  int cond = test ? parser_fold_test(ps, test) : -1;
+  if (cond == 0) {
+    if (orelse) {
+      // ELSE branch takes the place of this one
+      orelse->if_stmt.belse = stmt->if_stmt.belse;
+      parser_if(ps, orelse);
+      return;
+    }
+    body = NULL;
+  }
+  if (cond >= 0) {
+    test = NULL;
+    orelse = NULL;
+  }
+
   parser_enter_scope(ps, NULL, SCOPE_BLOCK);
   int testsize = 0;
-  struct expr *test = stmt->if_stmt.test;
   if (test) {
     // ELSE branch has not 'test'
     parser_visit_expr(ps, test);
@@ -2880,13 +3053,13 @@ static void parser_if(ParserState *ps, stmt_t *stmt)
     jumpfalse = Inst_Append(b, OP_JUMP_FALSE, NULL);
   }
 
-  parser_body(ps, stmt->if_stmt.body);
+  parser_body(ps, body);
 
   if (test) {
     // ELSE branch has not 'test'
     int offset = b->bytes;
     debug("offset:%d", offset);
-    if (stmt->if_stmt.orelse) {
+    if (orelse) {
       offset -= testsize;
       assert(offset >= 0);
       debug("offset2:%d", offset);
@@ -2899,8 +3072,8 @@ static void parser_if(ParserState *ps, stmt_t *stmt)
     jumpfalse->arg.ival = offset;
   }
 
-  if (stmt->if_stmt.orelse) {
-    parser_if(ps, stmt->if_stmt.orelse);
+  if (orelse) {
+    parser_if(ps, orelse);
     assert(b->next);
     CodeBlock *nb = b->next;
     int offset = 0;
@@ -2922,6 +3095,15 @@ static void parser_if(ParserState *ps, stmt_t *stmt)
 
 static void parser_while(ParserState *ps, stmt_t *stmt)
 {
+  struct expr *test = stmt->while_stmt.test;
+
+  // constant condition: no loop, or loop without test
+  int cond = parser_fold_test(ps, test);
+  if (cond == 0 && stmt->while_stmt.btest) {
+    debug("omit while-stmt of false condition");
+    return;
+  }
+
   parser_enter_scope(ps, NULL, SCOPE_BLOCK);
   ParserUnit *u = ps->u;
   u->loop = 1;
@@ -2930,7 +3112,7 @@ static void parser_while(ParserState *ps, stmt_t *stmt)
   int jmpsize = 0;
   int bodysize = 0;
 
-  if (stmt->while_stmt.btest) {
+  if (stmt->while_stmt.btest && cond < 0) {
     jmp = Inst_Append(u->block, OP_JUMP, NULL);
     jmpsize = 1 + opcode_argsize(OP_JUMP);
   }
@@ -2938,21 +3120,26 @@ static void parser_while(ParserState *ps, stmt_t *stmt)
   parser_body(ps, stmt->while_stmt.body);
   bodysize = u->block->bytes - jmpsize;
 
-  struct expr *test = stmt->while_stmt.test;
-  parser_visit_expr(ps, test);
-  assert(test->desc);
-  //FIXME
-  /*
-  if (test->desc != &Bool_Type) {
-    error("while-stmt condition is not bool");
+  if (cond < 0) {
+    parser_visit_expr(ps, test);
+    assert(test->desc);
+    //FIXME
+    /*
+    if (test->desc != &Bool_Type) {
+      error("while-stmt condition is not bool");
+    }
+    */
+    int offset = 0 - (u->block->bytes - jmpsize +
+      1 + opcode_argsize(OP_JUMP_TRUE));
+    Argument val = {.kind = ARG_INT, .ival = offset};
+    Inst_Append(b, OP_JUMP_TRUE, &val);
+  } else if (cond > 0) {
+    int offset = 0 - (u->block->bytes + 1 + opcode_argsize(OP_JUMP));
+    Argument val = {.kind = ARG_INT, .ival = offset};
+    Inst_Append(b, OP_JUMP, &val);
   }
-  */
-  int offset = 0 - (u->block->bytes - jmpsize +
-    1 + opcode_argsize(OP_JUMP_TRUE));
-  Argument val = {.kind = ARG_INT, .ival = offset};
-  Inst_Append(b, OP_JUMP_TRUE, &val);
 
-  if (stmt->while_stmt.btest) {
+  if (stmt->while_stmt.btest && cond < 0) {
     jmp->arg.kind = ARG_INT;
     jmp->arg.ival = bodysize;
   }
@@ -2960,6 +3147,95 @@ static void parser_while(ParserState *ps, stmt_t *stmt)
   parser_exit_scope(ps);
 }
 
+/* add a locvar of block, which is indexed in its function's locvars */
+static Symbol *add_block_var(ParserState *ps, char *id, TypeDesc *desc)
+{
+  ParserUnit *pu = get_function_unit(ps);
+  assert(pu);
+  Symbol *sym = STable_Add_Var(ps->u->stbl, id, desc, 0);
+  if (!sym) return NULL;
+  sym->index = pu->stbl->varcnt++;
+  sym->up = NULL;
+  Vector_Append(&pu->sym->locvec, sym);
+  return sym;
+}
+
+/*
+  for i in a..<b { body }, or a...b with b included:
+    i = a; end = b(or b + 1)
+    if !(i < end) goto exit
+  body:
+    ...
+  cont:
+    for_range body, i     // ++i; if i < end goto body
+  exit:
+  'end' is a hidden locvar next to i, both are unboxed Int in the loop.
+ */
+static void parser_for_range(ParserState *ps, stmt_t *stmt)
+{
+  struct expr *start = stmt->for_range_stmt.start;
+  struct expr *end = stmt->for_range_stmt.end;
+  char *id = stmt->for_range_stmt.id;
+
+  parser_enter_scope(ps, NULL, SCOPE_BLOCK);
+  ParserUnit *u = ps->u;
+  u->loop = 1;
+  CodeBlock *b = u->block;
+
+  ParserUnit *pu = get_function_unit(ps);
+  if (!pu) {
+    error("for-stmt is not within a function");
+    parser_exit_scope(ps);
+    return;
+  }
+  if (STable_Get(pu->stbl, id)) {
+    error("variable '%s' is already defined", id);
+    parser_exit_scope(ps);
+    return;
+  }
+
+  start->ctx = EXPR_LOAD;
+  parser_visit_expr(ps, start);
+  end->ctx = EXPR_LOAD;
+  parser_visit_expr(ps, end);
+  if (!start->desc || !Type_IsInt(start->desc) ||
+      !end->desc || !Type_IsInt(end->desc)) {
+    error("for-stmt range is not int");
+    parser_exit_scope(ps);
+    return;
+  }
+  if (stmt->for_range_stmt.inclusive) {
+    Argument one = {.kind = ARG_INT, .ival = 1};
+    Inst_Append(b, OP_LOADK, &one);
+    Inst_Append_NoArg(b, OP_ADD);
+  }
+
+  Symbol *var = add_block_var(ps, id, &Int_Type);
+  Symbol *bound = add_block_var(ps, "for.end", &Int_Type);
+  assert(var && bound && bound->index == var->index + 1);
+  codegen_store(ps, bound->index);
+  // 'start' is under 'end' in stack
+  codegen_store(ps, var->index);
+
+  Argument val = {.kind = ARG_INT, .ival = bound->index};
+  Inst_Append(b, OP_LOAD, &val);
+  val.ival = var->index;
+  Inst_Append(b, OP_LOAD, &val);
+  Inst_Append_NoArg(b, OP_LT);
+  Inst *i = Inst_Append(b, OP_JUMP_FALSE, NULL);
+  Vector_Append(&u->jmps, JmpInst_New(i, JMP_BREAK));
+
+  int body = b->bytes;
+  parser_body(ps, stmt->for_range_stmt.body);
+  u->cont = b->bytes;
+
+  val.ival = body - (b->bytes + 1 + opcode_argsize(OP_FOR_RANGE));
+  i = Inst_Append(b, OP_FOR_RANGE, &val);
+  i->argc = var->index;
+
+  parser_exit_scope(ps);
+}
+
 static void parser_break(ParserState *ps, stmt_t *stmt)
 {
   UNUSED_PARAMETER(stmt);
@@ -3090,6 +3366,10 @@ static void parser_vist_stmt(ParserState *ps, stmt_t *stmt)
       parser_while(ps, stmt);
       break;
     }
+    case FOR_RANGE_KIND: {
+      parser_for_range(ps, stmt);
+      break;
+    }
     case BREAK_KIND: {
       parser_break(ps, stmt);
       break;
@@ -3154,6 +3434,7 @@ ParserState *new_parser(PackageInfo *pkg, char *filename)
   ps->filename = filename;
   ps->pkg = pkg;
   ps->sym = pkg->sym;
+  ps->olevel = pkg->options ? pkg->options->olevel : 1;
   Vector_Init(&ps->stmts);
   init_list_head(&ps->ustack);
   Vector_Init(&ps->errors);
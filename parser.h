@@ -50,6 +50,8 @@ typedef struct inst {
   uint8 op;
   Argument arg;
   int upbytes;  // break and continue statements
+  int result;   // index of result in locvars, OP3_XXX
+  int offset;   // offset in function, used by peephole
 } Inst;
 
 #define JMP_BREAK    1
@@ -92,6 +94,7 @@ typedef struct parserunit {
   enum scope scope;
   int8 merge;
   int8 loop;
+  int cont;       /* continue target of loop, byte offset in its block */
   struct list_head link;
   Symbol *sym;
   STable *stbl;
@@ -0,0 +1,340 @@
+
+#include "profile.h"
+#include "log.h"
+
+#if defined(__linux__)
+
+#include <stdint.h>
+#include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <sys/mman.h>
+
+/*
+  A sample is stored as its depth and then 'depth' pairs of (code, pc),
+  from the innermost frame to the outermost one. Writers reserve room by
+  bumping 'used', a sample is dropped if the buffer is full.
+ */
+static struct {
+  int hz;
+  char *folded;
+  char *table;
+  timer_t timer;
+  struct sigaction oldact;
+  uintptr_t *buf;
+  long size;
+  long used;
+  long samples;
+  long dropped;
+  long idle;
+  long truncated;
+  int started;
+} prof;
+
+static void profile_handler(int sig, siginfo_t *si, void *uc)
+{
+  UNUSED_PARAMETER(sig);
+  UNUSED_PARAMETER(si);
+  UNUSED_PARAMETER(uc);
+
+  Routine *rt = Routine_Current;
+  Frame *f = rt ? rt->frame : NULL;
+  if (!f) {
+    __sync_fetch_and_add(&prof.idle, 1);
+    return;
+  }
+
+  uintptr_t frames[PROFILE_MAX_DEPTH * 2];
+  int depth = 0;
+  while (f && depth < PROFILE_MAX_DEPTH) {
+    frames[depth * 2] = (uintptr_t)f->code;
+    frames[depth * 2 + 1] = (uintptr_t)f->pc;
+    ++depth;
+    f = f->prev;
+  }
+  if (f) __sync_fetch_and_add(&prof.truncated, 1);
+
+  long words = 1 + depth * 2;
+  long pos = __sync_fetch_and_add(&prof.used, words);
+  if (pos + words > prof.size) {
+    __sync_fetch_and_add(&prof.dropped, 1);
+    return;
+  }
+
+  uintptr_t *p = prof.buf + pos;
+  for (int i = 0; i < depth * 2; i++)
+    p[1 + i] = frames[i];
+  p[0] = depth;
+  __sync_fetch_and_add(&prof.samples, 1);
+}
+
+int Profile_Start(int hz, char *folded, char *table)
+{
+  if (prof.started) return 0;
+  if (hz <= 0) hz = PROFILE_HZ;
+
+  prof.size = PROFILE_BUF_SIZE;
+  /* untouched pages are zero and not backed until samples are written */
+  prof.buf = mmap(NULL, prof.size * sizeof(uintptr_t),
+                  PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (prof.buf == MAP_FAILED) {
+    error("profile: mmap failed, %s", strerror(errno));
+    prof.buf = NULL;
+    return -1;
+  }
+
+  struct sigaction act;
+  memset(&act, 0, sizeof(act));
+  act.sa_sigaction = profile_handler;
+  act.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&act.sa_mask);
+  if (sigaction(SIGPROF, &act, &prof.oldact)) {
+    error("profile: sigaction failed, %s", strerror(errno));
+    munmap(prof.buf, prof.size * sizeof(uintptr_t));
+    prof.buf = NULL;
+    return -1;
+  }
+
+  struct sigevent sev;
+  memset(&sev, 0, sizeof(sev));
+  sev.sigev_notify = SIGEV_SIGNAL;
+  sev.sigev_signo = SIGPROF;
+  if (timer_create(CLOCK_PROCESS_CPUTIME_ID, &sev, &prof.timer)) {
+    error("profile: timer_create failed, %s", strerror(errno));
+    sigaction(SIGPROF, &prof.oldact, NULL);
+    munmap(prof.buf, prof.size * sizeof(uintptr_t));
+    prof.buf = NULL;
+    return -1;
+  }
+
+  struct itimerspec its;
+  its.it_interval.tv_sec = 0;
+  its.it_interval.tv_nsec = 1000000000L / hz;
+  if (hz == 1) {
+    its.it_interval.tv_sec = 1;
+    its.it_interval.tv_nsec = 0;
+  }
+  its.it_value = its.it_interval;
+  timer_settime(prof.timer, 0, &its, NULL);
+
+  prof.hz = hz;
+  prof.folded = folded;
+  prof.table = table;
+  prof.started = 1;
+  return 0;
+}
+
+/*-------------------------------------------------------------------------*/
+
+/* next sample in the buffer, skipping the holes of dropped ones */
+static uintptr_t *next_sample(long *pos, long end)
+{
+  while (*pos < end) {
+    uintptr_t *p = prof.buf + *pos;
+    if (p[0] == 0) {
+      ++*pos;
+      continue;
+    }
+    *pos += 1 + p[0] * 2;
+    return p;
+  }
+  return NULL;
+}
+
+static int cmp_string(const void *a, const void *b)
+{
+  return strcmp(*(char **)a, *(char **)b);
+}
+
+static void write_folded(FILE *fp, long end)
+{
+  char **stacks = malloc(sizeof(char *) * (prof.samples + 1));
+  int nstacks = 0;
+  char line[PROFILE_MAX_DEPTH * 64];
+  long pos = 0;
+  uintptr_t *p;
+
+  while ((p = next_sample(&pos, end))) {
+    int depth = p[0];
+    int len = 0;
+    /* folded stacks are from the outermost frame */
+    for (int i = depth - 1; i >= 0; i--) {
+      if (len >= (int)sizeof(line) - 1) break;
+      if (i != depth - 1) line[len++] = ';';
+      len += Code_Name((Object *)p[1 + i * 2], line + len,
+                       sizeof(line) - len);
+    }
+    line[min(len, (int)sizeof(line) - 1)] = '\0';
+    stacks[nstacks++] = strdup(line);
+  }
+
+  qsort(stacks, nstacks, sizeof(char *), cmp_string);
+  int i = 0;
+  while (i < nstacks) {
+    int j = i + 1;
+    while (j < nstacks && !strcmp(stacks[i], stacks[j])) ++j;
+    fprintf(fp, "%s %d\n", stacks[i], j - i);
+    i = j;
+  }
+
+  for (i = 0; i < nstacks; i++)
+    free(stacks[i]);
+  free(stacks);
+}
+
+struct site {
+  Object *code;
+  int pc;
+  int self;
+  int total;
+};
+
+static int cmp_site(const void *a, const void *b)
+{
+  const struct site *s1 = a;
+  const struct site *s2 = b;
+  if (s1->code != s2->code)
+    return (uintptr_t)s1->code < (uintptr_t)s2->code ? -1 : 1;
+  return s1->pc - s2->pc;
+}
+
+static int cmp_count(const void *a, const void *b)
+{
+  const struct site *s1 = a;
+  const struct site *s2 = b;
+  if (s1->self != s2->self) return s2->self - s1->self;
+  return s2->total - s1->total;
+}
+
+/* merge equal sites, counts are summed into the first one */
+static int merge_sites(struct site *sites, int n)
+{
+  qsort(sites, n, sizeof(struct site), cmp_site);
+  int k = 0;
+  for (int i = 0; i < n; i++) {
+    if (k > 0 && !cmp_site(&sites[k - 1], &sites[i])) {
+      sites[k - 1].self += sites[i].self;
+      sites[k - 1].total += sites[i].total;
+    } else {
+      sites[k++] = sites[i];
+    }
+  }
+  return k;
+}
+
+/* 'total' counts a function once per sample, even if it recurses */
+static int seen_outer(uintptr_t *p, int i, int depth, int bypc)
+{
+  for (int j = i + 1; j < depth; j++) {
+    if (p[1 + j * 2] == p[1 + i * 2] &&
+        (!bypc || p[2 + j * 2] == p[2 + i * 2]))
+      return 1;
+  }
+  return 0;
+}
+
+static void write_table(FILE *fp, long end)
+{
+  long cap = end / 2 + 1;
+  struct site *funcs = malloc(sizeof(struct site) * cap);
+  struct site *calls = malloc(sizeof(struct site) * cap);
+  int nfuncs = 0;
+  int ncalls = 0;
+  long pos = 0;
+  uintptr_t *p;
+
+  while ((p = next_sample(&pos, end))) {
+    int depth = p[0];
+    for (int i = 0; i < depth; i++) {
+      int outer = seen_outer(p, i, depth, 0);
+      if (i == 0 || !outer) {
+        funcs[nfuncs].code = (Object *)p[1 + i * 2];
+        funcs[nfuncs].pc = 0;
+        funcs[nfuncs].self = (i == 0);
+        funcs[nfuncs].total = !outer;
+        ++nfuncs;
+      }
+      /* the caller frames are stopped at their call sites */
+      if (i > 0 && !seen_outer(p, i, depth, 1)) {
+        calls[ncalls].code = (Object *)p[1 + i * 2];
+        calls[ncalls].pc = p[2 + i * 2];
+        calls[ncalls].self = 0;
+        calls[ncalls].total = 1;
+        ++ncalls;
+      }
+    }
+  }
+
+  nfuncs = merge_sites(funcs, nfuncs);
+  qsort(funcs, nfuncs, sizeof(struct site), cmp_count);
+  ncalls = merge_sites(calls, ncalls);
+  qsort(calls, ncalls, sizeof(struct site), cmp_count);
+
+  double n = prof.samples ? prof.samples : 1;
+  char name[256];
+
+  fprintf(fp, "samples: %ld, hz: %d, dropped: %ld, idle: %ld, truncated: %ld\n",
+          prof.samples, prof.hz, prof.dropped, prof.idle, prof.truncated);
+  fprintf(fp, "\n%8s %8s %8s %8s  %s\n",
+          "self", "self%", "total", "total%", "function");
+  for (int i = 0; i < nfuncs; i++) {
+    Code_Name(funcs[i].code, name, sizeof(name));
+    fprintf(fp, "%8d %7.2f%% %8d %7.2f%%  %s\n",
+            funcs[i].self, funcs[i].self * 100 / n,
+            funcs[i].total, funcs[i].total * 100 / n, name);
+  }
+  fprintf(fp, "\n%8s %8s  %s\n", "total", "total%", "call site");
+  for (int i = 0; i < ncalls; i++) {
+    Code_Name(calls[i].code, name, sizeof(name));
+    fprintf(fp, "%8d %7.2f%%  %s+%d\n",
+            calls[i].total, calls[i].total * 100 / n, name, calls[i].pc);
+  }
+
+  free(funcs);
+  free(calls);
+}
+
+static void write_file(char *path, void (*fn)(FILE *, long), long end)
+{
+  FILE *fp = fopen(path, "w");
+  if (!fp) {
+    error("profile: cannot open '%s', %s", path, strerror(errno));
+    return;
+  }
+  fn(fp, end);
+  fclose(fp);
+}
+
+void Profile_Stop(void)
+{
+  if (!prof.started) return;
+  prof.started = 0;
+
+  timer_delete(prof.timer);
+  sigaction(SIGPROF, &prof.oldact, NULL);
+
+  /* code objects are still alive, modules are freed after this */
+  long end = min(prof.used, prof.size);
+  if (prof.folded) write_file(prof.folded, write_folded, end);
+  if (prof.table) write_file(prof.table, write_table, end);
+
+  munmap(prof.buf, prof.size * sizeof(uintptr_t));
+  prof.buf = NULL;
+}
+
+#else /* !__linux__ */
+
+int Profile_Start(int hz, char *folded, char *table)
+{
+  UNUSED_PARAMETER(hz);
+  UNUSED_PARAMETER(folded);
+  UNUSED_PARAMETER(table);
+  warn("profile: not supported on this platform");
+  return -1;
+}
+
+void Profile_Stop(void)
+{
+}
+
+#endif
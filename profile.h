@@ -0,0 +1,35 @@
+
+#ifndef _KOALA_PROFILE_H_
+#define _KOALA_PROFILE_H_
+
+#include "routine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Sampling profiler, Linux only.
+  A SIGPROF timer ticking on the process cpu time interrupts the running
+  thread, and the handler copies the frame chain of its routine, as pairs
+  of (code, pc), into a preallocated buffer. Nothing is allocated or
+  aggregated in the handler, samples are resolved when it stops.
+  The 'pc' of a caller frame is its call site, the innermost one is not
+  saved by frame_loop() and is not reported.
+ */
+#define PROFILE_HZ          99
+#define PROFILE_MAX_DEPTH   64
+#define PROFILE_BUF_SIZE    (1 << 20)  /* words of the sample buffer */
+
+/*
+  'folded' is written as folded stacks for flamegraph.pl, 'table' as
+  self and total samples per function and per call site, either may be
+  NULL.
+ */
+int Profile_Start(int hz, char *folded, char *table);
+void Profile_Stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _KOALA_PROFILE_H_ */
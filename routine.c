@@ -6,8 +6,12 @@
 #include "stringobject.h"
 #include "koalastate.h"
 #include "listobject.h"
+#include "numberobject.h"
 #include "klc.h"
 #include "opcode.h"
+#include "jit.h"
+#include "stats.h"
+#include "gc.h"
 #include "log.h"
 
 #define TOP()   rt_stack_top(rt)
@@ -18,6 +22,90 @@ static void frame_loop(Frame *frame);
 
 /*-------------------------------------------------------------------------*/
 
+static void *frame_alloc(Routine *rt, int size)
+{
+  FrameChunk *chunk = rt->chunk;
+  if (chunk && chunk->top + size <= chunk->end) {
+    void *p = chunk->top;
+    chunk->top += size;
+    return p;
+  }
+
+  FrameChunk *next = chunk ? chunk->next : NULL;
+  if (!next || next->data + size > next->end) {
+    if (next) {
+      assert(!next->next);
+      free(next);
+    }
+    int bytes = max(FRAME_CHUNK_SIZE, size);
+    next = malloc(sizeof(FrameChunk) + bytes);
+    assert(next);
+    next->prev = chunk;
+    next->next = NULL;
+    next->end = next->data + bytes;
+    if (chunk) chunk->next = next;
+    debug("new frame chunk, %d bytes", bytes);
+  }
+
+  next->top = next->data + size;
+  rt->chunk = next;
+  return next->data;
+}
+
+static void frame_free(Frame *f)
+{
+  Routine *rt = f->rt;
+  FrameChunk *chunk = rt->chunk;
+  assert((char *)f >= chunk->data && (char *)f < chunk->top);
+  chunk->top = (char *)f;
+  if (chunk->top == chunk->data && chunk->prev) {
+    /* keep one spare chunk only */
+    if (chunk->next) {
+      free(chunk->next);
+      chunk->next = NULL;
+    }
+    rt->chunk = chunk->prev;
+  }
+}
+
+/* the module in which user defined types of locvars are searched */
+static Object *locvars_module(Object *ob)
+{
+  if (OB_CHECK_KLASS(ob, Module_Klass))
+    return ob;
+  if (OB_CHECK_KLASS(OB_KLASS(ob), Klass_Klass))
+    return (Object *)OB_KLASS(ob)->module;
+  return NULL;
+}
+
+/*
+  The initial values of locvars are the same for every call, so they are
+  built once and copied into the new frame.
+ */
+static TValue *locvars_template(CodeObject *code, Object *ob)
+{
+  Object *module = locvars_module(ob);
+  if (code->kf.tmpl && code->kf.tmplmod == module)
+    return code->kf.tmpl;
+
+  int size = code->kf.locvars;
+  TValue *tmpl = code->kf.tmpl;
+  if (!tmpl) tmpl = malloc(size * sizeof(TValue));
+  for (int i = 0; i < size; i++)
+    initnilvalue(tmpl + i);
+
+  MemberDef *item;
+  Vector_ForEach(item, &code->kf.locvec) {
+    assert(item->offset >= 0 && item->offset < size);
+    TValue_Set_TypeDesc(tmpl + item->offset, item->desc, ob);
+  }
+  debug("build locvars template, %d locvars", size);
+
+  code->kf.tmpl = tmpl;
+  code->kf.tmplmod = module;
+  return tmpl;
+}
+
 static void frame_new(Routine *rt, Object *ob, Object *cob, int argc)
 {
   CodeObject *code = OB_TYPE_OF(cob, CodeObject, Code_Klass);
@@ -25,53 +113,56 @@ static void frame_new(Routine *rt, Object *ob, Object *cob, int argc)
   int size = 0;
   if (CODE_ISKFUNC(code)) size = code->kf.locvars;
 
-  Frame *f = malloc(sizeof(Frame) + size * sizeof(TValue));
-  init_list_head(&f->link);
+  Frame *f = frame_alloc(rt, sizeof(Frame) + size * sizeof(TValue));
+  f->prev = rt->frame;
   f->rt = rt;
   f->argc = argc;
   f->code = (Object *)code;
   f->pc = 0;
   f->size = size;
-  for (int i = 0; i < size; i++)
-    initnilvalue(&f->locvars[i]);
-
-  debug("loc vars : %d", size);
-  if (size > 0 && Vector_Size(&code->kf.locvec) > 0) {
-    MemberDef *item;
-    char buf[64];
-    debug("------Set LocVar's Type-------");
-    Vector_ForEach(item, &code->kf.locvec) {
-      Type_ToString(item->desc, buf);
-      debug("set [%d] as '%s' type", item->offset, buf);
-      assert(item->offset >= 0 && item->offset < size);
-      TValue_Set_TypeDesc(f->locvars + item->offset, item->desc, ob);
-    }
-    debug("------Set LocVar's Type End---");
+  if (size > 0) {
+    TValue *tmpl = locvars_template(code, ob);
+    memcpy(f->locvars, tmpl, size * sizeof(TValue));
   }
 
-  if (rt->frame)
-    list_add(&rt->frame->link, &rt->frames);
   rt->frame = f;
 }
 
-static void frame_free(Frame *f)
+static void restore_previous_frame(Frame *f)
 {
-  assert(list_unlinked(&f->link));
-  free(f);
+  Routine *rt = f->rt;
+  assert(rt->frame == f);
+  rt->frame = f->prev;
+  frame_free(f);
 }
 
-static void restore_previous_frame(Frame *f)
+/*
+  Tail call replaces the current frame with the callee's one.
+  The frame is reused in place if the callee needs the same size, or else
+  it is freed and the new one is allocated at the same place of the frame
+  stack. Either way the frames do not grow in tail-recursive calls.
+ */
+static void frame_replace(Frame *f, Object *ob, Object *cob, int argc)
 {
-  Routine *rt = f->rt;
-  if (!list_empty(&rt->frames)) {
-    Frame *nf = list_first_entry(&rt->frames, Frame, link);
-    list_del(&nf->link);
-    rt->frame = nf;
-  } else {
-    rt->frame = NULL;
+  CodeObject *code = OB_TYPE_OF(cob, CodeObject, Code_Klass);
+
+  int size = 0;
+  if (CODE_ISKFUNC(code)) size = code->kf.locvars;
+
+  if (size != f->size) {
+    Routine *rt = f->rt;
+    restore_previous_frame(f);
+    frame_new(rt, ob, cob, argc);
+    return;
   }
 
-  frame_free(f);
+  f->argc = argc;
+  f->code = (Object *)code;
+  f->pc = 0;
+  if (size > 0) {
+    TValue *tmpl = locvars_template(code, ob);
+    memcpy(f->locvars, tmpl, size * sizeof(TValue));
+  }
 }
 
 static void start_cframe(Frame *f)
@@ -88,7 +179,7 @@ static void start_cframe(Frame *f)
   assert(f->argc <= sz);
 
   val = rt_stack_pop(rt);
-  obj = val.ob;
+  obj = VALUE_OBJECT(&val);
   if (f->argc > 0) args = Tuple_New(f->argc);
 
   int count = f->argc;
@@ -105,11 +196,65 @@ static void start_cframe(Frame *f)
   /* Save the result */
   sz = Tuple_Size(result);
   //FIXME: check results
+  rt_stack_ensure(rt, sz);
   for (i = sz - 1; i >= 0; i--) {
     val = Tuple_Get(result, i);
     PUSH(&val);
   }
 
+  /* Tuples are only used for passing values */
+  Tuple_Free(args);
+  Tuple_Free(result);
+
+  /* Get previous frame and free old frame */
+  restore_previous_frame(f);
+}
+
+static inline void reverse_values(TValue *vals, int count)
+{
+  TValue tmp;
+  for (int i = 0, j = count - 1; i < j; i++, j--) {
+    tmp = vals[i];
+    vals[i] = vals[j];
+    vals[j] = tmp;
+  }
+}
+
+/*
+  Native function is called with its arguments in place of stack.
+  Arguments are pushed reversely, so they are reversed into argv order,
+  and results are reversed back after the call, the first one on top.
+ */
+static void start_nframe(Frame *f)
+{
+  Routine *rt = f->rt;
+  CodeObject *code = (CodeObject *)f->code;
+  TValue val;
+
+  /* Prepare parameters */
+  int argc = f->argc;
+  assert(argc < rt_stack_size(rt));
+  val = rt_stack_pop(rt);
+  Object *obj = VALUE_OBJECT(&val);
+
+  int nret = Vector_Size(code->proto->proto.ret);
+  if (nret > argc) rt_stack_ensure(rt, nret - argc);
+  int base = rt->top - argc + 1;
+  TValue *argv = rt->stack + base;
+  reverse_values(argv, argc);
+
+  /* Call native function */
+  int n = code->nf(obj, argv, argc, argv, nret);
+  if (n < 0) {
+    error("call native function failed");
+    exit(-1);
+  }
+  assert(n <= nret);
+
+  /* Results are already in stack */
+  rt->top = base + n - 1;
+  reverse_values(argv, n);
+
   /* Get previous frame and free old frame */
   restore_previous_frame(f);
 }
@@ -138,18 +283,26 @@ static void start_kframe(Frame *f)
 }
 
 /*-------------------------------------------------------------------------*/
-int Routine_Init(Routine *rt)
+void rt_stack_grow(Routine *rt, int n)
 {
-  TValue *stack = malloc(STACK_SIZE * sizeof(TValue));
+  int size = rt->size ? rt->size : STACK_INIT_SIZE;
+  while (rt->top + 1 + n > size)
+    size <<= 1;
+  TValue *stack = realloc(rt->stack, size * sizeof(TValue));
   if (!stack) {
-    assert(0);
-    return -1;
+    error("grow routine's stack to %d failed", size);
+    exit(-1);
   }
-
+  debug("grow routine's stack: %d -> %d", rt->size, size);
   rt->stack = stack;
+  rt->size = size;
+}
+
+int Routine_Init(Routine *rt)
+{
   init_list_head(&rt->link);
   rt->frame = NULL;
-  init_list_head(&rt->frames);
+  rt->chunk = NULL;
   rt_stack_init(rt);
   list_add_tail(&rt->link, &gs.routines);
   return 0;
@@ -158,7 +311,19 @@ int Routine_Init(Routine *rt)
 void Routine_Fini(Routine *rt)
 {
   list_del(&rt->link);
-  assert(list_empty(&rt->frames));
+  assert(!rt->frame);
+  FrameChunk *chunk = rt->chunk;
+  if (chunk) {
+    while (chunk->prev)
+      chunk = chunk->prev;
+    FrameChunk *next;
+    while (chunk) {
+      next = chunk->next;
+      free(chunk);
+      chunk = next;
+    }
+    rt->chunk = NULL;
+  }
   free(rt->stack);
 }
 
@@ -175,7 +340,6 @@ Routine *Routine_New(Object *code, Object *ob, Object *args)
 {
   Routine *rt = calloc(1, sizeof(Routine));
   init_list_head(&rt->link);
-  init_list_head(&rt->frames);
   rt_stack_init(rt);
 
   /* prepare parameters */
@@ -205,7 +369,9 @@ static void routine_task_func(struct task *tsk)
   Frame *f = rt->frame;
 
   while (f) {
-    if (CODE_ISCFUNC(f->code)) {
+    if (CODE_ISNFUNC(f->code)) {
+      start_nframe(f);
+    } else if (CODE_ISCFUNC(f->code)) {
       start_cframe(f);
     } else if (CODE_ISKFUNC(f->code)) {
       if (f->pc == 0)
@@ -220,11 +386,14 @@ static void routine_task_func(struct task *tsk)
 }
 */
 
+__thread Routine *Routine_Current;
+
 void Routine_Run(Routine *rt, Object *code, Object *ob, Object *args)
 {
   /* prepare arguments */
   TValue val;
   int size = Tuple_Size(args);
+  rt_stack_ensure(rt, size + 1);
   for (int i = size - 1; i >= 0; i--) {
     val = Tuple_Get(args, i);
     VALUE_ASSERT(&val);
@@ -236,10 +405,16 @@ void Routine_Run(Routine *rt, Object *code, Object *ob, Object *args)
   /* new frame */
   frame_new(rt, ob, code, size);
 
+  Routine *prev = Routine_Current;
+  Routine_Current = rt;
+
   Frame *f = rt->frame;
 
   while (f) {
-    if (CODE_ISCFUNC(f->code)) {
+    GC_SAFEPOINT();
+    if (CODE_ISNFUNC(f->code)) {
+      start_nframe(f);
+    } else if (CODE_ISCFUNC(f->code)) {
       start_cframe(f);
     } else if (CODE_ISKFUNC(f->code)) {
       if (f->pc == 0)
@@ -251,59 +426,35 @@ void Routine_Run(Routine *rt, Object *code, Object *ob, Object *args)
     }
     f = rt->frame;
   }
-}
-
-/*-------------------------------------------------------------------------*/
-
-#define NEXT_CODE(f, codes) codes[f->pc++]
-
-static inline uint8 fetch_byte(Frame *frame, CodeObject *code)
-{
-  assert(frame->pc < code->kf.size);
-  return NEXT_CODE(frame, code->kf.codes);
-}
 
-static inline uint16 fetch_2bytes(Frame *frame, CodeObject *code)
-{
-  assert(frame->pc < code->kf.size);
-  //endian?
-  uint8 l = NEXT_CODE(frame, code->kf.codes);
-  uint8 h = NEXT_CODE(frame, code->kf.codes);
-  return (h << 8) + (l << 0);
-}
-
-static inline uint32 fetch_4bytes(Frame *frame, CodeObject *code)
-{
-  assert(frame->pc < code->kf.size);
-  //endian?
-  uint8 l1 = NEXT_CODE(frame, code->kf.codes);
-  uint8 l2 = NEXT_CODE(frame, code->kf.codes);
-  uint8 h1 = NEXT_CODE(frame, code->kf.codes);
-  uint8 h2 = NEXT_CODE(frame, code->kf.codes);
-  return (h2 << 24) + (h1 << 16) + (l2 << 8) + (l1 << 0);
+  Routine_Current = prev;
 }
 
-static inline uint8 fetch_code(Frame *frame, CodeObject *code)
-{
-  return fetch_byte(frame, code);
-}
+/*-------------------------------------------------------------------------*/
 
 static inline TValue index_const(int index, Object *consts)
 {
   return Tuple_Get(consts, index);
 }
 
+/* indexes and types of locvars of verified codes are checked at load */
 static inline TValue load(Frame *f, int index)
 {
-  assert(index < f->size);
+  assert(KFunc_Verified(f->code) || index < f->size);
   return f->locvars[index];
 }
 
 static inline void store(Frame *f, int index, TValue *val)
 {
-  VALUE_ASSERT(val);
-  assert(index < f->size);
-  assert(!TValue_Check(f->locvars + index, val));
+  if (!KFunc_Verified(f->code)) {
+    VALUE_ASSERT(val);
+    assert(index < f->size);
+    assert(!TValue_Check(f->locvars + index, val));
+  }
+#ifdef KOALA_NANBOX
+  /* the type of a locvar is not kept in its value */
+  f->locvars[index] = *val;
+#else
   TValue *v = &f->locvars[index];
   if (v->klazz == &Int_Klass) {
     v->ival = val->ival;
@@ -314,6 +465,7 @@ static inline void store(Frame *f, int index, TValue *val)
   } else {
     v->ob = val->ob;
   }
+#endif
 }
 
 static Object *getcode(Object *ob, char *name, Object **rob)
@@ -362,6 +514,73 @@ static TValue getfield(Object *ob, char *field)
   }
 }
 
+/*
+  Inline cache of OP_GETFIELD and OP_SETFIELD.
+  An entry is keyed on the klass of the object and the klass of its head
+  object, because the base chain behind a trait's sub-object depends on
+  the class the trait is mixed into.
+ */
+#define FIELD_CACHE_SIZE 4
+
+struct field_cache {
+  int count;
+  struct field_entry {
+    Klass *klazz;
+    Klass *head;
+    int hops;
+    int index;
+  } entries[FIELD_CACHE_SIZE];
+};
+
+static struct field_entry *field_cache_miss(Instr *i, Object *ob,
+                                            Object *consts)
+{
+  static struct field_entry megamorphic;
+  struct field_cache *cache = i->cache;
+  struct field_entry *e;
+  TValue val = index_const(i->arg, consts);
+  char *field = String_RawString(VALUE_OBJECT(&val));
+  debug("field cache miss '%s'", field);
+
+  if (!cache) {
+    cache = calloc(1, sizeof(struct field_cache));
+    i->cache = cache;
+  }
+
+  if (cache->count < FIELD_CACHE_SIZE)
+    e = cache->entries + cache->count++;
+  else
+    e = &megamorphic;
+
+  e->klazz = OB_KLASS(ob);
+  e->head = OB_KLASS(OB_Head(ob));
+  e->index = Object_Field_Index(ob, field, &e->hops);
+  return e;
+}
+
+static inline TValue *field_cache_lookup(Instr *i, Object *ob, Object *consts)
+{
+  struct field_cache *cache = i->cache;
+  struct field_entry *e = NULL;
+  Klass *klazz = OB_KLASS(ob);
+  Klass *head = OB_KLASS(OB_Head(ob));
+
+  if (cache) {
+    for (int k = 0; k < cache->count; k++) {
+      if (cache->entries[k].klazz == klazz && cache->entries[k].head == head) {
+        e = cache->entries + k;
+        break;
+      }
+    }
+  }
+
+  if (!e) e = field_cache_miss(i, ob, consts);
+
+  for (int k = e->hops; k > 0; k--)
+    ob = OB_Base(ob);
+  return (TValue *)(ob + 1) + e->index;
+}
+
 // static int check_virtual_call(TValue *val, char *name)
 // {
 // 	VALUE_ASSERT_OBJECT(val);
@@ -407,6 +626,148 @@ static void check_args(Routine *rt, int argc, TypeDesc *proto, char *name)
   }
 }
 
+/*
+  Inline cache of OP_CALL.
+  An entry is keyed on the receiver's klass(or the receiver itself if it is
+  a module) and the klass of its head object. It saves the resolved code
+  and the receiver adjustment 'rob', as OB_Base hops from the head object,
+  so a hit needs neither name lookups nor the OB_Head chain walk.
+ */
+#define CALL_CACHE_SIZE 4
+
+struct call_cache {
+  int count;
+  struct call_entry {
+    void *key;
+    Klass *head;
+    Object *code;
+    int hops;
+  } entries[CALL_CACHE_SIZE];
+#ifdef KOALA_STATS
+  void *stats;
+#endif
+};
+
+static struct {
+#ifdef KOALA_STATS
+  uint64 hits;        /* not counted on the fast path without stats */
+#endif
+  uint64 misses;
+  uint64 fallbacks;   /* lookups of sites whose cache is full */
+  int sites;
+  int megasites;      /* sites which have seen too many receivers */
+} callstats;
+
+static inline void *call_cache_key(Object *ob)
+{
+  return OB_CHECK_KLASS(ob, Module_Klass) ? (void *)ob : (void *)OB_KLASS(ob);
+}
+
+static struct call_entry *call_cache_miss(Routine *rt, Instr *i, Object *ob,
+                                          Object *consts)
+{
+  static struct call_entry megamorphic;
+  struct call_cache *cache = i->cache;
+  struct call_entry *e;
+  TValue val = index_const(i->arg, consts);
+  char *name = String_RawString(VALUE_OBJECT(&val));
+  debug("call cache miss '%s'", name);
+
+  Object *rob = NULL;
+  Object *meth = getcode(ob, name, &rob);
+  assert(rob);
+  assert(meth);
+
+  /*
+    arguments are checked once per receiver at each call site,
+    and never in verified codes, whose calls are checked at load.
+   */
+  if (CODE_ISKFUNC(meth) && !KFunc_Verified(rt->frame->code)) {
+    //FIXME: for c function
+    CodeObject *code = OB_TYPE_OF(meth, CodeObject, Code_Klass);
+    check_args(rt, i->argc, code->proto, name);
+  }
+
+  if (!cache) {
+    cache = calloc(1, sizeof(struct call_cache));
+    i->cache = cache;
+    callstats.sites++;
+  }
+
+  if (cache->count < CALL_CACHE_SIZE) {
+    callstats.misses++;
+    e = cache->entries + cache->count++;
+  } else {
+    if (cache->count++ == CALL_CACHE_SIZE)
+      callstats.megasites++;
+    callstats.fallbacks++;
+    e = &megamorphic;
+  }
+
+  e->key = call_cache_key(ob);
+  e->head = OB_KLASS(OB_Head(ob));
+  e->code = meth;
+  e->hops = 0;
+  Object *base = OB_Head(ob);
+  while (base != rob) {
+    assert(OB_HasBase(base));
+    base = OB_Base(base);
+    e->hops++;
+  }
+  return e;
+}
+
+static inline Object *call_cache_lookup(Routine *rt, Instr *i, Object *ob,
+                                        Object *consts, Object **rob)
+{
+  struct call_cache *cache = i->cache;
+  struct call_entry *e = NULL;
+  void *key = call_cache_key(ob);
+  Klass *head = OB_KLASS(OB_Head(ob));
+
+  if (cache) {
+    int count = min(cache->count, CALL_CACHE_SIZE);
+    for (int k = 0; k < count; k++) {
+      if (cache->entries[k].key == key && cache->entries[k].head == head) {
+        e = cache->entries + k;
+        break;
+      }
+    }
+  }
+
+#ifdef KOALA_STATS
+  int hit = e != NULL;
+  callstats.hits += hit;
+#endif
+
+  if (!e) e = call_cache_miss(rt, i, ob, consts);
+
+#ifdef KOALA_STATS
+  if (Stats_Enabled) {
+    TValue val = index_const(i->arg, consts);
+    Stats_Call(&((struct call_cache *)i->cache)->stats, rt->frame->code, i,
+               String_RawString(VALUE_OBJECT(&val)), ob, hit);
+  }
+#endif
+
+  ob = OB_Head(ob);
+  for (int k = e->hops; k > 0; k--)
+    ob = OB_Base(ob);
+  *rob = ob;
+  return e->code;
+}
+
+void Routine_Show_CallStats(void)
+{
+  info("call sites: %d, megamorphic sites: %d", callstats.sites,
+       callstats.megasites);
+#ifdef KOALA_STATS
+  info("call cache hits: %llu", callstats.hits);
+#endif
+  info("call cache misses: %llu, megamorphic fallbacks: %llu",
+       callstats.misses, callstats.fallbacks);
+}
+
 int tonumber(TValue *v)
 {
   UNUSED_PARAMETER(v);
@@ -437,7 +798,8 @@ void do_new_array(Routine *rt, int count)
     List_Set(ob, i, &val);
     ++i;
   }
-  TValue v = {.klazz = &List_Klass, .ob = ob};
+  TValue v;
+  setobjvalue(&v, ob);
   PUSH(&v);
 }
 
@@ -446,7 +808,7 @@ TValue do_load_subscr(Routine *rt)
   TValue w = POP();
   TValue v = POP();
   // v[w]
-  MapOperations *ops = v.klazz->mapops;
+  MapOperations *ops = VALUE_KLASS(&v)->mapops;
   if (ops && ops->get) {
     return ops->get(&v, &w);
   } else {
@@ -461,7 +823,7 @@ void do_store_subscr(Routine *rt)
   TValue v = POP();
   TValue u = POP();
   // v[w] = u
-  MapOperations *ops = v.klazz->mapops;
+  MapOperations *ops = VALUE_KLASS(&v)->mapops;
   if (ops && ops->set) {
     ops->set(&v, &w, &u);
   } else {
@@ -469,14 +831,251 @@ void do_store_subscr(Routine *rt)
   }
 }
 
+/*
+  Instructions which are not simple enough to be inlined.
+  They are shared by frame_loop() and the native codes of jit.
+ */
+void do_loadm(Routine *rt, Object *consts, Instr *i)
+{
+  TValue val = index_const(i->arg, consts);
+  char *path = String_RawString(VALUE_OBJECT(&val));
+  debug("load module '%s'", path);
+  Object *ob = Koala_Load_Module(path);
+  assert(ob);
+  setobjvalue(&val, ob);
+  PUSH(&val);
+}
+
+void do_getm(Routine *rt)
+{
+  TValue val = TOP();
+  Object *ob = VALUE_OBJECT(&val);
+  if (!OB_CHECK_KLASS(ob, Module_Klass)) {
+    val = POP();
+    Klass *klazz = OB_KLASS(ob);
+    OB_ASSERT_KLASS(klazz, Klass_Klass);
+    assert(klazz->module);
+    setobjvalue(&val, klazz->module);
+    PUSH(&val);
+  }
+}
+
+void do_getfield(Routine *rt, Object *consts, Instr *i, Object *ob)
+{
+  TValue val;
+  if (!OB_CHECK_KLASS(ob, Module_Klass)) {
+    val = *field_cache_lookup(i, ob, consts);
+    VALUE_ASSERT(&val);
+    PUSH(&val);
+    return;
+  }
+  TValue name = index_const(i->arg, consts);
+  char *field = String_RawString(VALUE_OBJECT(&name));
+  debug("getfield '%s'", field);
+  val = getfield(ob, field);
+  if (VALUE_ISNIL(&val)) {
+    Object *rob = NULL;
+    ob = getcode(ob, field, &rob);
+    setobjvalue(&val, ob);
+  }
+  PUSH(&val);
+}
+
+void do_setfield(Routine *rt, Object *consts, Instr *i, Object *ob)
+{
+  TValue val = POP();
+  VALUE_ASSERT(&val);
+  if (!OB_CHECK_KLASS(ob, Module_Klass)) {
+    GC_Write_Barrier(ob, &val);
+    *field_cache_lookup(i, ob, consts) = val;
+    return;
+  }
+  TValue name = index_const(i->arg, consts);
+  char *field = String_RawString(VALUE_OBJECT(&name));
+  debug("setfield '%s'", field);
+  setfield(ob, field, &val);
+}
+
+void do_new(Routine *rt, Object *consts, Instr *i)
+{
+  TValue val = index_const(i->arg, consts);
+  char *name = String_RawString(VALUE_OBJECT(&val));
+  val = POP();
+  debug("OP_NEW, %s, argc:%d", name, i->argc);
+  Object *ob = VALUE_OBJECT(&val);
+  Klass *klazz = Module_Get_Class(ob, name);
+  assert(klazz);
+  assert(klazz != &Klass_Klass);
+  assert(OB_Base(klazz) != (Object *)&Klass_Klass);
+  ob = klazz->ob_alloc(klazz);
+  setobjvalue(&val, ob);
+  PUSH(&val);
+}
+
+/* the frame is suspended at 'pc', and is resumed after the callee returns */
+void do_call(Frame *f, Instr *i, int pc)
+{
+  Routine *rt = f->rt;
+  Object *consts = ((CodeObject *)f->code)->kf.consts;
+  debug("OP_CALL, argc:%d", i->argc);
+  TValue val = TOP();
+  Object *ob = VALUE_OBJECT(&val);
+  //assert(!check_virtual_call(&val, name));
+  Object *rob = NULL;
+  Object *meth = call_cache_lookup(rt, i, ob, consts, &rob);
+  if (rob != ob) {
+    debug(">>>>>update object<<<<<");
+    POP();
+    setobjvalue(&val, rob);
+    PUSH(&val);
+  }
+  f->pc = pc;
+  frame_new(rt, rob, meth, i->argc);
+}
+
+void do_tailcall(Frame *f, Instr *i)
+{
+  Routine *rt = f->rt;
+  Object *consts = ((CodeObject *)f->code)->kf.consts;
+  debug("OP_TAILCALL, argc:%d", i->argc);
+  TValue val = TOP();
+  Object *ob = VALUE_OBJECT(&val);
+  Object *rob = NULL;
+  Object *meth = call_cache_lookup(rt, i, ob, consts, &rob);
+  if (rob != ob) {
+    POP();
+    setobjvalue(&val, rob);
+    PUSH(&val);
+  }
+  frame_replace(f, rob, meth, i->argc);
+}
+
+void do_return(Frame *f)
+{
+  restore_previous_frame(f);
+}
+
+/* generic number operation of OP_ADD ~ OP_LNOT, by the left operand */
+void do_number_op(Routine *rt, int op)
+{
+  TValue v1 = POP();
+  TValue v2;
+  TValue res = NilValue;
+  NumberOperations *ops = VALUE_KLASS(&v1) ? VALUE_KLASS(&v1)->numops : NULL;
+
+#define NUMBER_OP(_case_, _op_) \
+  case _case_: {                  \
+    v2 = POP();                   \
+    if (!ops) break;              \
+    if (!ops->_op_) exit(-1);     \
+    res = ops->_op_(&v1, &v2);    \
+    break;                        \
+  }
+#define NUMBER_UNARY_OP(_case_, _op_) \
+  case _case_: {                  \
+    if (!ops) break;              \
+    if (!ops->_op_) exit(-1);     \
+    res = ops->_op_(&v1);         \
+    break;                        \
+  }
+
+  switch (op) {
+    NUMBER_OP(OP_ADD, add)
+    NUMBER_OP(OP_SUB, sub)
+    NUMBER_OP(OP_MUL, mul)
+    NUMBER_OP(OP_DIV, div)
+    NUMBER_OP(OP_MOD, mod)
+    NUMBER_UNARY_OP(OP_NEG, neg)
+    NUMBER_OP(OP_GT, gt)
+    NUMBER_OP(OP_GE, ge)
+    NUMBER_OP(OP_LT, lt)
+    NUMBER_OP(OP_LE, le)
+    NUMBER_OP(OP_EQ, eq)
+    NUMBER_OP(OP_NEQ, neq)
+    NUMBER_OP(OP_BAND, band)
+    NUMBER_OP(OP_BOR, bor)
+    NUMBER_OP(OP_BXOR, bxor)
+    NUMBER_UNARY_OP(OP_BNOT, bnot)
+    NUMBER_OP(OP_LSHIFT, lshift)
+    NUMBER_OP(OP_RSHIFT, rshift)
+    NUMBER_OP(OP_LAND, land)
+    NUMBER_OP(OP_LOR, lor)
+    NUMBER_UNARY_OP(OP_LNOT, lnot)
+    default: {
+      kassert(0, "unknown number operation:%d", op);
+      break;
+    }
+  }
+
+#undef NUMBER_OP
+#undef NUMBER_UNARY_OP
+
+  PUSH(&res);
+}
+
+/*
+  Instruction dispatch.
+  With GCC's labels-as-values every handler ends with its own indirect jump
+  through 'dispatch_table', so the branch predictor sees one dispatch site
+  per opcode instead of the single shared jump of a switch.
+ */
+#define USE_COMPUTED_GOTO KOALA_COMPUTED_GOTO
+
+#define TARGET(op)      TARGET_LABEL(TARGET_##op, op)
+
+#if KOALA_JIT
+/* count calls and backward jumps of the code, and compile it when hot */
+static inline int jit_hot(CodeObject *code)
+{
+  if (!Jit_Threshold || code->kf.hotness < 0) return 0;
+  if (++code->kf.hotness < Jit_Threshold) return 0;
+  return !Jit_Compile(code);
+}
+
+/* the frame goes on in native codes from the jump target */
+#define JIT_BACKWARD_JUMP() do {  \
+  if (ip <= i && jit_hot(code)) { \
+    frame->pc = ip - insts;       \
+    Jit_Run(frame);               \
+    return;                       \
+  }                               \
+} while (0)
+#else
+#define JIT_BACKWARD_JUMP() ((void)0)
+#endif
+
+/* loops are safepoints of gc, the frame is scanned at the jump target */
+#define BACKWARD_JUMP() do {            \
+  if (ip <= i && GC_PENDING()) {        \
+    frame->pc = ip - insts;             \
+    GC_Step();                          \
+  }                                     \
+  JIT_BACKWARD_JUMP();                  \
+} while (0)
+
+#if USE_COMPUTED_GOTO
+#define TARGET_LABEL(label, op) label:
+#define DEFAULT_TARGET  TARGET_default:
+#define DISPATCH()      do { \
+  i = ip++; \
+  STATS_OP(lastop, i->op); \
+  goto *dispatch_table[i->op]; \
+} while (0)
+#else
+#define TARGET_LABEL(label, op) case op:
+#define DEFAULT_TARGET  default:
+#define DISPATCH()      continue
+#endif
+
 #define case_two_args_op(_case_, _op_)  \
-  case _case_: {                        \
+  TARGET_LABEL(TARGET_##_case_, _case_) { \
     TValue v1 = POP();                  \
     TValue v2 = POP();                  \
     TValue res = NilValue;              \
     NumberOperations *ops;              \
-    if (v1.klazz && v1.klazz->numops) { \
-      ops = v1.klazz->numops;           \
+    Klass *k1 = VALUE_KLASS(&v1);       \
+    if (k1 && k1->numops) {             \
+      ops = k1->numops;                 \
       if (ops->_op_) {                  \
         res = ops->_op_(&v1, &v2);      \
       } else {                          \
@@ -484,16 +1083,80 @@ void do_store_subscr(Routine *rt)
       }                                 \
     }                                   \
     PUSH(&res);                         \
-    break;                              \
+    DISPATCH();                         \
+  }
+
+/*
+  Generic operation which is quickened to _ii_ or _ff_, after its operands
+  are both Int or both Float for QUICKEN_THRESHOLD times in a row.
+ */
+#define QUICKEN_THRESHOLD 4
+
+#define case_quicken_op(_case_, _op_, _ii_, _ff_) \
+  TARGET_LABEL(TARGET_##_case_, _case_) { \
+    TValue v1 = POP();                  \
+    TValue v2 = POP();                  \
+    TValue res = NilValue;              \
+    NumberOperations *ops;              \
+    quicken(i, &v1, &v2, _ii_, _ff_);   \
+    Klass *k1 = VALUE_KLASS(&v1);       \
+    if (k1 && k1->numops) {             \
+      ops = k1->numops;                 \
+      if (ops->_op_) {                  \
+        res = ops->_op_(&v1, &v2);      \
+      } else {                          \
+        exit(-1);                       \
+      }                                 \
+    }                                   \
+    PUSH(&res);                         \
+    DISPATCH();                         \
+  }
+
+/*
+  Quickened operation. The left operand is on the top of the stack and the
+  result replaces the right one. If the guard fails, the instruction is
+  rewritten back to its generic form and executed again.
+ */
+#define case_int_op(_case_, _generic_, _set_, _expr_) \
+  TARGET_LABEL(TARGET_##_case_, _case_) { \
+    TValue *v1 = rt->stack + rt->top;   \
+    TValue *v2 = v1 - 1;                \
+    if (VALUE_ISINT(v1) && VALUE_ISINT(v2)) { \
+      int64 a = VALUE_INT(v1);          \
+      int64 b = VALUE_INT(v2);          \
+      _set_(v2, _expr_);                \
+      rt->top--;                        \
+      DISPATCH();                       \
+    }                                   \
+    unquicken(i, _generic_);            \
+    ip--;                               \
+    DISPATCH();                         \
+  }
+
+#define case_float_op(_case_, _generic_, _set_, _expr_) \
+  TARGET_LABEL(TARGET_##_case_, _case_) { \
+    TValue *v1 = rt->stack + rt->top;   \
+    TValue *v2 = v1 - 1;                \
+    if (VALUE_ISFLOAT(v1) && VALUE_ISFLOAT(v2)) { \
+      float64 a = VALUE_FLOAT(v1);      \
+      float64 b = VALUE_FLOAT(v2);      \
+      _set_(v2, _expr_);                \
+      rt->top--;                        \
+      DISPATCH();                       \
+    }                                   \
+    unquicken(i, _generic_);            \
+    ip--;                               \
+    DISPATCH();                         \
   }
 
 #define case_one_arg_op(_case_, _op_)   \
-  case _case_: {                        \
+  TARGET_LABEL(TARGET_##_case_, _case_) { \
     TValue v = POP();                   \
     TValue res = NilValue;              \
     NumberOperations *ops;              \
-    if (v.klazz && v.klazz->numops) {   \
-      ops = v.klazz->numops;            \
+    Klass *k = VALUE_KLASS(&v);         \
+    if (k && k->numops) {               \
+      ops = k->numops;                  \
       if (ops->_op_) {                  \
         res = ops->_op_(&v);            \
       } else {                          \
@@ -501,24 +1164,24 @@ void do_store_subscr(Routine *rt)
       }                                 \
     }                                   \
     PUSH(&res);                         \
-    break;                              \
+    DISPATCH();                         \
   }
 
 #define NUMBER_OPERATION_CASES          \
   /* arithmetic */                      \
-  case_two_args_op(OP_ADD, add)         \
-  case_two_args_op(OP_SUB, sub)         \
-  case_two_args_op(OP_MUL, mul)         \
+  case_quicken_op(OP_ADD, add, OP_ADD_II, OP_ADD_FF) \
+  case_quicken_op(OP_SUB, sub, OP_SUB_II, OP_SUB_FF) \
+  case_quicken_op(OP_MUL, mul, OP_MUL_II, OP_MUL_FF) \
   case_two_args_op(OP_DIV, div)         \
   case_two_args_op(OP_MOD, mod)         \
   case_one_arg_op(OP_NEG, neg)          \
   /* comparison */                      \
-  case_two_args_op(OP_GT, gt)           \
-  case_two_args_op(OP_GE, ge)           \
-  case_two_args_op(OP_LT, lt)           \
-  case_two_args_op(OP_LE, le)           \
-  case_two_args_op(OP_EQ, eq)           \
-  case_two_args_op(OP_NEQ, neq)         \
+  case_quicken_op(OP_GT, gt, OP_GT_II, OP_GT_FF)     \
+  case_quicken_op(OP_GE, ge, OP_GE_II, OP_GE_FF)     \
+  case_quicken_op(OP_LT, lt, OP_LT_II, OP_LT_FF)     \
+  case_quicken_op(OP_LE, le, OP_LE_II, OP_LE_FF)     \
+  case_quicken_op(OP_EQ, eq, OP_EQ_II, OP_EQ_FF)     \
+  case_quicken_op(OP_NEQ, neq, OP_NEQ_II, OP_NEQ_FF) \
   /* bit */                             \
   case_two_args_op(OP_BAND, band)       \
   case_two_args_op(OP_BOR, bor)         \
@@ -531,233 +1194,391 @@ void do_store_subscr(Routine *rt)
   case_two_args_op(OP_LOR, lor)         \
   case_one_arg_op(OP_LNOT, lnot)
 
+/* the same wrapping semantics as int_add etc. in numberobject.c */
+#define QUICKENED_OPERATION_CASES       \
+  case_int_op(OP_ADD_II, OP_ADD, setivalue, (uint64)a + (uint64)b)   \
+  case_float_op(OP_ADD_FF, OP_ADD, setfltvalue, a + b)               \
+  case_int_op(OP_SUB_II, OP_SUB, setivalue, (uint64)a - (uint64)b)   \
+  case_float_op(OP_SUB_FF, OP_SUB, setfltvalue, a - b)               \
+  case_int_op(OP_MUL_II, OP_MUL, setivalue, (uint64)a * (uint64)b)   \
+  case_float_op(OP_MUL_FF, OP_MUL, setfltvalue, a * b)               \
+  case_int_op(OP_GT_II, OP_GT, setbvalue, a > b)     \
+  case_float_op(OP_GT_FF, OP_GT, setbvalue, a > b)   \
+  case_int_op(OP_GE_II, OP_GE, setbvalue, a >= b)    \
+  case_float_op(OP_GE_FF, OP_GE, setbvalue, a >= b)  \
+  case_int_op(OP_LT_II, OP_LT, setbvalue, a < b)     \
+  case_float_op(OP_LT_FF, OP_LT, setbvalue, a < b)   \
+  case_int_op(OP_LE_II, OP_LE, setbvalue, a <= b)    \
+  case_float_op(OP_LE_FF, OP_LE, setbvalue, a <= b)  \
+  case_int_op(OP_EQ_II, OP_EQ, setbvalue, a == b)    \
+  case_float_op(OP_EQ_FF, OP_EQ, setbvalue, a == b)  \
+  case_int_op(OP_NEQ_II, OP_NEQ, setbvalue, a != b)  \
+  case_float_op(OP_NEQ_FF, OP_NEQ, setbvalue, a != b)
+
+/*
+  Register-style operation. Both operands are in locvars, and the result is
+  pushed into stack(OP2_XXX) or stored into locvars(OP3_XXX).
+  Int and Float operands are computed inline, Int ones only if '_iok_',
+  e.g. an Int divided by zero is left to numops.
+ */
+#define locvars_op(_op_, _a_, _b_, _iok_, _iexpr_, _fexpr_) do { \
+  assert((_a_) < frame->size && (_b_) < frame->size); \
+  TValue *v1 = frame->locvars + (_a_);  \
+  TValue *v2 = frame->locvars + (_b_);  \
+  if (VALUE_ISINT(v1) && VALUE_ISINT(v2) && (_iok_)) { \
+    int64 a = VALUE_INT(v1);            \
+    int64 b = VALUE_INT(v2);            \
+    setivalue(&val, _iexpr_);           \
+  } else if (VALUE_ISFLOAT(v1) && VALUE_ISFLOAT(v2)) { \
+    float64 a = VALUE_FLOAT(v1);        \
+    float64 b = VALUE_FLOAT(v2);        \
+    setfltvalue(&val, _fexpr_);         \
+  } else if (VALUE_KLASS(v1) && VALUE_KLASS(v1)->numops && \
+             VALUE_KLASS(v1)->numops->_op_) { \
+    val = VALUE_KLASS(v1)->numops->_op_(v1, v2); \
+  } else {                              \
+    exit(-1);                           \
+  }                                     \
+} while (0)
+
+#define case_locvars_op(_case_, _op_, _iok_, _iexpr_, _fexpr_) \
+  TARGET_LABEL(TARGET_##_case_, _case_) { \
+    locvars_op(_op_, i->arg, i->argc, _iok_, _iexpr_, _fexpr_); \
+    PUSH(&val);                         \
+    DISPATCH();                         \
+  }
+
+/* the two operands are packed in 'arg' and the result is in 'argc' */
+#define case_locvars_store_op(_case_, _op_, _iok_, _iexpr_, _fexpr_) \
+  TARGET_LABEL(TARGET_##_case_, _case_) { \
+    locvars_op(_op_, i->arg & 0xffff, (int)((uint32)i->arg >> 16), \
+               _iok_, _iexpr_, _fexpr_); \
+    store(frame, i->argc, &val);        \
+    DISPATCH();                         \
+  }
+
+#define LOCVARS_OPERATION_CASES         \
+  case_locvars_op(OP2_ADD, add, 1, (uint64)a + (uint64)b, a + b) \
+  case_locvars_op(OP2_SUB, sub, 1, (uint64)a - (uint64)b, a - b) \
+  case_locvars_op(OP2_MUL, mul, 1, (uint64)a * (uint64)b, a * b) \
+  case_locvars_op(OP2_DIV, div, VALUE_INT(v2), Int_Div(a, b), a / b) \
+  case_locvars_store_op(OP3_ADD, add, 1, (uint64)a + (uint64)b, a + b) \
+  case_locvars_store_op(OP3_SUB, sub, 1, (uint64)a - (uint64)b, a - b) \
+  case_locvars_store_op(OP3_MUL, mul, 1, (uint64)a * (uint64)b, a * b) \
+  case_locvars_store_op(OP3_DIV, div, VALUE_INT(v2), Int_Div(a, b), a / b)
+
+/*
+  Comparison fused with the following conditional jump.
+  It takes the operands from stack as the comparison does.
+ */
+#define case_compare_jump(_case_, _op_, _cmp_, _cond_) \
+  TARGET_LABEL(TARGET_##_case_, _case_) { \
+    TValue *v1 = rt->stack + rt->top;   \
+    TValue *v2 = v1 - 1;                \
+    int res;                            \
+    if (VALUE_ISINT(v1) && VALUE_ISINT(v2)) { \
+      res = VALUE_INT(v1) _cmp_ VALUE_INT(v2); \
+    } else if (VALUE_ISFLOAT(v1) && VALUE_ISFLOAT(v2)) { \
+      res = VALUE_FLOAT(v1) _cmp_ VALUE_FLOAT(v2); \
+    } else if (VALUE_KLASS(v1) && VALUE_KLASS(v1)->numops && \
+               VALUE_KLASS(v1)->numops->_op_) { \
+      val = VALUE_KLASS(v1)->numops->_op_(v1, v2); \
+      VALUE_ASSERT_BOOL(&val);          \
+      res = VALUE_BOOL(&val);           \
+    } else {                            \
+      exit(-1);                         \
+    }                                   \
+    rt->top -= 2;                       \
+    if (!res == !(_cond_)) {            \
+      ip = insts + i->arg;              \
+      BACKWARD_JUMP();                  \
+    }                                   \
+    DISPATCH();                         \
+  }
+
+#define COMPARE_JUMP_CASES              \
+  case_compare_jump(OP_GT_JUMP_TRUE, gt, >, 1)    \
+  case_compare_jump(OP_GT_JUMP_FALSE, gt, >, 0)   \
+  case_compare_jump(OP_GE_JUMP_TRUE, ge, >=, 1)   \
+  case_compare_jump(OP_GE_JUMP_FALSE, ge, >=, 0)  \
+  case_compare_jump(OP_LT_JUMP_TRUE, lt, <, 1)    \
+  case_compare_jump(OP_LT_JUMP_FALSE, lt, <, 0)   \
+  case_compare_jump(OP_LE_JUMP_TRUE, le, <=, 1)   \
+  case_compare_jump(OP_LE_JUMP_FALSE, le, <=, 0)  \
+  case_compare_jump(OP_EQ_JUMP_TRUE, eq, ==, 1)   \
+  case_compare_jump(OP_EQ_JUMP_FALSE, eq, ==, 0)  \
+  case_compare_jump(OP_NEQ_JUMP_TRUE, neq, !=, 1) \
+  case_compare_jump(OP_NEQ_JUMP_FALSE, neq, !=, 0)
+
+static inline void quicken(Instr *i, TValue *v1, TValue *v2,
+                           uint8 ii, uint8 ff)
+{
+  uint8 op = 0;
+  if (VALUE_ISINT(v1) && VALUE_ISINT(v2)) op = ii;
+  else if (VALUE_ISFLOAT(v1) && VALUE_ISFLOAT(v2)) op = ff;
+
+  if (!op) {
+    i->count = 0;
+  } else if (++i->count >= QUICKEN_THRESHOLD) {
+    debug("quicken '%s' to '%s'", opcode_string(i->op), opcode_string(op));
+    i->op = op;
+  }
+}
+
+static inline void unquicken(Instr *i, uint8 op)
+{
+  debug("unquicken '%s' to '%s'", opcode_string(i->op), opcode_string(op));
+  i->op = op;
+  i->count = 0;
+}
+
 static void frame_loop(Frame *frame)
 {
-  int loopflag = 1;
   Routine *rt = frame->rt;
   CodeObject *code = (CodeObject *)frame->code;
   Object *consts = code->kf.consts;
+  Instr *insts = code->kf.insts;
+  Instr *ip = insts + frame->pc;
+  Instr *i;
+#ifdef KOALA_STATS
+  int lastop = -1;
+#endif
+
+  rt_stack_ensure(rt, code->kf.maxstack);
+
+#if KOALA_JIT
+  if (code->kf.jit || jit_hot(code)) {
+    Jit_Run(frame);
+    return;
+  }
+#endif
 
-  uint8 inst;
-  int32 index;
-  int32 offset;
   TValue val;
   Object *ob;
 
-  while (loopflag) {
-    inst = fetch_code(frame, code);
-    switch (inst) {
-      case OP_HALT: {
+#if USE_COMPUTED_GOTO
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverride-init"
+  static void *dispatch_table[256] = {
+    [0 ... 255] = &&TARGET_default,
+    [OP_HALT]   = &&TARGET_OP_HALT,
+    [OP_LOADK]  = &&TARGET_OP_LOADK,
+    [OP_LOADM]  = &&TARGET_OP_LOADM,
+    [OP_GETM]   = &&TARGET_OP_GETM,
+    [OP_LOAD]   = &&TARGET_OP_LOAD,
+    [OP_LOAD0]  = &&TARGET_OP_LOAD0,
+    [OP_STORE]  = &&TARGET_OP_STORE,
+    [OP_GETFIELD] = &&TARGET_OP_GETFIELD,
+    [OP_SETFIELD] = &&TARGET_OP_SETFIELD,
+    [OP_CALL0]  = &&TARGET_OP_CALL0,
+    [OP_CALL]   = &&TARGET_OP_CALL,
+    [OP_TAILCALL] = &&TARGET_OP_TAILCALL,
+    [OP_RET]    = &&TARGET_OP_RET,
+    [OP_NEWARRAY] = &&TARGET_OP_NEWARRAY,
+    [OP_LOAD_SUBSCR]  = &&TARGET_OP_LOAD_SUBSCR,
+    [OP_STORE_SUBSCR] = &&TARGET_OP_STORE_SUBSCR,
+    [OP_JUMP]   = &&TARGET_OP_JUMP,
+    [OP_JUMP_TRUE]  = &&TARGET_OP_JUMP_TRUE,
+    [OP_JUMP_FALSE] = &&TARGET_OP_JUMP_FALSE,
+    [OP_NEW]    = &&TARGET_OP_NEW,
+    [OP_ADD] = &&TARGET_OP_ADD, [OP_SUB] = &&TARGET_OP_SUB,
+    [OP_MUL] = &&TARGET_OP_MUL, [OP_DIV] = &&TARGET_OP_DIV,
+    [OP_MOD] = &&TARGET_OP_MOD, [OP_NEG] = &&TARGET_OP_NEG,
+    [OP_GT]  = &&TARGET_OP_GT,  [OP_GE]  = &&TARGET_OP_GE,
+    [OP_LT]  = &&TARGET_OP_LT,  [OP_LE]  = &&TARGET_OP_LE,
+    [OP_EQ]  = &&TARGET_OP_EQ,  [OP_NEQ] = &&TARGET_OP_NEQ,
+    [OP_BAND] = &&TARGET_OP_BAND, [OP_BOR] = &&TARGET_OP_BOR,
+    [OP_BXOR] = &&TARGET_OP_BXOR, [OP_BNOT] = &&TARGET_OP_BNOT,
+    [OP_LSHIFT] = &&TARGET_OP_LSHIFT, [OP_RSHIFT] = &&TARGET_OP_RSHIFT,
+    [OP_LAND] = &&TARGET_OP_LAND, [OP_LOR] = &&TARGET_OP_LOR,
+    [OP_LNOT] = &&TARGET_OP_LNOT,
+    [OP_ADD_II] = &&TARGET_OP_ADD_II, [OP_ADD_FF] = &&TARGET_OP_ADD_FF,
+    [OP_SUB_II] = &&TARGET_OP_SUB_II, [OP_SUB_FF] = &&TARGET_OP_SUB_FF,
+    [OP_MUL_II] = &&TARGET_OP_MUL_II, [OP_MUL_FF] = &&TARGET_OP_MUL_FF,
+    [OP_GT_II]  = &&TARGET_OP_GT_II,  [OP_GT_FF]  = &&TARGET_OP_GT_FF,
+    [OP_GE_II]  = &&TARGET_OP_GE_II,  [OP_GE_FF]  = &&TARGET_OP_GE_FF,
+    [OP_LT_II]  = &&TARGET_OP_LT_II,  [OP_LT_FF]  = &&TARGET_OP_LT_FF,
+    [OP_LE_II]  = &&TARGET_OP_LE_II,  [OP_LE_FF]  = &&TARGET_OP_LE_FF,
+    [OP_EQ_II]  = &&TARGET_OP_EQ_II,  [OP_EQ_FF]  = &&TARGET_OP_EQ_FF,
+    [OP_NEQ_II] = &&TARGET_OP_NEQ_II, [OP_NEQ_FF] = &&TARGET_OP_NEQ_FF,
+    [OP2_LOADK] = &&TARGET_OP2_LOADK,
+    [OP2_GETFIELD] = &&TARGET_OP2_GETFIELD,
+    [OP2_SETFIELD] = &&TARGET_OP2_SETFIELD,
+    [OP2_ADD] = &&TARGET_OP2_ADD, [OP2_SUB] = &&TARGET_OP2_SUB,
+    [OP2_MUL] = &&TARGET_OP2_MUL, [OP2_DIV] = &&TARGET_OP2_DIV,
+    [OP3_ADD] = &&TARGET_OP3_ADD, [OP3_SUB] = &&TARGET_OP3_SUB,
+    [OP3_MUL] = &&TARGET_OP3_MUL, [OP3_DIV] = &&TARGET_OP3_DIV,
+    [OP_GT_JUMP_TRUE]  = &&TARGET_OP_GT_JUMP_TRUE,
+    [OP_GT_JUMP_FALSE] = &&TARGET_OP_GT_JUMP_FALSE,
+    [OP_GE_JUMP_TRUE]  = &&TARGET_OP_GE_JUMP_TRUE,
+    [OP_GE_JUMP_FALSE] = &&TARGET_OP_GE_JUMP_FALSE,
+    [OP_LT_JUMP_TRUE]  = &&TARGET_OP_LT_JUMP_TRUE,
+    [OP_LT_JUMP_FALSE] = &&TARGET_OP_LT_JUMP_FALSE,
+    [OP_LE_JUMP_TRUE]  = &&TARGET_OP_LE_JUMP_TRUE,
+    [OP_LE_JUMP_FALSE] = &&TARGET_OP_LE_JUMP_FALSE,
+    [OP_EQ_JUMP_TRUE]  = &&TARGET_OP_EQ_JUMP_TRUE,
+    [OP_EQ_JUMP_FALSE] = &&TARGET_OP_EQ_JUMP_FALSE,
+    [OP_NEQ_JUMP_TRUE]  = &&TARGET_OP_NEQ_JUMP_TRUE,
+    [OP_NEQ_JUMP_FALSE] = &&TARGET_OP_NEQ_JUMP_FALSE,
+    [OP_FOR_RANGE] = &&TARGET_OP_FOR_RANGE,
+  };
+#pragma GCC diagnostic pop
+
+  DISPATCH();
+  {
+#else
+  while (1) {
+    assert(ip - insts < code->kf.ninsts);
+    i = ip++;
+    STATS_OP(lastop, i->op);
+    switch (i->op) {
+#endif
+      TARGET(OP_HALT) {
         exit(0);
-        break;
+        DISPATCH();
       }
-      case OP_LOADK: {
-        index = fetch_4bytes(frame, code);
-        val = index_const(index, consts);
+      TARGET(OP_LOADK) {
+        val = index_const(i->arg, consts);
         PUSH(&val);
-        break;
+        DISPATCH();
       }
-      case OP_LOADM: {
-        index = fetch_4bytes(frame, code);
-        val = index_const(index, consts);
-        char *path = String_RawString(val.ob);
-        debug("load module '%s'", path);
-        ob = Koala_Load_Module(path);
-        assert(ob);
-        setobjvalue(&val, ob);
-        PUSH(&val);
-        break;
+      TARGET(OP_LOADM) {
+        do_loadm(rt, consts, i);
+        DISPATCH();
       }
-      case OP_GETM: {
-        val = TOP();
-        ob = val.ob;
-        if (!OB_CHECK_KLASS(ob, Module_Klass)) {
-          val = POP();
-          Klass *klazz = OB_KLASS(ob);
-          OB_ASSERT_KLASS(klazz, Klass_Klass);
-          assert(klazz->module);
-          setobjvalue(&val, klazz->module);
-          PUSH(&val);
-        }
-        break;
+      TARGET(OP_GETM) {
+        do_getm(rt);
+        DISPATCH();
       }
-      case OP_LOAD: {
-        index = fetch_2bytes(frame, code);
-        val = load(frame, index);
+      TARGET(OP_LOAD) {
+        val = load(frame, i->arg);
         PUSH(&val);
-        break;
+        DISPATCH();
       }
-      case OP_LOAD0: {
+      TARGET(OP_LOAD0) {
         val = load(frame, 0);
         PUSH(&val);
-        break;
+        DISPATCH();
       }
-      case OP_STORE: {
-        index = fetch_2bytes(frame, code);
+      TARGET(OP_STORE) {
         val = POP();
-        store(frame, index, &val);
-        break;
+        store(frame, i->arg, &val);
+        DISPATCH();
       }
-      case OP_GETFIELD: {
-        index = fetch_4bytes(frame, code);
-        val = index_const(index, consts);
-        char *field = String_RawString(val.ob);
-        debug("getfield '%s'", field);
+      TARGET(OP_GETFIELD) {
         val = POP();
-        ob = val.ob;
-        val = getfield(ob, field);
-        if (!val.klazz) {
-          Object *rob = NULL;
-          ob = getcode(ob, field, &rob);
-          val.klazz = &Code_Klass;
-          val.ob = ob;
-        }
-        PUSH(&val);
+        do_getfield(rt, consts, i, VALUE_OBJECT(&val));
         //Klass *k = (Klass *)(((CodeObject *)(frame->code))->owner);
         //Object_Get_Value2(ob, k, field);
-        break;
+        DISPATCH();
       }
-      case OP_SETFIELD: {
-        index = fetch_4bytes(frame, code);
-        val = index_const(index, consts);
-        char *field = String_RawString(val.ob);
-        debug("setfield '%s'", field);
-        val = POP();
-        ob = val.ob;
+      TARGET(OP_SETFIELD) {
         val = POP();
-        VALUE_ASSERT(&val);
-        setfield(ob, field, &val);
-        break;
+        do_setfield(rt, consts, i, VALUE_OBJECT(&val));
+        DISPATCH();
       }
-      case OP_CALL0: {
-        int argc = fetch_2bytes(frame, code);
+      TARGET(OP_CALL0) {
+        int argc = i->arg;
         debug("OP_CALL0, argc:%d", argc);
         val = POP();
-        Object *meth = val.ob;
+        Object *meth = VALUE_OBJECT(&val);
         assert(OB_KLASS(meth) == &Code_Klass);
         val = TOP();
-        ob = val.ob;
+        ob = VALUE_OBJECT(&val);
+        frame->pc = ip - insts;
         frame_new(rt, ob, meth, argc);
-        loopflag = 0;
-        break;
+        return;
       }
-      case OP_CALL: {
-        index = fetch_4bytes(frame, code);
-        val = index_const(index, consts);
-        char *name = String_RawString(val.ob);
-        int argc = fetch_2bytes(frame, code);
-        debug("OP_CALL, %s, argc:%d", name, argc);
-        val = TOP();
-        ob = val.ob;
-        //assert(!check_virtual_call(&val, name));
-        Object *rob = NULL;
-        Object *meth = getcode(ob, name, &rob);
-        assert(rob);
-        if (rob != ob) {
-          debug(">>>>>update object<<<<<");
-          POP();
-          setobjvalue(&val, rob);
-          PUSH(&val);
-        }
-        assert(meth);
-        if (CODE_ISKFUNC(meth)) {
-          //FIXME: for c function
-          CodeObject *code = OB_TYPE_OF(meth, CodeObject, Code_Klass);
-          check_args(rt, argc, code->proto, name);
-        }
-        frame_new(rt, rob, meth, argc);
-        if (!strcmp(name, "__init__")) {
-          //build_traits_init_frames(rt, ob);
-        }
-        loopflag = 0;
-        break;
+      TARGET(OP_CALL) {
+        do_call(frame, i, ip - insts);
+        return;
       }
-      case OP_RET: {
-        restore_previous_frame(frame);
-        loopflag = 0;
-        break;
+      TARGET(OP_TAILCALL) {
+        do_tailcall(frame, i);
+        return;
       }
-      case OP_NEWARRAY: {
-        int count = fetch_4bytes(frame, code);
-        do_new_array(rt, count);
-        break;
+      TARGET(OP_RET) {
+        do_return(frame);
+        return;
       }
-      case OP_LOAD_SUBSCR: {
+      TARGET(OP_NEWARRAY) {
+        do_new_array(rt, i->arg);
+        DISPATCH();
+      }
+      TARGET(OP_LOAD_SUBSCR) {
         val = do_load_subscr(rt);
         PUSH(&val);
-        break;
+        DISPATCH();
       }
-      case OP_STORE_SUBSCR: {
+      TARGET(OP_STORE_SUBSCR) {
         do_store_subscr(rt);
-        break;
+        DISPATCH();
       }
-      case OP_JUMP: {
-        offset = fetch_4bytes(frame, code);
-        frame->pc += offset;
-        break;
+      TARGET(OP_JUMP) {
+        ip = insts + i->arg;
+        BACKWARD_JUMP();
+        DISPATCH();
       }
-      case OP_JUMP_TRUE: {
+      TARGET(OP_JUMP_TRUE) {
         val = POP();
         VALUE_ASSERT_BOOL(&val);
-        offset = fetch_4bytes(frame, code);
-        if (val.bval) {
-          frame->pc += offset;
+        if (VALUE_BOOL(&val)) {
+          ip = insts + i->arg;
+          BACKWARD_JUMP();
         }
-        break;
+        DISPATCH();
       }
-      case OP_JUMP_FALSE: {
+      TARGET(OP_JUMP_FALSE) {
         val = POP();
         VALUE_ASSERT_BOOL(&val);
-        offset = fetch_4bytes(frame, code);
-        if (!val.bval) {
-          frame->pc += offset;
+        if (!VALUE_BOOL(&val)) {
+          ip = insts + i->arg;
+          BACKWARD_JUMP();
         }
-        break;
+        DISPATCH();
       }
-      case OP_NEW: {
-        index = fetch_4bytes(frame, code);
-        val = index_const(index, consts);
-        char *name = String_RawString(val.ob);
-        val = POP();
-        int argc = fetch_2bytes(frame, code);
-        debug("OP_NEW, %s, argc:%d", name, argc);
-        ob = val.ob;
-        Klass *klazz = Module_Get_Class(ob, name);
-        assert(klazz);
-        assert(klazz != &Klass_Klass);
-        assert(OB_Base(klazz) != (Object *)&Klass_Klass);
-        ob = klazz->ob_alloc(klazz);
-        setobjvalue(&val, ob);
-        PUSH(&val);
-#if 0
-        Object *rob = NULL;
-        Object *__init__ = getcode(ob, "__init__", &rob);
-        assert(rob);
-        assert(rob == ob);
-        if (__init__)	{
-          CodeObject *code = OB_TYPE_OF(__init__, CodeObject, Code_Klass);
-          debug("__init__'s argc: %d", code->kf.proto->psz);
-          check_args(rt, argc, code->kf.proto, name);
-          if (code->kf.proto->rsz) {
-            error("__init__ must be no any returns");
-            exit(-1);
-          }
-          frame_new(rt, rob, __init__, argc);
-          loopflag = 0;
-        } else {
-          debug("no __init__");
-          if (argc) {
-            error("no __init__, but %d", argc);
-            exit(-1);
-          }
+      TARGET(OP_FOR_RANGE) {
+        /* i and its bound are unboxed Int, no value is created */
+        TValue *v = frame->locvars + i->argc;
+        assert(KFunc_Verified(code) || i->argc + 1 < frame->size);
+        VALUE_ASSERT_INT(v);
+        VALUE_ASSERT_INT(v + 1);
+        setivalue(v, (uint64)VALUE_INT(v) + 1);
+        if (VALUE_INT(v) < VALUE_INT(v + 1)) {
+          ip = insts + i->arg;
+          BACKWARD_JUMP();
         }
-#endif
-        break;
+        DISPATCH();
+      }
+      TARGET(OP_NEW) {
+        do_new(rt, consts, i);
+        DISPATCH();
+      }
+      TARGET(OP2_LOADK) {
+        val = index_const(i->arg, consts);
+        store(frame, i->argc, &val);
+        DISPATCH();
+      }
+      TARGET(OP2_GETFIELD) {
+        val = load(frame, i->argc);
+        do_getfield(rt, consts, i, VALUE_OBJECT(&val));
+        DISPATCH();
+      }
+      TARGET(OP2_SETFIELD) {
+        val = load(frame, i->argc);
+        do_setfield(rt, consts, i, VALUE_OBJECT(&val));
+        DISPATCH();
       }
       NUMBER_OPERATION_CASES
-      default: {
-        kassert(0, "unknown instruction:%d\n", inst);
+      QUICKENED_OPERATION_CASES
+      LOCVARS_OPERATION_CASES
+      COMPARE_JUMP_CASES
+      DEFAULT_TARGET {
+        kassert(0, "unknown instruction:%d\n", i->op);
+        return;
       }
     }
+#if !USE_COMPUTED_GOTO
   }
+#endif
 }
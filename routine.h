@@ -2,27 +2,57 @@
 #ifndef _KOALA_ROUTINE_H_
 #define _KOALA_ROUTINE_H_
 
-#include "object.h"
+#include "codeobject.h"
 #include "thread.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#define STACK_SIZE  32
+/*
+  Operand stack grows on demand, it starts with STACK_INIT_SIZE slots.
+  Room is ensured once per entry of a frame by its 'maxstack', instead of
+  checking on every push.
+ */
+#define STACK_INIT_SIZE 8
+
+/*
+  frame_loop() uses direct-threaded dispatch(computed goto) with GCC,
+  build with -DKOALA_NO_COMPUTED_GOTO to use the portable switch loop.
+ */
+#if defined(__GNUC__) && !defined(KOALA_NO_COMPUTED_GOTO)
+#define KOALA_COMPUTED_GOTO 1
+#else
+#define KOALA_COMPUTED_GOTO 0
+#endif
 
 typedef struct frame Frame;
 
+/*
+  Frames of a routine are allocated in chunks, like a stack.
+  A frame is pushed and popped by bumping 'top' of the current chunk.
+ */
+#define FRAME_CHUNK_SIZE  4096
+
+typedef struct frame_chunk {
+  struct frame_chunk *prev;
+  struct frame_chunk *next;  /* spare chunk, kept after popped */
+  char *top;
+  char *end;
+  char data[0];
+} FrameChunk;
+
 typedef struct routine {
   struct list_head link;
   Frame *frame;
-  struct list_head frames;
+  FrameChunk *chunk;
   int top;
+  int size;
   TValue *stack;
 } Routine;
 
 struct frame {
-  struct list_head link;
+  Frame *prev;
   Routine *rt;
   int argc;
   Object *code;
@@ -31,44 +61,73 @@ struct frame {
   TValue locvars[0];
 };
 
+/* routine running on this thread, read by the sampling profiler */
+extern __thread Routine *Routine_Current;
+
 /* Exported APIs */
 int Routine_Init(Routine *rt);
 void Routine_Run(Routine *rt, Object *code, Object *ob, Object *args);
 void Routine_Fini(Routine *rt);
+void Routine_Show_CallStats(void);
 
 /*-------------------------------------------------------------------------*/
 
+/* instructions helpers, used by frame_loop() and jit */
+void do_loadm(Routine *rt, Object *consts, Instr *i);
+void do_getm(Routine *rt);
+void do_getfield(Routine *rt, Object *consts, Instr *i, Object *ob);
+void do_setfield(Routine *rt, Object *consts, Instr *i, Object *ob);
+void do_new(Routine *rt, Object *consts, Instr *i);
+void do_call(Frame *f, Instr *i, int pc);
+void do_tailcall(Frame *f, Instr *i);
+void do_return(Frame *f);
+void do_number_op(Routine *rt, int op);
+void do_new_array(Routine *rt, int count);
+TValue do_load_subscr(Routine *rt);
+void do_store_subscr(Routine *rt);
+
+/*-------------------------------------------------------------------------*/
+
+void rt_stack_grow(Routine *rt, int n);
+
 static inline TValue rt_stack_top(Routine *rt)
 {
-  assert(rt->top >= -1 && rt->top <= STACK_SIZE-1);
+  assert(rt->top >= -1 && rt->top <= rt->size-1);
   if (rt->top >= 0) return rt->stack[rt->top];
   else return NilValue;
 }
 
 static inline TValue rt_stack_pop(Routine *rt)
 {
-  assert(rt->top >= -1 && rt->top <= STACK_SIZE-1);
+  assert(rt->top >= -1 && rt->top <= rt->size-1);
   if (rt->top >= 0) return rt->stack[rt->top--];
   else return NilValue;
 }
 
 static inline void rt_stack_push(Routine *rt, TValue *v)
 {
-  assert(rt->top >= -1 && rt->top < STACK_SIZE-1);
+  assert(rt->top >= -1 && rt->top < rt->size-1);
   rt->stack[++rt->top] = *v;
 }
 
 static inline int rt_stack_size(Routine *rt)
 {
-  assert(rt->top >= -1 && rt->top <= STACK_SIZE-1);
+  assert(rt->top >= -1 && rt->top <= rt->size-1);
   return rt->top + 1;
 }
 
 static inline void rt_stack_init(Routine *rt)
 {
   rt->top = -1;
-  for (int i = 0; i <= STACK_SIZE-1; i++)
-    initnilvalue(rt->stack + i);
+  rt->size = 0;
+  rt->stack = NULL;
+}
+
+/* make sure there is room for 'n' more values */
+static inline void rt_stack_ensure(Routine *rt, int n)
+{
+  if (rt->top + 1 + n > rt->size)
+    rt_stack_grow(rt, n);
 }
 
 static inline TValue *rt_stack_get(Routine *rt, int index)
@@ -0,0 +1,157 @@
+
+#include <stdint.h>
+#include <sys/mman.h>
+#include "slab.h"
+#include "list.h"
+#include "log.h"
+
+typedef struct slab_page {
+  struct list_head link;  /* in its class, if it has free blocks */
+  int size;               /* block size */
+  int used;               /* blocks allocated */
+  int nblocks;
+  char *bump;             /* the first block never used */
+  void *freelist;
+} SlabPage;
+
+/* blocks are after the page header */
+#define PAGE_HEADER_SIZE \
+  ((sizeof(SlabPage) + SLAB_ALIGN - 1) & ~(SLAB_ALIGN - 1))
+
+#define NR_CLASSES (SLAB_MAX_SIZE / SLAB_ALIGN)
+
+typedef struct slab_class {
+  struct list_head pages;
+  SlabPage *spare;        /* an empty page kept */
+} SlabClass;
+
+static SlabClass classes[NR_CLASSES];
+static int npages;
+
+static inline int class_index(int size)
+{
+  return size > 0 ? (size - 1) / SLAB_ALIGN : 0;
+}
+
+static inline SlabPage *page_of(void *ptr)
+{
+  return (SlabPage *)((uintptr_t)ptr & ~((uintptr_t)SLAB_PAGE_SIZE - 1));
+}
+
+static void page_init(SlabPage *page, int size)
+{
+  init_list_head(&page->link);
+  page->size = size;
+  page->used = 0;
+  page->nblocks = (SLAB_PAGE_SIZE - PAGE_HEADER_SIZE) / size;
+  page->bump = (char *)page + PAGE_HEADER_SIZE;
+  page->freelist = NULL;
+}
+
+/* an aligned page is cut out of a mapping of twice its size */
+static SlabPage *page_new(int size)
+{
+  size_t len = SLAB_PAGE_SIZE * 2;
+  char *p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) {
+    error("slab: mmap %zu bytes failed", len);
+    exit(-1);
+  }
+  char *start = (char *)(((uintptr_t)p + SLAB_PAGE_SIZE - 1) &
+                         ~((uintptr_t)SLAB_PAGE_SIZE - 1));
+  if (start > p)
+    munmap(p, start - p);
+  if (start + SLAB_PAGE_SIZE < p + len)
+    munmap(start + SLAB_PAGE_SIZE, p + len - start - SLAB_PAGE_SIZE);
+
+  SlabPage *page = (SlabPage *)start;
+  page_init(page, size);
+  ++npages;
+  debug("slab: new page of %d-byte blocks, %d pages", size, npages);
+  return page;
+}
+
+static void page_release(SlabPage *page)
+{
+  munmap(page, SLAB_PAGE_SIZE);
+  --npages;
+}
+
+void *Slab_Alloc(int size)
+{
+  if (size > SLAB_MAX_SIZE) {
+    void *ptr = calloc(1, size);
+    if (!ptr) {
+      error("slab: alloc %d bytes failed", size);
+      exit(-1);
+    }
+    return ptr;
+  }
+
+  SlabClass *cls = classes + class_index(size);
+  SlabPage *page;
+  /* classes are set up at their first use */
+  if (!cls->pages.next)
+    init_list_head(&cls->pages);
+  if (list_empty(&cls->pages)) {
+    if (cls->spare) {
+      page = cls->spare;
+      cls->spare = NULL;
+    } else {
+      page = page_new((class_index(size) + 1) * SLAB_ALIGN);
+    }
+    list_add(&page->link, &cls->pages);
+  } else {
+    page = list_first_entry(&cls->pages, SlabPage, link);
+  }
+
+  void *ptr;
+  if (page->freelist) {
+    ptr = page->freelist;
+    page->freelist = *(void **)ptr;
+  } else {
+    ptr = page->bump;
+    page->bump += page->size;
+  }
+  if (++page->used == page->nblocks)
+    list_del(&page->link);
+
+  memset(ptr, 0, page->size);
+  return ptr;
+}
+
+void Slab_Free(void *ptr, int size)
+{
+  if (!ptr) return;
+  if (size > SLAB_MAX_SIZE) {
+    free(ptr);
+    return;
+  }
+
+  SlabClass *cls = classes + class_index(size);
+  SlabPage *page = page_of(ptr);
+  assert(page->size == (class_index(size) + 1) * SLAB_ALIGN);
+  assert(page->used > 0);
+
+  if (page->used == page->nblocks)
+    list_add(&page->link, &cls->pages);
+  *(void **)ptr = page->freelist;
+  page->freelist = ptr;
+
+  if (--page->used == 0) {
+    list_del(&page->link);
+    if (cls->spare) {
+      page_release(page);
+    } else {
+      /* the blocks are taken in address order again */
+      page_init(page, page->size);
+      cls->spare = page;
+    }
+  }
+}
+
+int Slab_Pages(void)
+{
+  return npages;
+}
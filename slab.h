@@ -0,0 +1,37 @@
+
+#ifndef _KOALA_SLAB_H_
+#define _KOALA_SLAB_H_
+
+#include "common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Size-class slab allocator of vm objects.
+  Sizes up to SLAB_MAX_SIZE are rounded up to SLAB_ALIGN bytes, one class
+  per rounded size. A class carves its blocks out of pages, which are
+  SLAB_PAGE_SIZE bytes mapped from the os and aligned on their size, so
+  the page of a block is found by its address. A page has a free list of
+  its freed blocks, and the blocks never used are taken in address order.
+  Pages with free blocks are linked in their class, full ones are not.
+  A page whose blocks are all freed is unmapped, except one kept per
+  class against thrashing.
+  Larger sizes are from calloc() and free().
+  Blocks are zeroed, and freed with their allocation size. Like the gc,
+  the allocator assumes that one routine runs at a time.
+ */
+#define SLAB_PAGE_SIZE  (64 << 10)
+#define SLAB_ALIGN      16
+#define SLAB_MAX_SIZE   1024
+
+void *Slab_Alloc(int size);
+void Slab_Free(void *ptr, int size);
+/* number of pages mapped */
+int Slab_Pages(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _KOALA_SLAB_H_ */
@@ -0,0 +1,169 @@
+
+#include "stackmap.h"
+#include "opcode.h"
+#include "log.h"
+
+/* the map of a function whose codes are not analyzable */
+static uint32 nomap[1];
+
+struct liveness {
+	int locvars;
+	int words;        /* words of a bitmap */
+	uint32 *use;      /* read by the instruction */
+	uint32 *def;      /* stored by the instruction */
+	uint32 *live;     /* live before the instruction, the result */
+};
+
+static inline uint32 *bitmap(struct liveness *l, uint32 *maps, int k)
+{
+	return maps + k * l->words;
+}
+
+static int add_locvar(struct liveness *l, uint32 *map, int index)
+{
+	if (index < 0 || index >= l->locvars) return -1;
+	map[index >> 5] |= 1U << (index & 31);
+	return 0;
+}
+
+/* locvars read and stored by instruction 'k' */
+static int use_def(struct liveness *l, Instr *i, int k)
+{
+	uint32 *use = bitmap(l, l->use, k);
+	uint32 *def = bitmap(l, l->def, k);
+
+	switch (i->op) {
+	case OP_LOAD:
+		return add_locvar(l, use, i->arg);
+	case OP_LOAD0:
+		return add_locvar(l, use, 0);
+	case OP_STORE:
+		return add_locvar(l, def, i->arg);
+	case OP2_LOADK:
+		return add_locvar(l, def, i->argc);
+	case OP2_GETFIELD:
+	case OP2_SETFIELD:
+		return add_locvar(l, use, i->argc);
+	case OP2_ADD:
+	case OP2_SUB:
+	case OP2_MUL:
+	case OP2_DIV:
+		if (add_locvar(l, use, i->arg) < 0) return -1;
+		return add_locvar(l, use, i->argc);
+	case OP3_ADD:
+	case OP3_SUB:
+	case OP3_MUL:
+	case OP3_DIV:
+		if (add_locvar(l, use, i->arg & 0xffff) < 0) return -1;
+		if (add_locvar(l, use, (int)((uint32)i->arg >> 16)) < 0) return -1;
+		return add_locvar(l, def, i->argc);
+	case OP_FOR_RANGE:
+		/* i is increased in place, and its bound is next to it */
+		if (add_locvar(l, use, i->argc) < 0) return -1;
+		return add_locvar(l, use, i->argc + 1);
+	default:
+		return 0;
+	}
+}
+
+/* live = use | (out & ~def), returns non-zero if 'live' is changed */
+static int transfer(struct liveness *l, int k, uint32 *out)
+{
+	uint32 *use = bitmap(l, l->use, k);
+	uint32 *def = bitmap(l, l->def, k);
+	uint32 *live = bitmap(l, l->live, k);
+	uint32 bits;
+	int changed = 0;
+	for (int w = 0; w < l->words; w++) {
+		bits = use[w] | (out[w] & ~def[w]);
+		if (bits != live[w]) {
+			live[w] = bits;
+			changed = 1;
+		}
+	}
+	return changed;
+}
+
+static void merge_successor(struct liveness *l, uint32 *out, int k)
+{
+	uint32 *live = bitmap(l, l->live, k);
+	for (int w = 0; w < l->words; w++)
+		out[w] |= live[w];
+}
+
+/*
+  Backward liveness analysis, iterated until no map is changed.
+  Returns NULL if an index of locvar or a jump target is out of range.
+ */
+static uint32 *analyze(CodeObject *code)
+{
+	int count = code->kf.ninsts;
+	Instr *insts = code->kf.insts;
+	struct liveness l;
+	l.locvars = code->kf.locvars;
+	l.words = (l.locvars + 31) >> 5;
+	l.use = calloc(count * l.words, sizeof(uint32));
+	l.def = calloc(count * l.words, sizeof(uint32));
+	l.live = calloc(count * l.words, sizeof(uint32));
+	uint32 *out = malloc(l.words * sizeof(uint32));
+
+	Instr *i;
+	for (int k = 0; k < count; k++) {
+		i = insts + k;
+		if (use_def(&l, i, k) < 0 ||
+			(Instr_IsJump(i) && (i->arg < 0 || i->arg >= count))) {
+			free(l.live);
+			l.live = NULL;
+			goto out;
+		}
+		add_locvar(&l, bitmap(&l, l.use, k), 0);
+	}
+
+	int changed;
+	do {
+		changed = 0;
+		for (int k = count - 1; k >= 0; k--) {
+			i = insts + k;
+			memset(out, 0, l.words * sizeof(uint32));
+			if (Instr_IsJump(i))
+				merge_successor(&l, out, i->arg);
+			if (i->op != OP_JUMP && i->op != OP_RET && i->op != OP_HALT &&
+				i->op != OP_TAILCALL && k + 1 < count)
+				merge_successor(&l, out, k + 1);
+			changed |= transfer(&l, k, out);
+		}
+	} while (changed);
+
+out:
+	free(l.use);
+	free(l.def);
+	free(out);
+	return l.live;
+}
+
+uint32 *StackMap_Get(Object *ob, int pc)
+{
+	CodeObject *code = (CodeObject *)ob;
+	/* jitted codes keep no pc at their safepoints */
+	if (!CODE_ISKFUNC(code) || code->kf.jit) return NULL;
+	if (code->kf.locvars <= 0 || code->kf.ninsts <= 0) return NULL;
+
+	if (!code->kf.livemap) {
+		code->kf.livemap = analyze(code);
+		if (!code->kf.livemap) {
+			warn("stack map of '%s' is not built", code->name);
+			code->kf.livemap = nomap;
+		}
+	}
+	if (code->kf.livemap == nomap || pc < 0 || pc >= code->kf.ninsts)
+		return NULL;
+	return code->kf.livemap + pc * ((code->kf.locvars + 31) >> 5);
+}
+
+void StackMap_Free(Object *ob)
+{
+	CodeObject *code = (CodeObject *)ob;
+	if (code->kf.livemap != nomap)
+		free(code->kf.livemap);
+	code->kf.livemap = NULL;
+}
@@ -0,0 +1,29 @@
+#ifndef _KOALA_STACKMAP_H_
+#define _KOALA_STACKMAP_H_
+
+#include "codeobject.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Stack maps of kfuncs for the gc's root scanning.
+  The map of a function is a bitmap of its live locvars before each of its
+  instructions, computed by a backward liveness analysis of its codes at
+  the first scan of one of its frames. A locvar is live if it may be read
+  before it is stored again. The receiver(locvar 0) is always live.
+  A frame is scanned by the map at its 'pc', which is the resume point of
+  a caller frame or the jump target of a loop's safepoint.
+ */
+#define STACKMAP_LIVE(map, index) \
+	((map)[(index) >> 5] & (1U << ((index) & 31)))
+
+/* the map at 'pc', NULL if all locvars are to be scanned */
+uint32 *StackMap_Get(Object *code, int pc);
+void StackMap_Free(Object *code);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _KOALA_STACKMAP_H_ */
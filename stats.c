@@ -0,0 +1,301 @@
+
+#include "stats.h"
+#include "moduleobject.h"
+#include "opcode.h"
+#include "log.h"
+
+#ifdef KOALA_STATS
+
+int Stats_Enabled;
+uint64 Stats_Ops[256];
+uint64 Stats_Pairs[256][256];
+
+struct stats_site {
+  struct stats_site *next;
+  Object *code;
+  int pc;
+  char *name;
+  uint64 calls;
+  uint64 misses;
+  int nrecvs;
+  struct {
+    void *key;
+    uint64 count;
+  } recvs[STATS_MAX_RECEIVERS];
+  uint64 others;      /* calls of receivers not in 'recvs' */
+};
+
+static struct stats_site *sites;
+static int nsites;
+static char *json_path;
+
+/* receivers are keyed like the call cache, module or klass */
+static inline void *receiver_key(Object *ob)
+{
+  return OB_CHECK_KLASS(ob, Module_Klass) ? (void *)ob : (void *)OB_KLASS(ob);
+}
+
+static char *receiver_name(void *key)
+{
+  Object *ob = key;
+  if (OB_CHECK_KLASS(ob, Module_Klass))
+    return ((ModuleObject *)ob)->name;
+  return ((Klass *)ob)->name;
+}
+
+void Stats_Call(void **site, Object *code, Instr *i, char *name,
+                Object *ob, int hit)
+{
+  if (!Stats_Enabled) return;
+
+  struct stats_site *s = *site;
+  if (!s) {
+    s = calloc(1, sizeof(struct stats_site));
+    s->code = code;
+    s->pc = i - ((CodeObject *)code)->kf.insts;
+    s->name = name;
+    s->next = sites;
+    sites = s;
+    nsites++;
+    *site = s;
+  }
+
+  s->calls++;
+  if (!hit) s->misses++;
+
+  void *key = receiver_key(ob);
+  for (int k = 0; k < s->nrecvs; k++) {
+    if (s->recvs[k].key == key) {
+      s->recvs[k].count++;
+      return;
+    }
+  }
+  if (s->nrecvs < STATS_MAX_RECEIVERS) {
+    s->recvs[s->nrecvs].key = key;
+    s->recvs[s->nrecvs].count = 1;
+    s->nrecvs++;
+  } else {
+    s->others++;
+  }
+}
+
+int Stats_Enable(char *json)
+{
+  Stats_Enabled = 1;
+  json_path = json;
+  return 0;
+}
+
+/*-------------------------------------------------------------------------*/
+
+#define STATS_TOP 30
+
+struct count {
+  int a;
+  int b;
+  uint64 count;
+};
+
+static int cmp_count(const void *p1, const void *p2)
+{
+  const struct count *c1 = p1;
+  const struct count *c2 = p2;
+  if (c1->count == c2->count) return 0;
+  return c1->count < c2->count ? 1 : -1;
+}
+
+static int cmp_site(const void *p1, const void *p2)
+{
+  const struct stats_site *s1 = *(struct stats_site **)p1;
+  const struct stats_site *s2 = *(struct stats_site **)p2;
+  if (s1->calls == s2->calls) return 0;
+  return s1->calls < s2->calls ? 1 : -1;
+}
+
+/* non-zero counters, most executed first */
+static int collect_ops(struct count *ops, uint64 *total)
+{
+  int n = 0;
+  *total = 0;
+  for (int op = 0; op < 256; op++) {
+    if (!Stats_Ops[op]) continue;
+    ops[n].a = op;
+    ops[n].b = -1;
+    ops[n].count = Stats_Ops[op];
+    *total += Stats_Ops[op];
+    n++;
+  }
+  qsort(ops, n, sizeof(struct count), cmp_count);
+  return n;
+}
+
+static int collect_pairs(struct count *pairs, uint64 *total)
+{
+  int n = 0;
+  *total = 0;
+  for (int a = 0; a < 256; a++) {
+    for (int b = 0; b < 256; b++) {
+      if (!Stats_Pairs[a][b]) continue;
+      pairs[n].a = a;
+      pairs[n].b = b;
+      pairs[n].count = Stats_Pairs[a][b];
+      *total += Stats_Pairs[a][b];
+      n++;
+    }
+  }
+  qsort(pairs, n, sizeof(struct count), cmp_count);
+  return n;
+}
+
+static struct stats_site **collect_sites(void)
+{
+  struct stats_site **array = malloc(sizeof(void *) * (nsites + 1));
+  int n = 0;
+  for (struct stats_site *s = sites; s; s = s->next)
+    array[n++] = s;
+  qsort(array, n, sizeof(void *), cmp_site);
+  return array;
+}
+
+static double percent(uint64 count, uint64 total)
+{
+  return total ? count * 100.0 / total : 0;
+}
+
+static void show_table(struct count *ops, int nops, uint64 optotal,
+                       struct count *pairs, int npairs, uint64 pairtotal,
+                       struct stats_site **array)
+{
+  char buf[256];
+
+  printf("\nopcodes: %llu executed, %d kinds\n", optotal, nops);
+  printf("%14s %8s  %s\n", "count", "%", "opcode");
+  for (int k = 0; k < nops && k < STATS_TOP; k++) {
+    printf("%14llu %7.2f%%  %s\n", ops[k].count,
+           percent(ops[k].count, optotal), opcode_string(ops[k].a));
+  }
+
+  printf("\nopcode pairs: %llu executed, %d kinds\n", pairtotal, npairs);
+  printf("%14s %8s  %s\n", "count", "%", "pair");
+  for (int k = 0; k < npairs && k < STATS_TOP; k++) {
+    printf("%14llu %7.2f%%  %s %s\n", pairs[k].count,
+           percent(pairs[k].count, pairtotal),
+           opcode_string(pairs[k].a), opcode_string(pairs[k].b));
+  }
+
+  printf("\ncall sites: %d\n", nsites);
+  printf("%14s %8s %6s  %s\n", "calls", "hit%", "recvs", "site");
+  for (int k = 0; k < nsites && k < STATS_TOP; k++) {
+    struct stats_site *s = array[k];
+    Code_Name(s->code, buf, sizeof(buf));
+    printf("%14llu %7.2f%% %5d%s  %s+%d %s\n", s->calls,
+           percent(s->calls - s->misses, s->calls),
+           s->nrecvs, s->others ? "+" : " ", buf, s->pc, s->name);
+    for (int r = 0; r < s->nrecvs; r++) {
+      printf("%14llu %7.2f%%         %s\n", s->recvs[r].count,
+             percent(s->recvs[r].count, s->calls),
+             receiver_name(s->recvs[r].key));
+    }
+    if (s->others)
+      printf("%14llu %7.2f%%         (others)\n", s->others,
+             percent(s->others, s->calls));
+  }
+}
+
+static void write_json(FILE *fp, struct count *ops, int nops,
+                       struct count *pairs, int npairs,
+                       struct stats_site **array)
+{
+  char buf[256];
+
+  fprintf(fp, "{\n  \"opcodes\": [");
+  for (int k = 0; k < nops; k++) {
+    fprintf(fp, "%s\n    {\"op\": \"%s\", \"count\": %llu}", k ? "," : "",
+            opcode_string(ops[k].a), ops[k].count);
+  }
+  fprintf(fp, "\n  ],\n  \"pairs\": [");
+  for (int k = 0; k < npairs; k++) {
+    fprintf(fp, "%s\n    {\"first\": \"%s\", \"second\": \"%s\", "
+            "\"count\": %llu}", k ? "," : "", opcode_string(pairs[k].a),
+            opcode_string(pairs[k].b), pairs[k].count);
+  }
+  fprintf(fp, "\n  ],\n  \"calls\": [");
+  for (int k = 0; k < nsites; k++) {
+    struct stats_site *s = array[k];
+    Code_Name(s->code, buf, sizeof(buf));
+    fprintf(fp, "%s\n    {\"function\": \"%s\", \"pc\": %d, \"name\": \"%s\", "
+            "\"calls\": %llu, \"misses\": %llu, \"others\": %llu, "
+            "\"receivers\": [", k ? "," : "", buf, s->pc, s->name,
+            s->calls, s->misses, s->others);
+    for (int r = 0; r < s->nrecvs; r++) {
+      fprintf(fp, "%s{\"class\": \"%s\", \"count\": %llu}", r ? ", " : "",
+              receiver_name(s->recvs[r].key), s->recvs[r].count);
+    }
+    fprintf(fp, "]}");
+  }
+  fprintf(fp, "\n  ]\n}\n");
+}
+
+void Stats_Dump(void)
+{
+  if (!Stats_Enabled) return;
+  Stats_Enabled = 0;
+
+  uint64 optotal;
+  uint64 pairtotal;
+  struct count *ops = malloc(sizeof(struct count) * 256);
+  struct count *pairs = malloc(sizeof(struct count) * 256 * 256);
+  int nops = collect_ops(ops, &optotal);
+  int npairs = collect_pairs(pairs, &pairtotal);
+  struct stats_site **array = collect_sites();
+
+  show_table(ops, nops, optotal, pairs, npairs, pairtotal, array);
+
+  if (json_path) {
+    FILE *fp = fopen(json_path, "w");
+    if (fp) {
+      write_json(fp, ops, nops, pairs, npairs, array);
+      fclose(fp);
+    } else {
+      error("stats: cannot open '%s'", json_path);
+    }
+  }
+
+  free(ops);
+  free(pairs);
+  free(array);
+
+  struct stats_site *next;
+  while (sites) {
+    next = sites->next;
+    free(sites);
+    sites = next;
+  }
+  nsites = 0;
+}
+
+#else /* !KOALA_STATS */
+
+void Stats_Call(void **site, Object *code, Instr *i, char *name,
+                Object *ob, int hit)
+{
+  UNUSED_PARAMETER(site);
+  UNUSED_PARAMETER(code);
+  UNUSED_PARAMETER(i);
+  UNUSED_PARAMETER(name);
+  UNUSED_PARAMETER(ob);
+  UNUSED_PARAMETER(hit);
+}
+
+int Stats_Enable(char *json)
+{
+  UNUSED_PARAMETER(json);
+  warn("stats: not compiled in, build with 'make STATS=1'");
+  return -1;
+}
+
+void Stats_Dump(void)
+{
+}
+
+#endif
@@ -0,0 +1,54 @@
+
+#ifndef _KOALA_STATS_H_
+#define _KOALA_STATS_H_
+
+#include "codeobject.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Execution statistics of 'koala -stats'.
+  frame_loop() counts every executed opcode and every pair of successive
+  opcodes in a frame, and OP_CALL/OP_TAILCALL count hits, inline cache
+  misses and receivers per call site. Counters are not atomic, they are
+  approximate if routines run on several threads. Jitted codes are not
+  counted, the jit is off in stats mode.
+  Counting is compiled in with -DKOALA_STATS ('make STATS=1'), otherwise
+  STATS_OP() is empty and '-stats' only warns.
+ */
+#define STATS_MAX_RECEIVERS 8
+
+#ifdef KOALA_STATS
+
+extern int Stats_Enabled;
+extern uint64 Stats_Ops[256];
+extern uint64 Stats_Pairs[256][256];
+
+/* 'last' is the previous opcode in the frame, -1 at frame entry */
+#define STATS_OP(last, op) do { \
+  if (Stats_Enabled) {          \
+    Stats_Ops[op]++;            \
+    if ((last) >= 0)            \
+      Stats_Pairs[last][op]++;  \
+    (last) = (op);              \
+  }                             \
+} while (0)
+
+#else
+
+#define STATS_OP(last, op) ((void)0)
+
+#endif
+
+/* '*site' is per call site, created at its first call */
+void Stats_Call(void **site, Object *code, Instr *i, char *name,
+                Object *ob, int hit);
+int Stats_Enable(char *json);
+void Stats_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _KOALA_STATS_H_ */
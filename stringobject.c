@@ -35,6 +35,7 @@ Object *String_New(char *str)
 	StringObject *strobj = __find_string(&StringCache, str, len);
 	if (strobj) {
 		debug("found '%s' in string cache", str);
+		GC_Revive((Object *)strobj);
 		return (Object *)strobj;
 	}
 
@@ -49,10 +50,11 @@ Object *String_New_NoGC(char *str)
 	StringObject *strobj = __find_string(&StringCache, str, len);
 	if (strobj) {
 		debug("found '%s' in string cache", str);
+		GC_Fix((Object *)strobj);
 		return (Object *)strobj;
 	}
 
-	strobj = malloc(sizeof(StringObject) + (len + 1));
+	strobj = calloc(1, sizeof(StringObject) + (len + 1));
 	init_string(strobj, str, len);
 	return (Object *)strobj;
 }
@@ -136,8 +138,8 @@ static Object *__string_concat(Object *ob, Object *args)
 	TValue v = Tuple_Get(args, 0);
 	OB_ASSERT_KLASS(ob, String_Klass);
 	StringObject *s1 = (StringObject *)ob;
-	assert(v.klazz == &String_Klass);
-	StringObject *s2 = (StringObject *)v.ob;
+	assert(VALUE_KLASS(&v) == &String_Klass);
+	StringObject *s2 = (StringObject *)VALUE_OBJECT(&v);
 	char buf[s1->len + s2->len + 1];
 	strcpy(buf, s1->str);
 	strcat(buf, s2->str);
@@ -170,8 +172,8 @@ void Init_String_Klass(void)
 
 static int string_equal(TValue *v1, TValue *v2)
 {
-	Object *ob1 = v1->ob;
-	Object *ob2 = v2->ob;
+	Object *ob1 = VALUE_OBJECT(v1);
+	Object *ob2 = VALUE_OBJECT(v2);
 	StringObject *s1 = OB_TYPE_OF(ob1, StringObject, String_Klass);
 	StringObject *s2 = OB_TYPE_OF(ob2, StringObject, String_Klass);
 	return !strcmp(s1->str, s2->str);
@@ -179,7 +181,7 @@ static int string_equal(TValue *v1, TValue *v2)
 
 static uint32 string_hash(TValue *v)
 {
-	Object *ob = v->ob;
+	Object *ob = VALUE_OBJECT(v);
 	StringObject *s = OB_TYPE_OF(ob, StringObject, String_Klass);
 	return hash_string(s->str);
 }
@@ -193,9 +195,10 @@ static void string_free(Object *ob)
 static Object *string_tostring(TValue *v)
 {
   char buf[128];
-  StringObject *so = v->ob;
+  StringObject *so = (StringObject *)VALUE_OBJECT(v);
   snprintf(buf, 127, "%s", so->str);
-  TValue val = {.klazz = &String_Klass, .ob = String_New(buf)};
+  TValue val;
+  setobjvalue(&val, String_New(buf));
 	return Tuple_From_TValues(&val, 1);
 }
 
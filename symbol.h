@@ -65,6 +65,7 @@ struct symbol {
 	char *path;     /* used for import */
 	void *import;   /* save Import */
 	int32 locvars;  /* used in compiler, for function */
+	void *value;    /* folded value of constant variable */
 	Vector traits;  /* for traits in correct order */
 };
 
@@ -2,6 +2,8 @@
 #include "tableobject.h"
 #include "tupleobject.h"
 #include "moduleobject.h"
+#include "gc.h"
+#include "slab.h"
 #include "log.h"
 
 struct entry {
@@ -16,19 +18,19 @@ static int entry_equal(void *k1, void *k2)
 	struct entry *e2 = k2;
 	TValue *v1 = &e1->key;
 	TValue *v2 = &e2->key;
-	return v1->klazz->ob_equal(v1, v2);
+	return VALUE_KLASS(v1)->ob_equal(v1, v2);
 }
 
 static uint32 entry_hash(void *k)
 {
 	struct entry *e = k;
 	TValue *v = &e->key;
-	return v->klazz->ob_hash(v);
+	return VALUE_KLASS(v)->ob_hash(v);
 }
 
 static struct entry *new_entry(TValue *key, TValue *value)
 {
-	struct entry *entry = malloc(sizeof(struct entry));
+	struct entry *entry = Slab_Alloc(sizeof(struct entry));
 	entry->key = *key;
 	entry->val = *value;
 	Init_HashNode(&entry->hnode, entry);
@@ -36,14 +38,14 @@ static struct entry *new_entry(TValue *key, TValue *value)
 }
 
 static void free_entry(struct entry *e) {
-	free(e);
+	Slab_Free(e, sizeof(struct entry));
 }
 
 /*-------------------------------------------------------------------------*/
 
 Object *Table_New(void)
 {
-	TableObject *table = malloc(sizeof(TableObject));
+	TableObject *table = Slab_Alloc(sizeof(TableObject));
 	Init_Object_Head(table, &Table_Klass);
 	HashInfo hashinfo;
 	Init_HashInfo(&hashinfo, entry_hash, entry_equal);
@@ -73,6 +75,8 @@ int Table_Put(Object *ob, TValue *key, TValue *value)
 		free_entry(e);
 		return -1;
 	} else {
+		GC_Write_Barrier(ob, key);
+		GC_Write_Barrier(ob, value);
 		return 0;
 	}
 }
@@ -140,20 +144,9 @@ void Init_Table_Klass(void)
 
 static void entry_visit(TValue *key, TValue *val, void *arg)
 {
-	UNUSED_PARAMETER(key);
-	UNUSED_PARAMETER(val);
 	UNUSED_PARAMETER(arg);
-	// Object *ob;
-
-	// if (VALUE_ISOBJECT(key)) {
-	// 	ob = VALUE_OBJECT(key);
-	// 	OB_KLASS(ob)->ob_mark(ob);
-	// }
-
-	// if (VALUE_ISOBJECT(val)) {
-	// 	ob = VALUE_OBJECT(val);
-	// 	OB_KLASS(ob)->ob_mark(ob);
-	// }
+	GC_Mark_Value(key);
+	GC_Mark_Value(val);
 }
 
 static void table_mark(Object *ob)
@@ -172,7 +165,7 @@ static void table_free(Object *ob)
 {
 	TableObject *table = OB_TYPE_OF(ob, TableObject, Table_Klass);
 	HashTable_Fini(&table->tbl, __entry_free_fn, NULL);
-	free(ob);
+	Slab_Free(table, sizeof(TableObject));
 }
 
 Klass Table_Klass = {
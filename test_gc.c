@@ -0,0 +1,121 @@
+#include "koala.h"
+#include "listobject.h"
+#include "gc.h"
+#include "slab.h"
+
+/* gcc -g -std=gnu99 test_gc.c -lkoala -L. -I. -pthread -lrt */
+
+#define NR_VARS   64
+#define NR_ITEMS  LIST_DEFAULT_SIZE
+#define NR_ROUNDS 1024
+#define STR_LEN   200
+
+/* a string of STR_LEN chars, so the heap is large enough to mark in parallel */
+static char *name(char *buf, int round, int k)
+{
+	int n = sprintf(buf, "%d.%d", round, k);
+	memset(buf + n, '.', STR_LEN - n);
+	buf[STR_LEN] = 0;
+	return buf;
+}
+
+/* names of the vars, a module keeps them */
+static char vars[NR_VARS][8];
+
+static void check_string(TValue *val, int round, int k)
+{
+	char buf[STR_LEN + 1];
+	assert(VALUE_ISOBJECT(val));
+	assert(!strcmp(String_RawString(VALUE_OBJECT(val)), name(buf, round, k)));
+}
+
+/*
+  Lists in the vars of a module are replaced by new ones and freed, the
+  strings of a list are stored after it is in the module, and the ones
+  of the table are kept. Young strings live by the remembered set of the
+  module's values, the lists and the table between the full collections.
+ */
+void test_gc(void)
+{
+	char buf[STR_LEN + 1];
+	char num[8];
+	TValue val;
+	TValue key;
+
+	Object *m = Koala_New_Module("gc", "test/gc");
+	for (int i = 0; i < NR_VARS; i++) {
+		sprintf(vars[i], "v%d", i);
+		Module_Add_Var(m, vars[i], &Any_Type, 0);
+	}
+	Module_Add_Var(m, "t", &Any_Type, 0);
+	Object *table = Table_New();
+	setobjvalue(&val, table);
+	Module_Set_Value(m, "t", &val);
+
+	for (int r = 0; r < NR_ROUNDS; r++) {
+		char *var = vars[r % NR_VARS];
+		Object *list = List_New(NULL);
+		TValue old = Module_Get_Value(m, var);
+		setobjvalue(&val, list);
+		Module_Set_Value(m, var, &val);
+		/* the collector is stopped between the steps of stress mode */
+		assert(gcs.state == GC_STOP);
+		if (VALUE_ISOBJECT(&old)) {
+			Object *ob = VALUE_OBJECT(&old);
+			OB_KLASS(ob)->ob_free(ob);
+		}
+
+		for (int k = 0; k < NR_ITEMS; k++) {
+			setobjvalue(&val, String_New(name(buf, r, k)));
+			List_Set(list, k, &val);
+			GC_SAFEPOINT();
+		}
+
+		sprintf(num, "%d", r);
+		setobjvalue(&key, String_New(num));
+		setobjvalue(&val, String_New(name(buf, r, NR_ITEMS)));
+		assert(!Table_Put(table, &key, &val));
+		GC_SAFEPOINT();
+	}
+
+	GC_Run();
+	assert(gcs.minors > 0);
+	assert(gcs.cycles > 0);
+
+	for (int i = 0; i < NR_VARS; i++) {
+		val = Module_Get_Value(m, vars[i]);
+		ListObject *list = (ListObject *)VALUE_OBJECT(&val);
+		int r = NR_ROUNDS - NR_VARS + i;
+		for (int k = 0; k < NR_ITEMS; k++)
+			check_string(list->items + k, r, k);
+	}
+
+	assert(Table_Count(table) == NR_ROUNDS);
+	for (int r = 0; r < NR_ROUNDS; r++) {
+		sprintf(num, "%d", r);
+		setobjvalue(&key, String_New(num));
+		assert(!Table_Get(table, &key, NULL, &val));
+		check_string(&val, r, NR_ITEMS);
+	}
+
+	/* the strings of the freed lists are collected */
+	long live = (NR_VARS * NR_ITEMS + NR_ROUNDS) *
+				(sizeof(StringObject) + STR_LEN + 1);
+	assert(GC_Alloc_Count() > NR_ROUNDS * NR_ITEMS);
+	assert(GC_Used_Bytes() < 2 * live);
+	printf("%ld bytes alive, %d pages\n", GC_Used_Bytes(), Slab_Pages());
+}
+
+int main(int argc, char *argv[])
+{
+	UNUSED_PARAMETER(argc);
+	UNUSED_PARAMETER(argv);
+
+	Koala_Initialize();
+	GC_Set_Stress(1);
+	GC_Set_Markers(4);
+	test_gc();
+	Koala_Finalize();
+	puts("gc ok");
+	return 0;
+}
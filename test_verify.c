@@ -0,0 +1,70 @@
+#include "koala.h"
+#include "verify.h"
+
+/* gcc -g -std=gnu99 test_verify.c -lkoala -L. -I. -pthread -lrt */
+
+/* func(self) { var v int; v = <codes> } */
+static int verify(uint8 *codes, int size)
+{
+	uint8 *buf = malloc(size);
+	memcpy(buf, codes, size);
+	Object *code = KFunc_New(2, buf, size, NULL);
+	KFunc_Add_LocVar(code, "v", &Int_Type, 1);
+
+	Object *consts = Tuple_New(2);
+	TValue val;
+	setivalue(&val, 100);
+	Tuple_Set(consts, 0, &val);
+	setobjvalue(&val, String_New("x"));
+	Tuple_Set(consts, 1, &val);
+	((CodeObject *)code)->kf.consts = consts;
+
+	return KFunc_Verify(code, NULL, NULL, "test");
+}
+
+void test_verify(void)
+{
+	/* loadk 100; store v */
+	uint8 good[] = {
+		OP_LOADK, 0, 0, 0, 0,
+		OP_STORE, 1, 0,
+		OP_RET
+	};
+	assert(verify(good, sizeof(good)) == VERIFY_OK);
+
+	/* loadk "x"; store v */
+	uint8 bad[] = {
+		OP_LOADK, 1, 0, 0, 0,
+		OP_STORE, 1, 0,
+		OP_RET
+	};
+	assert(verify(bad, sizeof(bad)) == VERIFY_FAILED);
+
+	/* load self; getfield x; store v, checked at runtime */
+	uint8 unknown[] = {
+		OP_LOAD0,
+		OP_GETFIELD, 1, 0, 0, 0,
+		OP_STORE, 1, 0,
+		OP_RET
+	};
+	assert(verify(unknown, sizeof(unknown)) == VERIFY_UNPROVEN);
+
+	/* store with an empty stack */
+	uint8 underflow[] = {
+		OP_STORE, 1, 0,
+		OP_RET
+	};
+	assert(verify(underflow, sizeof(underflow)) == VERIFY_FAILED);
+}
+
+int main(int argc, char *argv[])
+{
+	UNUSED_PARAMETER(argc);
+	UNUSED_PARAMETER(argv);
+
+	Koala_Initialize();
+	test_verify();
+	Koala_Finalize();
+	puts("verify ok");
+	return 0;
+}
@@ -1,13 +1,14 @@
 
 #include "tupleobject.h"
 #include "moduleobject.h"
+#include "gc.h"
+#include "slab.h"
 #include "log.h"
 
 Object *Tuple_New(int size)
 {
 	int sz = sizeof(TupleObject) + size * sizeof(TValue);
-	TupleObject *tuple = malloc(sz);
-	assert(tuple);
+	TupleObject *tuple = Slab_Alloc(sz);
 	Init_Object_Head(tuple, &Tuple_Klass);
 	tuple->size = size;
 	for (int i = 0; i < size; i++) {
@@ -19,8 +20,8 @@ Object *Tuple_New(int size)
 void Tuple_Free(Object *ob)
 {
 	if (!ob) return;
-	OB_ASSERT_KLASS(ob, Tuple_Klass);
-	free(ob);
+	TupleObject *tuple = OB_TYPE_OF(ob, TupleObject, Tuple_Klass);
+	Slab_Free(tuple, sizeof(TupleObject) + tuple->size * sizeof(TValue));
 }
 
 TValue Tuple_Get(Object *ob, int index)
@@ -69,6 +70,7 @@ int Tuple_Set(Object *ob, int index, TValue *val)
 		return -1;
 	}
 
+	GC_Write_Barrier(ob, val);
 	tuple->items[index] = *val;
 	return 0;
 }
@@ -205,6 +207,13 @@ void Init_Tuple_Klass(void)
 
 /*---------------------------------------------------------------------------*/
 
+static void tuple_mark(Object *ob)
+{
+	TupleObject *tuple = OB_TYPE_OF(ob, TupleObject, Tuple_Klass);
+	for (int i = 0; i < tuple->size; i++)
+		GC_Mark_Value(tuple->items + i);
+}
+
 static void tuple_free(Object *ob)
 {
 	Tuple_Free(ob);
@@ -214,5 +223,6 @@ Klass Tuple_Klass = {
 	OBJECT_HEAD_INIT(&Tuple_Klass, &Klass_Klass)
 	.name = "Tuple",
 	.basesize = sizeof(TupleObject),
+	.ob_mark = tuple_mark,
 	.ob_free = tuple_free,
 };
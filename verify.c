@@ -0,0 +1,578 @@
+
+#include "verify.h"
+#include "moduleobject.h"
+#include "tupleobject.h"
+#include "stringobject.h"
+#include "koalastate.h"
+#include "opcode.h"
+#include "log.h"
+
+/*
+  Load-time verifier of a function's codes.
+  It walks all paths of the codes once, with an abstract operand stack,
+  and proves that:
+    - the operand stack never underflows,
+    - the codes never fall off the end,
+    - indexes of locvars and consts are in range,
+    - the values stored into typed locvars are of the declared types,
+    - the number of arguments of a call matches the callee's proto.
+  The types of values which are not known at load time, e.g. fields and
+  array elements, are the compiler's, which are checked when compiling.
+  A function is verified if all of its calls are resolved at load time,
+  and the interpreter skips the per-instruction checks of verified codes.
+ */
+
+/* abstract value of an operand stack slot or a locvar */
+struct avalue {
+	TypeDesc *desc;   /* NULL if it is not known */
+	Object *module;   /* the value is this module */
+	Klass *klazz;     /* the value is an instance of this class */
+};
+
+/* abstract operand stack before an instruction */
+struct state {
+	int depth;        /* -1 if the instruction is not reached yet */
+	struct avalue *stack;
+};
+
+struct verifier {
+	CodeObject *code;
+	Object *module;
+	Klass *klazz;
+	char *name;
+	int locvars;
+	struct avalue *locvals;
+	struct state *states;
+	int *work;
+	int nwork;
+	uint8 *queued;
+	/* the working stack of the instruction being verified */
+	int depth;
+	int size;
+	struct avalue *stack;
+	int result;
+};
+
+#define verify_error(v, k, fmt, ...) do { \
+	error("verify '%s' at %d: " fmt, (v)->name, (k), ##__VA_ARGS__); \
+	(v)->result = VERIFY_FAILED; \
+} while (0)
+
+static struct avalue unknown;
+
+static int primitive_of(TypeDesc *desc)
+{
+	if (!desc || desc->kind != TYPE_PRIMITIVE) return 0;
+	if (desc->primitive == PRIMITIVE_ANY || desc->primitive == PRIMITIVE_VARG)
+		return 0;
+	return desc->primitive;
+}
+
+/*
+  Check a value of type 'src' against the declared type 'dst'.
+  Primitive types are compared, the others match only if they are equal.
+  Returns 0 if it matches, -1 if not, and 1 if it is not known.
+ */
+static int type_check(TypeDesc *dst, TypeDesc *src)
+{
+	if (dst && src && Type_Equal(dst, src)) return 0;
+	int p1 = primitive_of(dst);
+	int p2 = primitive_of(src);
+	if (!p1 || !p2) {
+		if (dst && dst->kind == TYPE_PRIMITIVE && !p1) return 0;
+		return 1;
+	}
+	return (p1 == p2) ? 0 : -1;
+}
+
+static Klass *value_klass(struct verifier *v, struct avalue *val)
+{
+	if (val->klazz) return val->klazz;
+	TypeDesc *desc = val->desc;
+	if (primitive_of(desc) == PRIMITIVE_STRING) return &String_Klass;
+	if (!desc || desc->kind != TYPE_USRDEF) return NULL;
+	Object *m = desc->usrdef.path ?
+		Koala_Get_Module(desc->usrdef.path) : v->module;
+	return m ? Module_Get_ClassOrTrait(m, desc->usrdef.type) : NULL;
+}
+
+static void value_meet(struct avalue *v1, struct avalue *v2, int *changed)
+{
+	if (v1->desc && (!v2->desc || !Type_Equal(v1->desc, v2->desc))) {
+		v1->desc = NULL;
+		*changed = 1;
+	}
+	if (v1->module && v1->module != v2->module) {
+		v1->module = NULL;
+		*changed = 1;
+	}
+	if (v1->klazz && v1->klazz != v2->klazz) {
+		v1->klazz = NULL;
+		*changed = 1;
+	}
+}
+
+static void push(struct verifier *v, struct avalue *val)
+{
+	if (v->depth >= v->size) {
+		v->size = v->size ? v->size << 1 : 16;
+		v->stack = realloc(v->stack, v->size * sizeof(struct avalue));
+	}
+	v->stack[v->depth++] = *val;
+}
+
+static inline void push_type(struct verifier *v, TypeDesc *desc)
+{
+	struct avalue val = {.desc = desc};
+	push(v, &val);
+}
+
+/* the stack slot 'n' values below the top */
+static inline struct avalue *peek(struct verifier *v, int n)
+{
+	return v->stack + v->depth - 1 - n;
+}
+
+/*
+  Merge the working stack into the state of instruction 'k'.
+  The depth of the merged state is the min one, and values are aligned on
+  the top, as the values below are left by the calls whose results are not
+  used. The instruction is verified again if its state is changed.
+ */
+static void merge(struct verifier *v, int k)
+{
+	struct state *s = v->states + k;
+	int changed = 0;
+
+	if (s->depth < 0) {
+		s->depth = v->depth;
+		s->stack = malloc((v->depth + 1) * sizeof(struct avalue));
+		memcpy(s->stack, v->stack, v->depth * sizeof(struct avalue));
+		changed = 1;
+	} else {
+		if (v->depth < s->depth) {
+			memmove(s->stack, s->stack + s->depth - v->depth,
+				v->depth * sizeof(struct avalue));
+			s->depth = v->depth;
+			changed = 1;
+		}
+		struct avalue *base = v->stack + v->depth - s->depth;
+		for (int n = 0; n < s->depth; n++)
+			value_meet(s->stack + n, base + n, &changed);
+	}
+
+	if (changed && !v->queued[k]) {
+		v->queued[k] = 1;
+		v->work[v->nwork++] = k;
+	}
+}
+
+static int check_const(struct verifier *v, int k, int index, int isname)
+{
+	Object *consts = v->code->kf.consts;
+	if (!consts || index < 0 || index >= Tuple_Size(consts)) {
+		verify_error(v, k, "const index %d out of range", index);
+		return -1;
+	}
+	if (isname) {
+		TValue val = Tuple_Get(consts, index);
+		if (!VALUE_ISOBJECT(&val) ||
+			!OB_CHECK_KLASS(VALUE_OBJECT(&val), String_Klass)) {
+			verify_error(v, k, "const %d is not a name", index);
+			return -1;
+		}
+	}
+	return 0;
+}
+
+static int check_locvar(struct verifier *v, int k, int index)
+{
+	if (index < 0 || index >= v->locvars) {
+		verify_error(v, k, "locvar index %d out of range", index);
+		return -1;
+	}
+	return 0;
+}
+
+static TypeDesc *const_type(struct verifier *v, int index)
+{
+	TValue val = Tuple_Get(v->code->kf.consts, index);
+	if (VALUE_ISINT(&val)) return &Int_Type;
+	if (VALUE_ISFLOAT(&val)) return &Float_Type;
+	if (VALUE_ISBOOL(&val)) return &Bool_Type;
+	if (VALUE_ISOBJECT(&val) && OB_CHECK_KLASS(VALUE_OBJECT(&val), String_Klass))
+		return &String_Type;
+	return NULL;
+}
+
+/* the const is checked by check_const(isname) */
+static char *const_name(struct verifier *v, int index)
+{
+	TValue val = Tuple_Get(v->code->kf.consts, index);
+	return String_RawString(VALUE_OBJECT(&val));
+}
+
+static void check_store(struct verifier *v, int k, int index, TypeDesc *src)
+{
+	TypeDesc *dst = v->locvals[index].desc;
+	int r = type_check(dst, src);
+	if (r < 0) {
+		char buf1[64], buf2[64];
+		Type_ToString(dst, buf1);
+		Type_ToString(src, buf2);
+		verify_error(v, k, "store '%s' to locvar %d of '%s'", buf2, index, buf1);
+	} else if (r > 0 && dst && v->result == VERIFY_OK) {
+		/* the store is checked at runtime */
+		v->result = VERIFY_UNPROVEN;
+	}
+}
+
+/* both operands are of the same primitive type, so is the result */
+static TypeDesc *arith_type(TypeDesc *t1, TypeDesc *t2)
+{
+	int p = primitive_of(t1);
+	return (p && p == primitive_of(t2)) ? t1 : NULL;
+}
+
+static Object *resolve_callee(struct verifier *v, struct avalue *rob,
+	char *name)
+{
+	if (rob->module)
+		return Module_Get_Function(rob->module, name);
+
+	Klass *klazz = value_klass(v, rob);
+	Object *meth;
+	while (klazz) {
+		meth = Klass_Get_Method(klazz, name, NULL);
+		if (meth) return meth;
+		klazz = OB_HasBase(klazz) ? (Klass *)OB_Base(klazz) : NULL;
+	}
+	return NULL;
+}
+
+/*
+  The results of a call are known only if its callee is resolved.
+  Returns -1 if not, and the path is not verified any more.
+ */
+static int verify_call(struct verifier *v, int k, Instr *i)
+{
+	if (check_const(v, k, i->arg, 1) < 0) return -1;
+	int argc = i->argc;
+	if (v->depth < argc + 1) {
+		verify_error(v, k, "stack underflow, call with %d args", argc);
+		return -1;
+	}
+
+	char *name = const_name(v, i->arg);
+	Object *meth = resolve_callee(v, peek(v, 0), name);
+	if (!meth || !OB_CHECK_KLASS(meth, Code_Klass)) {
+		debug("verify '%s' at %d: cannot resolve '%s'", v->name, k, name);
+		v->result = VERIFY_UNPROVEN;
+		return -1;
+	}
+
+	TypeDesc *proto = ((CodeObject *)meth)->proto;
+	Vector *args = proto->proto.arg;
+	int nargs = Vector_Size(args);
+	TypeDesc *desc = nargs > 0 ? Vector_Get(args, nargs - 1) : NULL;
+	int varg = desc && Type_IsVarg(desc);
+	if (varg ? argc < nargs - 1 : argc != nargs) {
+		verify_error(v, k, "'%s' argc: expected %d, but %d", name, nargs, argc);
+		return -1;
+	}
+
+	for (int n = 0; n < argc && n < nargs; n++) {
+		desc = Vector_Get(args, n);
+		if (Type_IsVarg(desc)) break;
+		if (type_check(desc, peek(v, n + 1)->desc) < 0) {
+			warn("verify '%s' at %d: '%s' args type check failed",
+				v->name, k, name);
+			v->result = VERIFY_UNPROVEN;
+		}
+	}
+
+	/* class's __init__ returns the new object, see parser_merge() */
+	struct avalue rob = *peek(v, 0);
+	v->depth -= argc + 1;
+	if (!strcmp(name, "__init__")) {
+		push(v, &rob);
+		return 0;
+	}
+	Vector_ForEach(desc, proto->proto.ret) {
+		push_type(v, desc);
+	}
+	return 0;
+}
+
+/*
+  Verify one instruction on the working stack, and merge the result into
+  its successors.
+ */
+static void verify_inst(struct verifier *v, int k)
+{
+	Instr *insts = v->code->kf.insts;
+	Instr *i = insts + k;
+	struct avalue val;
+	TypeDesc *desc;
+	int pops, pushes;
+
+	if (Instr_Stack_Effect(i, &pops, &pushes) == 0 && v->depth < pops) {
+		verify_error(v, k, "stack underflow, %d values, pops %d", v->depth, pops);
+		return;
+	}
+
+	switch (i->op) {
+	case OP_HALT:
+	case OP_RET:
+		return;
+	case OP_LOADK:
+		if (check_const(v, k, i->arg, 0) < 0) return;
+		push_type(v, const_type(v, i->arg));
+		break;
+	case OP_LOADM: {
+		if (check_const(v, k, i->arg, 1) < 0) return;
+		char *path = const_name(v, i->arg);
+		val = unknown;
+		val.module = Koala_Get_Module(path);
+		push(v, &val);
+		break;
+	}
+	case OP_GETM: {
+		struct avalue *top = peek(v, 0);
+		if (!top->module) {
+			Klass *klazz = value_klass(v, top);
+			val = unknown;
+			val.module = klazz ? klazz->module : NULL;
+			*top = val;
+		}
+		break;
+	}
+	case OP_LOAD:
+	case OP_LOAD0: {
+		int index = (i->op == OP_LOAD0) ? 0 : i->arg;
+		if (check_locvar(v, k, index) < 0) return;
+		push(v, v->locvals + index);
+		break;
+	}
+	case OP_STORE:
+		if (check_locvar(v, k, i->arg) < 0) return;
+		check_store(v, k, i->arg, peek(v, 0)->desc);
+		v->depth--;
+		break;
+	case OP_GETFIELD:
+		if (check_const(v, k, i->arg, 1) < 0) return;
+		*peek(v, 0) = unknown;
+		break;
+	case OP_SETFIELD:
+		if (check_const(v, k, i->arg, 1) < 0) return;
+		v->depth -= 2;
+		break;
+	case OP_CALL:
+		if (verify_call(v, k, i) < 0) return;
+		break;
+	case OP_TAILCALL:
+		verify_call(v, k, i);
+		return;
+	case OP_CALL0:
+		debug("verify '%s' at %d: call of function value", v->name, k);
+		v->result = VERIFY_UNPROVEN;
+		return;
+	case OP_NEW: {
+		if (check_const(v, k, i->arg, 1) < 0) return;
+		struct avalue *top = peek(v, 0);
+		char *name = const_name(v, i->arg);
+		val = unknown;
+		val.klazz = top->module ? Module_Get_Class(top->module, name) : NULL;
+		*top = val;
+		break;
+	}
+	case OP_NEWARRAY:
+	case OP_LOAD_SUBSCR:
+	case OP_STORE_SUBSCR:
+		v->depth -= pops;
+		if (pushes) push(v, &unknown);
+		break;
+	case OP_JUMP_TRUE:
+	case OP_JUMP_FALSE:
+		desc = peek(v, 0)->desc;
+		if (type_check(&Bool_Type, desc) < 0) {
+			verify_error(v, k, "jump on non-bool value");
+			return;
+		}
+		v->depth--;
+		break;
+	case OP_NEG:
+	case OP_BNOT:
+		break;
+	case OP_LNOT:
+		*peek(v, 0) = unknown;
+		peek(v, 0)->desc = &Bool_Type;
+		break;
+	case OP2_LOADK:
+		if (check_const(v, k, i->arg, 0) < 0) return;
+		if (check_locvar(v, k, i->argc) < 0) return;
+		check_store(v, k, i->argc, const_type(v, i->arg));
+		break;
+	case OP2_GETFIELD:
+		if (check_const(v, k, i->arg, 1) < 0) return;
+		if (check_locvar(v, k, i->argc) < 0) return;
+		push(v, &unknown);
+		break;
+	case OP2_SETFIELD:
+		if (check_const(v, k, i->arg, 1) < 0) return;
+		if (check_locvar(v, k, i->argc) < 0) return;
+		v->depth--;
+		break;
+	case OP2_ADD:
+	case OP2_SUB:
+	case OP2_MUL:
+	case OP2_DIV:
+		if (check_locvar(v, k, i->arg) < 0) return;
+		if (check_locvar(v, k, i->argc) < 0) return;
+		push_type(v, arith_type(v->locvals[i->arg].desc,
+			v->locvals[i->argc].desc));
+		break;
+	case OP3_ADD:
+	case OP3_SUB:
+	case OP3_MUL:
+	case OP3_DIV: {
+		int left = i->arg & 0xffff;
+		int right = (int)((uint32)i->arg >> 16);
+		if (check_locvar(v, k, left) < 0) return;
+		if (check_locvar(v, k, right) < 0) return;
+		if (check_locvar(v, k, i->argc) < 0) return;
+		check_store(v, k, i->argc, arith_type(v->locvals[left].desc,
+			v->locvals[right].desc));
+		break;
+	}
+	case OP_FOR_RANGE:
+		/* the bound is in the locvar next to i */
+		if (check_locvar(v, k, i->argc) < 0) return;
+		if (check_locvar(v, k, i->argc + 1) < 0) return;
+		if (!v->locvals[i->argc].desc ||
+			!Type_IsInt(v->locvals[i->argc].desc) ||
+			!v->locvals[i->argc + 1].desc ||
+			!Type_IsInt(v->locvals[i->argc + 1].desc)) {
+			verify_error(v, k, "range loop on non-int locvars");
+			return;
+		}
+		break;
+	default:
+		if (i->op >= OP_GT_JUMP_TRUE && i->op <= OP_NEQ_JUMP_FALSE) {
+			v->depth -= 2;
+		} else if (i->op >= OP_GT && i->op <= OP_NEQ) {
+			v->depth -= 2;
+			push_type(v, &Bool_Type);
+		} else if (i->op == OP_LAND || i->op == OP_LOR) {
+			v->depth -= 2;
+			push_type(v, &Bool_Type);
+		} else if (i->op >= OP_NUM_START && i->op <= OP_NUM_END) {
+			desc = arith_type(peek(v, 0)->desc, peek(v, 1)->desc);
+			v->depth -= 2;
+			push_type(v, desc);
+		} else if (i->op != OP_JUMP) {
+			verify_error(v, k, "unexpected instruction %d", i->op);
+		}
+		break;
+	}
+
+	if (v->result == VERIFY_FAILED) return;
+
+	if (Instr_IsJump(i))
+		merge(v, i->arg);
+	if (i->op == OP_JUMP)
+		return;
+	if (k + 1 >= v->code->kf.ninsts) {
+		verify_error(v, k, "falls off the end of codes");
+		return;
+	}
+	merge(v, k + 1);
+}
+
+static void init_locvals(struct verifier *v)
+{
+	CodeObject *code = v->code;
+	MemberDef *item;
+
+	v->locvals = calloc(v->locvars + 1, sizeof(struct avalue));
+	Vector_ForEach(item, &code->kf.locvec) {
+		if (item->offset < 0 || item->offset >= v->locvars) {
+			verify_error(v, -1, "locvar '%s' at %d out of range",
+				item->name, item->offset);
+			return;
+		}
+		v->locvals[item->offset].desc = item->desc;
+	}
+
+	/* the receiver of the function, module or 'self' */
+	if (v->locvars > 0) {
+		v->locvals[0] = unknown;
+		if (v->klazz)
+			v->locvals[0].klazz = v->klazz;
+		else
+			v->locvals[0].module = v->module;
+	}
+}
+
+/*
+  Verify a function loaded in 'module', 'klazz' is the class of a method
+  or NULL. Returns VERIFY_OK, VERIFY_UNPROVEN or VERIFY_FAILED.
+ */
+int KFunc_Verify(Object *ob, Object *module, Klass *klazz, char *name)
+{
+	CodeObject *code = OB_TYPE_OF(ob, CodeObject, Code_Klass);
+	assert(CODE_ISKFUNC(code));
+
+	int count = code->kf.ninsts;
+	struct verifier v = {
+		.code = code,
+		.module = module,
+		.klazz = klazz,
+		.name = name,
+		.locvars = code->kf.locvars,
+		.result = VERIFY_OK,
+	};
+
+	init_locvals(&v);
+	if (v.result == VERIFY_FAILED || count <= 0) {
+		free(v.locvals);
+		code->kf.verified = (v.result == VERIFY_OK);
+		return v.result;
+	}
+
+	v.states = malloc(count * sizeof(struct state));
+	for (int k = 0; k < count; k++) {
+		v.states[k].depth = -1;
+		v.states[k].stack = NULL;
+	}
+	v.work = malloc(count * sizeof(int));
+	v.queued = calloc(count, sizeof(uint8));
+
+	/* the operand stack is empty at entry */
+	merge(&v, 0);
+
+	int k;
+	struct state *s;
+	while (v.nwork > 0 && v.result != VERIFY_FAILED) {
+		k = v.work[--v.nwork];
+		v.queued[k] = 0;
+		s = v.states + k;
+		v.depth = 0;
+		for (int n = 0; n < s->depth; n++)
+			push(&v, s->stack + n);
+		verify_inst(&v, k);
+	}
+
+	for (k = 0; k < count; k++)
+		free(v.states[k].stack);
+	free(v.states);
+	free(v.work);
+	free(v.queued);
+	free(v.stack);
+	free(v.locvals);
+
+	code->kf.verified = (v.result == VERIFY_OK);
+	debug("verify '%s': %s", name, v.result == VERIFY_OK ? "verified" :
+		(v.result == VERIFY_UNPROVEN ? "unproven" : "failed"));
+	return v.result;
+}
@@ -0,0 +1,20 @@
+
+#ifndef _KOALA_VERIFY_H_
+#define _KOALA_VERIFY_H_
+
+#include "codeobject.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VERIFY_OK         0   /* verified, runs without runtime checks */
+#define VERIFY_UNPROVEN   1   /* not provable at load time, runs checked */
+#define VERIFY_FAILED    -1   /* invalid codes, the module is not loaded */
+
+int KFunc_Verify(Object *code, Object *module, Klass *klazz, char *name);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _KOALA_VERIFY_H_ */
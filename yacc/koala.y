@@ -644,10 +644,10 @@ OrElseStatement
 
 WhileStatement
   : WHILE Expr Block {
-    $$ = NULL; //stmt_from_while($2, $3, 1);
+    $$ = stmt_from_while($2, $3, 1);
   }
   | DO Block WHILE Expr ';' {
-    $$ = NULL; //stmt_from_while($4, $2, 0);
+    $$ = stmt_from_while($4, $2, 0);
   }
   ;
 
@@ -693,25 +693,12 @@ CaseStatement
 /*----------------------------------------------------------------------------*/
 
 ForStatement
-  : FOR RangeCause Block {
-    $$ = NULL;
+  : FOR ID IN Expr DOTDOTLESS Expr Block {
+    $$ = stmt_from_for_range($2, $4, $6, 0, $7);
+  }
+  | FOR ID IN Expr ELLIPSIS Expr Block {
+    $$ = stmt_from_for_range($2, $4, $6, 1, $7);
   }
-  ;
-
-RangeCause
-  : ExprList '=' RangeExpr
-  | ExprList TYPELESS_ASSIGN RangeExpr
-  ;
-
-RangeExpr
-  : Expr RangeStep
-  | Expr ELLIPSIS Expr RangeStep
-  | Expr DOTDOTLESS Expr RangeStep
-  ;
-
-RangeStep
-  : %empty
-  | ',' Expr
   ;
 
 /*----------------------------------------------------------------------------*/